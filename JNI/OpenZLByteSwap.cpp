@@ -0,0 +1,119 @@
+#include "OpenZLByteSwap.h"
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OPENZL_JNI_BSWAP_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define OPENZL_JNI_BSWAP_NEON 1
+#endif
+
+#if defined(_MSC_VER)
+#include <cstdlib>
+#endif
+
+namespace {
+
+inline uint16_t swap16(uint16_t v)
+{
+    return static_cast<uint16_t>((v << 8) | (v >> 8));
+}
+
+inline uint32_t swap32(uint32_t v)
+{
+#if defined(_MSC_VER)
+    return _byteswap_ulong(v);
+#else
+    return __builtin_bswap32(v);
+#endif
+}
+
+inline uint64_t swap64(uint64_t v)
+{
+#if defined(_MSC_VER)
+    return _byteswap_uint64(v);
+#else
+    return __builtin_bswap64(v);
+#endif
+}
+
+template <typename T, T (*Swap)(T)>
+void swapTail(uint8_t* dst, const uint8_t* src, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        T value;
+        std::memcpy(&value, src + i * sizeof(T), sizeof(T));
+        value = Swap(value);
+        std::memcpy(dst + i * sizeof(T), &value, sizeof(T));
+    }
+}
+
+// Swaps whole 16-byte blocks and returns how many elements were handled.
+size_t swapVector(uint8_t* dst, const uint8_t* src, size_t count, size_t width)
+{
+    size_t blocks = (count * width) / 16;
+#if defined(OPENZL_JNI_BSWAP_SSE2)
+    for (size_t b = 0; b < blocks; ++b) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + b * 16));
+        // Swap the bytes of every 16-bit lane, then reorder the lanes within each element.
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        if (width == 4) {
+            v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+            v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        } else if (width == 8) {
+            v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+            v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(0, 1, 2, 3));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + b * 16), v);
+    }
+    return blocks * 16 / width;
+#elif defined(OPENZL_JNI_BSWAP_NEON)
+    for (size_t b = 0; b < blocks; ++b) {
+        uint8x16_t v = vld1q_u8(src + b * 16);
+        if (width == 2) {
+            v = vrev16q_u8(v);
+        } else if (width == 4) {
+            v = vrev32q_u8(v);
+        } else {
+            v = vrev64q_u8(v);
+        }
+        vst1q_u8(dst + b * 16, v);
+    }
+    return blocks * 16 / width;
+#else
+    (void)dst;
+    (void)src;
+    (void)blocks;
+    return 0;
+#endif
+}
+
+} // namespace
+
+void byteSwapElements(void* dst, const void* src, size_t count, size_t width)
+{
+    auto* out = static_cast<uint8_t*>(dst);
+    auto* in = static_cast<const uint8_t*>(src);
+    size_t done = swapVector(out, in, count, width);
+    out += done * width;
+    in += done * width;
+    count -= done;
+    switch (width) {
+    case 2:
+        swapTail<uint16_t, swap16>(out, in, count);
+        break;
+    case 4:
+        swapTail<uint32_t, swap32>(out, in, count);
+        break;
+    case 8:
+        swapTail<uint64_t, swap64>(out, in, count);
+        break;
+    default:
+        if (out != in) {
+            std::memmove(out, in, count * width);
+        }
+        break;
+    }
+}
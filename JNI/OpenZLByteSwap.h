@@ -0,0 +1,7 @@
+#pragma once
+
+#include <cstddef>
+
+// Reverses the byte order of `count` elements of `width` bytes (2, 4 or 8) from `src` into
+// `dst`. `dst` may equal `src` for an in-place swap; other overlaps are not supported.
+void byteSwapElements(void* dst, const void* src, size_t count, size_t width);
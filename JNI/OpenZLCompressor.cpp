@@ -1,5 +1,6 @@
 #include "OpenZLCompressor.h"
 #include "OpenZLNativeSupport.h"
+#include "OpenZLTraining.h"
 #include "openzl/cpp/CParam.hpp"
 #include "openzl/cpp/Compressor.hpp"
 #include "openzl/zl_compress.h"
@@ -11,13 +12,15 @@
 #include "tools/io/InputSetDir.h"
 #include "tools/training/utils/utils.h"
 #include "tools/training/train.h"
+#include <atomic>
 #include <cstdio>
 #include <chrono>
+#include <cstring>
 #include <filesystem>
-#include <fstream>
 #include <limits>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <stdexcept>
 #include <string>
@@ -48,6 +51,177 @@ openzl::cli::ProfileArgs makeProfileArgs(
     return openzl::cli::ProfileArgs(parser.parse(static_cast<int>(argv.size()), argv.data()));
 }
 
+// Configures `compressor` from a serialized trained compressor. The named profile is applied
+// first, best effort, so that the components it registers are known to deserialize().
+void loadSerializedCompressor(openzl::Compressor& compressor,
+        const std::string& profile,
+        const char* data,
+        size_t size)
+{
+    const auto& profiles = openzl::cli::compressProfiles();
+    auto it = profiles.find(profile);
+    if (it != profiles.end()) {
+        auto args = makeProfileArgs(profile);
+        auto* profilePtr = it->second.get();
+        try {
+            ZL_GraphID gid = profilePtr->gen(compressor.get(), profilePtr->opaque ? profilePtr->opaque.get() : nullptr, args);
+            compressor.selectStartingGraph(gid);
+        } catch (...) {
+            // ignore: profile init best-effort
+        }
+    }
+    compressor.deserialize(openzl::poly::string_view(data, size));
+}
+
+// Presets for trained compressors stay out of the shared cache: each load gets its own
+// fingerprint. The bytes are kept with the recipe so that presets derived from this one (for
+// example after a compression level change) can replay the deserialization.
+std::shared_ptr<const CompressionPreset> trainedPreset(const std::string& profile,
+        std::shared_ptr<const std::string> bytes)
+{
+    static std::atomic<uint64_t> nextTrainedId{ 0 };
+    return standalonePreset("trained#" + std::to_string(nextTrainedId.fetch_add(1)),
+            [profile, bytes](openzl::Compressor& compressor) {
+                loadSerializedCompressor(compressor, profile, bytes->data(), bytes->size());
+                ZL_GraphID start;
+                if (!ZL_Compressor_getStartingGraphID(compressor.get(), &start)) {
+                    throw std::runtime_error("serialized compressor has no starting graph");
+                }
+                return start;
+            });
+}
+
+// Size and modification time of the regular file `value` names, empty when it names none.
+std::string fileIdentity(const std::string& value)
+{
+    std::error_code ec;
+    std::filesystem::path path(value);
+    if (value.empty() || !std::filesystem::is_regular_file(path, ec)) {
+        return {};
+    }
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return {};
+    }
+    auto modified = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return {};
+    }
+    return std::to_string(size) + "@" + std::to_string(modified.time_since_epoch().count());
+}
+
+// Cache key for a profile and its arguments. std::map keeps the arguments in key order, and each
+// key and value is length-prefixed so that separators inside them cannot make two maps collide.
+// Profiles read the files their arguments name (an SDDL description, for instance) when the
+// preset is built, so an argument naming a file also contributes the file's size and mtime: a
+// rewritten file gets a new preset instead of the stale cached one.
+std::string profileFingerprint(const std::string& profile, const std::map<std::string, std::string>& arguments)
+{
+    std::string key = "profile:" + profile;
+    for (const auto& arg : arguments) {
+        key.append(";")
+                .append(std::to_string(arg.first.size()))
+                .append(":")
+                .append(arg.first)
+                .append("=")
+                .append(std::to_string(arg.second.size()))
+                .append(":")
+                .append(arg.second);
+        std::string identity = fileIdentity(arg.second);
+        if (!identity.empty()) {
+            key.append("#").append(identity);
+        }
+    }
+    return key;
+}
+
+// A profile compiles to the same compressor for the same arguments, so one shared preset per
+// profile and argument map serves every caller.
+std::shared_ptr<const CompressionPreset> profilePreset(const std::string& profile,
+        openzl::cli::CompressProfile* profilePtr,
+        const std::map<std::string, std::string>& arguments = {})
+{
+    return sharedPreset(profileFingerprint(profile, arguments),
+            [profile, profilePtr, arguments](openzl::Compressor& compressor) {
+                auto args = makeProfileArgs(profile, arguments);
+                return profilePtr->gen(
+                        compressor.get(),
+                        profilePtr->opaque ? profilePtr->opaque.get() : nullptr,
+                        args);
+            });
+}
+
+openzl::cli::CompressProfile* lookupProfile(JNIEnv* env, const std::string& profile)
+{
+    const auto& profiles = openzl::cli::compressProfiles();
+    auto it = profiles.find(profile);
+    if (it == profiles.end()) {
+        std::string message = "Unknown compression profile: " + profile;
+        throwIllegalArgument(env, message);
+        return nullptr;
+    }
+    return it->second.get();
+}
+
+// Trains `profilePtr` on samples gathered by the caller, who keeps their memory alive until
+// this returns. `onCandidate`, when set, may run on several trainer threads at once.
+std::vector<std::string> runTraining(const std::string& profile,
+        openzl::cli::CompressProfile* profilePtr,
+        const std::vector<openzl::training::MultiInput>& multi,
+        openzl::training::TrainParams params,
+        CandidateHook onCandidate = nullptr)
+{
+    openzl::Compressor compressor;
+    auto args = makeProfileArgs(profile);
+    ZL_GraphID gid = profilePtr->gen(compressor.get(), profilePtr->opaque ? profilePtr->opaque.get() : nullptr, args);
+    compressor.selectStartingGraph(gid);
+
+    // The candidate builder may run on the trainer's threads, so a profile failure is kept here
+    // and reported once the trainer returns.
+    auto genFailure = std::make_shared<CandidateFailure>();
+    params.compressorGenFunc = [profilePtr, args, onCandidate, genFailure](openzl::poly::string_view serialized) -> std::unique_ptr<openzl::Compressor> {
+        auto up = std::make_unique<openzl::Compressor>();
+        try {
+            ZL_GraphID gid = profilePtr->gen(up->get(), profilePtr->opaque ? profilePtr->opaque.get() : nullptr, args);
+            up->selectStartingGraph(gid);
+        } catch (const std::exception& ex) {
+            genFailure->record(ex.what());
+        } catch (...) {
+            genFailure->record("unknown error");
+        }
+        up->deserialize(serialized);
+        if (onCandidate) {
+            onCandidate(*up);
+        }
+        return up;
+    };
+
+    auto trained = openzl::training::train(multi, compressor, params);
+    genFailure->rethrow("Profile " + profile + " failed to build a candidate");
+    return serializedCandidates(trained);
+}
+
+jobjectArray trainSamples(JNIEnv* env,
+        const std::string& profile,
+        openzl::cli::CompressProfile* profilePtr,
+        const std::vector<openzl::training::MultiInput>& multi,
+        jint maxTimeSecs,
+        jint threads,
+        jint numSamples,
+        jboolean pareto)
+{
+    try {
+        return toByteArrays(env,
+                runTraining(profile, profilePtr, multi, makeTrainParams(maxTimeSecs, threads, numSamples, pareto)));
+    } catch (const openzl::cli::InvalidArgsException& ex) {
+        throwIllegalArgument(env, ex.what());
+        return nullptr;
+    } catch (const std::exception& ex) {
+        throwIllegalState(env, ex.what());
+        return nullptr;
+    }
+}
+
 jobjectArray trainFromDirectoryImpl(JNIEnv* env,
         const std::string& profile,
         const std::string& dir,
@@ -56,82 +230,65 @@ jobjectArray trainFromDirectoryImpl(JNIEnv* env,
         jint numSamples,
         jboolean pareto)
 {
-    const auto& profiles = openzl::cli::compressProfiles();
-    auto it = profiles.find(profile);
-    if (it == profiles.end()) {
-        std::string message = "Unknown compression profile: " + profile;
-        throwIllegalArgument(env, message);
+    auto* profilePtr = lookupProfile(env, profile);
+    if (profilePtr == nullptr) {
         return nullptr;
     }
 
+    std::vector<openzl::training::MultiInput> multi;
     try {
         openzl::tools::io::InputSetDir set(dir, false);
-        std::vector<openzl::training::MultiInput> multi;
         for (const auto& inp : set) {
             openzl::training::MultiInput mi;
             mi.add(inp);
             multi.emplace_back(std::move(mi));
         }
+    } catch (const std::exception& ex) {
+        throwIllegalState(env, ex.what());
+        return nullptr;
+    }
+    return trainSamples(env, profile, profilePtr, multi, maxTimeSecs, threads, numSamples, pareto);
+}
 
-        openzl::Compressor compressor;
-        auto args = makeProfileArgs(profile);
-        auto* profilePtr = it->second.get();
-        ZL_GraphID gid = profilePtr->gen(compressor.get(), profilePtr->opaque ? profilePtr->opaque.get() : nullptr, args);
-        compressor.selectStartingGraph(gid);
-
-        openzl::training::TrainParams params;
-        if (threads > 0) {
-            params.threads = static_cast<uint32_t>(threads);
-        }
-        if (numSamples > 0) {
-            params.numSamples = static_cast<size_t>(numSamples);
-        }
-        if (maxTimeSecs > 0) {
-            params.maxTimeSecs = static_cast<size_t>(maxTimeSecs);
-        }
-        params.paretoFrontier = pareto != JNI_FALSE;
-
-        params.compressorGenFunc = [profilePtr, args](openzl::poly::string_view serialized) -> std::unique_ptr<openzl::Compressor> {
-            auto up = std::make_unique<openzl::Compressor>();
-            try {
-                ZL_GraphID gid = profilePtr->gen(up->get(), profilePtr->opaque ? profilePtr->opaque.get() : nullptr, args);
-                up->selectStartingGraph(gid);
-            } catch (...) {
+// Samples are copied once into native memory rather than pinned: training runs for seconds on
+// several threads, far too long to hold a critical region open. Null samples stay empty.
+bool copySamples(JNIEnv* env, jobjectArray inputs, std::vector<std::string>& storage)
+{
+    try {
+        jsize count = env->GetArrayLength(inputs);
+        storage.assign(static_cast<size_t>(count), std::string());
+        for (jsize i = 0; i < count; ++i) {
+            auto* arr = static_cast<jbyteArray>(env->GetObjectArrayElement(inputs, i));
+            if (arr == nullptr) {
+                continue;
             }
-            up->deserialize(serialized);
-            return up;
-        };
-
-        auto trained = openzl::training::train(multi, compressor, params);
-
-        jclass byteArrClass = env->FindClass("[B");
-        if (!byteArrClass) {
-            return nullptr;
-        }
-        jobjectArray out = env->NewObjectArray(static_cast<jsize>(trained.size()), byteArrClass, nullptr);
-        if (out == nullptr) {
-            return nullptr;
-        }
-        for (size_t i = 0; i < trained.size(); ++i) {
-            const std::string_view& sv = *trained[i];
-            jbyteArray ba = env->NewByteArray(static_cast<jsize>(sv.size()));
-            if (ba == nullptr) {
-                return nullptr;
+            jsize len = env->GetArrayLength(arr);
+            storage[i].resize(static_cast<size_t>(len));
+            if (len > 0) {
+                env->GetByteArrayRegion(arr, 0, len, reinterpret_cast<jbyte*>(&storage[i][0]));
             }
-            if (sv.size() > 0) {
-                env->SetByteArrayRegion(ba, 0, static_cast<jsize>(sv.size()), reinterpret_cast<const jbyte*>(sv.data()));
+            env->DeleteLocalRef(arr);
+            if (env->ExceptionCheck()) {
+                return false;
             }
-            env->SetObjectArrayElement(out, static_cast<jsize>(i), ba);
-            env->DeleteLocalRef(ba);
         }
-        return out;
-    } catch (const openzl::cli::InvalidArgsException& ex) {
-        throwIllegalArgument(env, ex.what());
-        return nullptr;
-    } catch (const std::exception& ex) {
-        throwIllegalState(env, ex.what());
-        return nullptr;
+        return true;
+    } catch (const std::bad_alloc&) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to copy training samples");
+        return false;
+    }
+}
+
+std::vector<openzl::training::MultiInput> serialInputs(const std::vector<std::string>& storage)
+{
+    std::vector<openzl::training::MultiInput> multi;
+    multi.reserve(storage.size());
+    for (const auto& sample : storage) {
+        openzl::training::MultiInput mi;
+        mi.add(openzl::Input::refSerial(sample.data(), sample.size()));
+        multi.emplace_back(std::move(mi));
     }
+    return multi;
 }
 
 } // namespace
@@ -154,7 +311,11 @@ extern "C" JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_setPa
     if (!ensureState(state, "setParameter")) {
         return;
     }
-    state->compressor.setParameter(static_cast<openzl::CParam>(param), value);
+    try {
+        state->setPresetParameter(param, value);
+    } catch (const std::exception& ex) {
+        throwIllegalState(env, ex.what());
+    }
 }
 
 extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_getParameter(JNIEnv* env, jobject obj, jint param)
@@ -163,7 +324,7 @@ extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_getPa
     if (!ensureState(state, "getParameter")) {
         return 0;
     }
-    return state->compressor.getParameter(static_cast<openzl::CParam>(param));
+    return state->preset->parameter(param);
 }
 
 extern "C" JNIEXPORT jstring JNICALL Java_io_github_hybledav_OpenZLCompressor_serialize(JNIEnv* env, jobject obj)
@@ -172,7 +333,7 @@ extern "C" JNIEXPORT jstring JNICALL Java_io_github_hybledav_OpenZLCompressor_se
     if (!ensureState(state, "serialize")) {
         return env->NewStringUTF("");
     }
-    std::string result = state->compressor.serialize();
+    std::string result = state->preset->serialize();
     return env->NewStringUTF(result.c_str());
 }
 
@@ -182,7 +343,7 @@ extern "C" JNIEXPORT jstring JNICALL Java_io_github_hybledav_OpenZLCompressor_se
     if (!ensureState(state, "serializeToJson")) {
         return env->NewStringUTF("");
     }
-    std::string result = state->compressor.serializeToJson();
+    std::string result = state->preset->serializeToJson();
     return env->NewStringUTF(result.c_str());
 }
 
@@ -210,6 +371,112 @@ extern "C" JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_reset
         return;
     }
     state->reset();
+    state->outputScratch.trim();
+    state->inputScratch.trim();
+}
+
+extern "C" JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_retainedScratchBytesNative(JNIEnv*, jclass)
+{
+    return static_cast<jlong>(retainedScratchBytes());
+}
+
+extern "C" JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_setScratchLimitsNative(JNIEnv* env,
+        jclass,
+        jlong perStateBytes,
+        jlong totalBytes,
+        jlong shrinkThresholdBytes)
+{
+    if (perStateBytes < 0 || totalBytes < 0 || shrinkThresholdBytes < 0) {
+        throwNew(env, JniRefs().illegalArgumentException, "Scratch limits must be non-negative");
+        return;
+    }
+    setScratchPolicy(ScratchPolicy{ static_cast<size_t>(perStateBytes),
+        static_cast<size_t>(totalBytes),
+        static_cast<size_t>(shrinkThresholdBytes) });
+}
+
+extern "C" JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_setStatePoolCapacityNative(JNIEnv* env,
+        jclass,
+        jint capacity)
+{
+    if (capacity < 0 || static_cast<size_t>(capacity) > MAX_STATE_POOL_CAPACITY) {
+        throwIllegalArgument(env, "State pool capacity must be between 0 and 1024");
+        return;
+    }
+    setStatePoolCapacity(static_cast<size_t>(capacity));
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_pooledStateCountNative(JNIEnv*, jclass)
+{
+    return static_cast<jint>(pooledStateCount());
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_lastErrorCodeNative(JNIEnv* env, jobject obj)
+{
+    // Deliberately skips ensureState(), which would clear the error being queried.
+    auto* state = getState(env, obj);
+    return state != nullptr ? static_cast<jint>(state->lastError.code) : 0;
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_lastErrorKindNative(JNIEnv* env, jobject obj)
+{
+    auto* state = getState(env, obj);
+    return state != nullptr ? static_cast<jint>(state->lastError.kind) : 0;
+}
+
+extern "C" JNIEXPORT jstring JNICALL Java_io_github_hybledav_OpenZLCompressor_lastErrorMessageNative(JNIEnv* env, jobject obj)
+{
+    auto* state = getState(env, obj);
+    if (state == nullptr || state->lastError.code == 0) {
+        return nullptr;
+    }
+    return env->NewStringUTF(describeError(state->lastError).c_str());
+}
+
+extern "C" JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLCompressor_errorCountsNative(JNIEnv* env, jclass)
+{
+    jlong counts[ERROR_COUNTER_SLOTS];
+    for (size_t i = 0; i < ERROR_COUNTER_SLOTS; ++i) {
+        counts[i] = static_cast<jlong>(errorCount(i));
+    }
+    jlongArray result = env->NewLongArray(static_cast<jsize>(ERROR_COUNTER_SLOTS));
+    if (result != nullptr) {
+        env->SetLongArrayRegion(result, 0, static_cast<jsize>(ERROR_COUNTER_SLOTS), counts);
+    }
+    return result;
+}
+
+extern "C" JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_setErrorLoggingNative(JNIEnv*,
+        jclass,
+        jboolean enabled)
+{
+    setErrorLogging(enabled == JNI_TRUE);
+}
+
+extern "C" JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_setPinningThresholdNative(JNIEnv* env,
+        jclass,
+        jlong bytes)
+{
+    if (bytes < 0) {
+        throwIllegalArgument(env, "Pinning threshold must be non-negative");
+        return;
+    }
+    setPinningThreshold(static_cast<size_t>(bytes));
+}
+
+extern "C" JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLCompressor_criticalRegionStatsNative(JNIEnv* env, jclass)
+{
+    CriticalRegionStats stats = criticalRegionStats();
+    jlong values[3] = {
+        static_cast<jlong>(stats.count),
+        static_cast<jlong>(stats.totalNanos),
+        static_cast<jlong>(stats.maxNanos),
+    };
+    jlongArray result = env->NewLongArray(3);
+    if (result != nullptr) {
+        env->SetLongArrayRegion(result, 0, 3, values);
+    }
+    return result;
 }
 
 extern "C" JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_destroyCompressor(JNIEnv* env, jobject obj)
@@ -307,14 +574,20 @@ extern "C" JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_confi
         env->DeleteLocalRef(valueObj);
     }
 
+    // The canonical argument map, with the identity of any file it names, is part of the key, so
+    // repeated configurations with the same arguments reuse one compiled preset.
+    std::string stepKey = profileFingerprint(profile, profileArgs);
     try {
-        auto args = makeProfileArgs(profile, profileArgs);
+        // Arguments are parsed only when the preset is built, so cached profiles skip the parser.
         auto* profilePtr = it->second.get();
-        ZL_GraphID graph = profilePtr->gen(
-                state->compressor.get(),
-                profilePtr->opaque ? profilePtr->opaque.get() : nullptr,
-                args);
-        state->setGraph(graph);
+        PresetStep step = [profilePtr, profile, profileArgs](openzl::Compressor& compressor, ZL_GraphID) {
+            auto args = makeProfileArgs(profile, profileArgs);
+            return profilePtr->gen(
+                    compressor.get(),
+                    profilePtr->opaque ? profilePtr->opaque.get() : nullptr,
+                    args);
+        };
+        state->derivePreset(stepKey, step, true);
     } catch (const openzl::cli::InvalidArgsException& ex) {
         throwIllegalArgument(env, ex.what());
         return;
@@ -343,28 +616,25 @@ extern "C" JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_confi
         return;
     }
 
-    void* bytes = env->GetPrimitiveArrayCritical(compiledDescription, nullptr);
-    if (bytes == nullptr) {
-        throwNew(env, JniRefs().outOfMemoryError, "Unable to access compiled description");
-        return;
-    }
+    std::string description(static_cast<size_t>(length), '\0');
+    env->GetByteArrayRegion(compiledDescription, 0, length, reinterpret_cast<jbyte*>(&description[0]));
 
-    auto result = ZL_SDDL_setupProfile(
-            state->compressor.get(), bytes, static_cast<size_t>(length));
-
-    env->ReleasePrimitiveArrayCritical(compiledDescription, bytes, JNI_ABORT);
-
-    if (ZL_RES_isError(result)) {
-        auto context = state->compressor.getErrorContextString(result);
-        std::string message = "Failed to configure SDDL profile";
-        if (!context.empty()) {
-            message.append(": ").append(context.data(), context.size());
-        }
-        throwIllegalState(env, message);
-        return;
+    try {
+        state->derivePreset("sddl:" + description, [description](openzl::Compressor& compressor, ZL_GraphID) {
+            auto result = ZL_SDDL_setupProfile(compressor.get(), description.data(), description.size());
+            if (ZL_RES_isError(result)) {
+                auto context = compressor.getErrorContextString(result);
+                std::string message = "Failed to configure SDDL profile";
+                if (!context.empty()) {
+                    message.append(": ").append(context.data(), context.size());
+                }
+                throw std::runtime_error(message);
+            }
+            return ZL_RES_value(result);
+        });
+    } catch (const std::exception& ex) {
+        throwIllegalState(env, ex.what());
     }
-
-    state->setGraph(ZL_RES_value(result));
 }
 
 extern "C" JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_setDataArenaNative(JNIEnv* env,
@@ -385,6 +655,7 @@ extern "C" JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_setDa
     ZL_DataArenaType type = (arenaOrdinal == 1) ? ZL_DataArenaType_stack : ZL_DataArenaType_heap;
 
     ZL_Report r = ZL_CCtx_setDataArena(state->cctx, type);
+    state->cctxCustomized = true;
     if (ZL_isError(r)) {
         const char* ctx = ZL_CCtx_getErrorContextString(state->cctx, r);
         std::string message = "Failed to set data arena";
@@ -485,66 +756,200 @@ extern "C" JNIEXPORT jobjectArray JNICALL Java_io_github_hybledav_OpenZLCompress
     std::string profile(profileChars);
     env->ReleaseStringUTFChars(profileName, profileChars);
 
-    namespace fs = std::filesystem;
-    std::error_code ec;
-    fs::path tmpDir = fs::temp_directory_path(ec);
-    if (ec) {
-        throwIllegalState(env, "Unable to resolve temporary directory");
+    auto* profilePtr = lookupProfile(env, profile);
+    if (profilePtr == nullptr) {
         return nullptr;
     }
-    tmpDir /= fs::path("openzl-train-native-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
-    if (!fs::create_directories(tmpDir, ec) || ec) {
-        throwIllegalState(env, "Unable to create temporary training directory");
+
+    std::vector<std::string> storage;
+    if (!copySamples(env, inputs, storage)) {
         return nullptr;
     }
+    auto multi = serialInputs(storage);
+    return trainSamples(env, profile, profilePtr, multi, maxTimeSecs, threads, numSamples, pareto);
+}
 
-    jobjectArray result = nullptr;
-    jsize count = env->GetArrayLength(inputs);
+// Trains on the remaining bytes of direct buffers, which are read in place for the whole run.
+extern "C" JNIEXPORT jobjectArray JNICALL Java_io_github_hybledav_OpenZLCompressor_trainDirectNative(JNIEnv* env,
+        jclass,
+        jstring profileName,
+        jobjectArray samples,
+        jintArray positions,
+        jintArray lengths,
+        jint maxTimeSecs,
+        jint threads,
+        jint numSamples,
+        jboolean pareto)
+{
+    if (profileName == nullptr || samples == nullptr || positions == nullptr || lengths == nullptr) {
+        throwNew(env, JniRefs().nullPointerException, "samples");
+        return nullptr;
+    }
+    jsize count = env->GetArrayLength(samples);
+    if (env->GetArrayLength(positions) != count || env->GetArrayLength(lengths) != count) {
+        throwIllegalArgument(env, "positions and lengths must match samples");
+        return nullptr;
+    }
+
+    const char* profileChars = env->GetStringUTFChars(profileName, nullptr);
+    if (profileChars == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to access profileName");
+        return nullptr;
+    }
+    std::string profile(profileChars);
+    env->ReleaseStringUTFChars(profileName, profileChars);
+    auto* profilePtr = lookupProfile(env, profile);
+    if (profilePtr == nullptr) {
+        return nullptr;
+    }
+
+    std::vector<jint> pos(static_cast<size_t>(count));
+    std::vector<jint> len(static_cast<size_t>(count));
+    if (count > 0) {
+        env->GetIntArrayRegion(positions, 0, count, pos.data());
+        env->GetIntArrayRegion(lengths, 0, count, len.data());
+    }
+    std::vector<openzl::training::MultiInput> multi;
+    multi.reserve(static_cast<size_t>(count));
     for (jsize i = 0; i < count; ++i) {
-        auto* arr = static_cast<jbyteArray>(env->GetObjectArrayElement(inputs, i));
-        if (arr == nullptr) {
-            arr = env->NewByteArray(0);
-        }
-        if (arr == nullptr) {
-            throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate empty input");
-            goto cleanup;
-        }
-        jsize len = env->GetArrayLength(arr);
-        std::string content;
-        content.resize(static_cast<size_t>(len));
-        if (len > 0) {
-            env->GetByteArrayRegion(arr, 0, len, reinterpret_cast<jbyte*>(content.data()));
-            if (env->ExceptionCheck()) {
-                env->DeleteLocalRef(arr);
-                goto cleanup;
-            }
+        jobject buffer = env->GetObjectArrayElement(samples, i);
+        if (!ensureDirectRange(env, buffer, pos[i], len[i], "samples")) {
+            return nullptr;
         }
-        env->DeleteLocalRef(arr);
+        auto* base = static_cast<uint8_t*>(env->GetDirectBufferAddress(buffer));
+        env->DeleteLocalRef(buffer);
+        openzl::training::MultiInput mi;
+        mi.add(openzl::Input::refSerial(base + pos[i], static_cast<size_t>(len[i])));
+        multi.emplace_back(std::move(mi));
+    }
+    return trainSamples(env, profile, profilePtr, multi, maxTimeSecs, threads, numSamples, pareto);
+}
 
-        fs::path filePath = tmpDir / std::to_string(static_cast<int>(i));
-        std::ofstream out(filePath, std::ios::binary);
-        if (!out) {
-            throwIllegalState(env, "Unable to create temporary training file");
-            goto cleanup;
-        }
-        out.write(content.data(), static_cast<std::streamsize>(content.size()));
-        if (!out.good()) {
-            throwIllegalState(env, "Unable to write temporary training file");
-            goto cleanup;
+// Copies the samples into a new job and returns its handle; the caller starts it with
+// runTrainingJobNative on a thread of its own.
+extern "C" JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_createTrainingJobNative(JNIEnv* env,
+        jclass,
+        jstring profileName,
+        jobjectArray inputs,
+        jint maxTimeSecs,
+        jint threads,
+        jint numSamples,
+        jboolean pareto)
+{
+    if (profileName == nullptr || inputs == nullptr) {
+        throwNew(env, JniRefs().nullPointerException, "inputs");
+        return 0;
+    }
+    const char* profileChars = env->GetStringUTFChars(profileName, nullptr);
+    if (profileChars == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to access profileName");
+        return 0;
+    }
+    std::string profile(profileChars);
+    env->ReleaseStringUTFChars(profileName, profileChars);
+    auto* profilePtr = lookupProfile(env, profile);
+    if (profilePtr == nullptr) {
+        return 0;
+    }
+
+    try {
+        auto samples = std::make_shared<std::vector<std::string>>();
+        if (!copySamples(env, inputs, *samples)) {
+            return 0;
         }
+        auto params = makeTrainParams(maxTimeSecs, threads, numSamples, pareto);
+        auto job = std::make_unique<TrainingJob>();
+        job->train = [profile, profilePtr, samples, params](const CandidateHook& onCandidate) {
+            auto multi = serialInputs(*samples);
+            return runTraining(profile, profilePtr, multi, params, onCandidate);
+        };
+        job->measure = [samples](openzl::Compressor& candidate) {
+            return candidateRatio(candidate, *samples);
+        };
+        return trainingJobHandle(std::move(job));
+    } catch (const std::exception& ex) {
+        throwIllegalState(env, std::string("Unable to create training job: ") + ex.what());
+        return 0;
     }
+}
 
-    result = trainFromDirectoryImpl(env,
-            profile,
-            tmpDir.string(),
-            maxTimeSecs,
-            threads,
-            numSamples,
-            pareto);
+// Runs the job to completion on the calling thread. The outcome is read back through
+// trainingProgressNative and trainingResultNative.
+extern "C" JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_runTrainingJobNative(JNIEnv* env,
+        jclass,
+        jlong handle)
+{
+    auto* job = trainingJob(env, handle);
+    if (job != nullptr) {
+        runTrainingJob(*job);
+    }
+}
 
-cleanup:
-    fs::remove_all(tmpDir, ec);
-    return result;
+// Returns [status, candidates, elapsedNanos, bestRatio bits]; elapsed time is live while the
+// job runs.
+extern "C" JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLCompressor_trainingProgressNative(JNIEnv* env,
+        jclass,
+        jlong handle)
+{
+    auto* job = trainingJob(env, handle);
+    if (job == nullptr) {
+        return nullptr;
+    }
+    const TrainingJob& state = *job;
+    jlong status = state.status.load(std::memory_order_acquire);
+    int64_t elapsed = state.elapsedNanos.load(std::memory_order_relaxed);
+    if (elapsed < 0) {
+        elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - state.start).count();
+    }
+    double ratio = state.bestRatio.load(std::memory_order_relaxed);
+    jlong ratioBits;
+    static_assert(sizeof(ratioBits) == sizeof(ratio), "double must be 64 bits");
+    std::memcpy(&ratioBits, &ratio, sizeof(ratio));
+    jlong values[4] = { status, static_cast<jlong>(state.candidates.load(std::memory_order_relaxed)), static_cast<jlong>(elapsed), ratioBits };
+    jlongArray out = env->NewLongArray(4);
+    if (out != nullptr) {
+        env->SetLongArrayRegion(out, 0, 4, values);
+    }
+    return out;
+}
+
+extern "C" JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_cancelTrainingNative(JNIEnv* env, jclass, jlong handle)
+{
+    auto* job = trainingJob(env, handle);
+    if (job != nullptr) {
+        job->cancelled.store(true, std::memory_order_relaxed);
+    }
+}
+
+extern "C" JNIEXPORT jobjectArray JNICALL Java_io_github_hybledav_OpenZLCompressor_trainingResultNative(JNIEnv* env,
+        jclass,
+        jlong handle)
+{
+    auto* job = trainingJob(env, handle);
+    if (job == nullptr) {
+        return nullptr;
+    }
+    TrainingJob& state = *job;
+    jlong status = state.status.load(std::memory_order_acquire);
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (status == TrainingJob::FAILED) {
+        throwIllegalState(env, state.error);
+        return nullptr;
+    }
+    if (status == TrainingJob::CANCELLED) {
+        throwIllegalState(env, "Training job was cancelled");
+        return nullptr;
+    }
+    if (status != TrainingJob::SUCCEEDED) {
+        throwIllegalState(env, "Training job is still running");
+        return nullptr;
+    }
+    return toByteArrays(env, state.results);
+}
+
+extern "C" JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_releaseTrainingJobNative(JNIEnv*, jclass, jlong handle)
+{
+    delete reinterpret_cast<TrainingJob*>(handle);
 }
 
 // Compress a single input using the given profile (untrained/default compressor)
@@ -577,86 +982,55 @@ extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor
         return nullptr;
     }
 
-    jsize len = env->GetArrayLength(input);
-    void* srcPtr = env->GetPrimitiveArrayCritical(input, nullptr);
-    if (srcPtr == nullptr) {
-        throwNew(env, JniRefs().outOfMemoryError, "GetPrimitiveArrayCritical returned null");
+    // The preset is compiled (or found in the cache) before the input is touched, so a cold
+    // cache never compiles while the array is pinned.
+    std::shared_ptr<const CompressionPreset> preset;
+    try {
+        preset = profilePreset(profile, it->second.get());
+    } catch (const std::bad_alloc&) {
+        throwNew(env, JniRefs().outOfMemoryError, "Failed to compile profile compressor");
+        return nullptr;
+    } catch (const std::exception& ex) {
+        throwIllegalState(env, ex.what());
         return nullptr;
     }
 
+    NativeState* state = nullptr;
+    jbyteArray out = nullptr;
     try {
-        openzl::Compressor compressor;
-        auto args = makeProfileArgs(profile);
-        auto* profilePtr = it->second.get();
-        ZL_GraphID gid = profilePtr->gen(compressor.get(), profilePtr->opaque ? profilePtr->opaque.get() : nullptr, args);
-        compressor.selectStartingGraph(gid);
-
-        // Create a temporary C context and compress
-        ZL_CCtx* cctx = ZL_CCtx_create();
-        if (!cctx) {
-            env->ReleasePrimitiveArrayCritical(input, srcPtr, JNI_ABORT);
-            throwNew(env, JniRefs().outOfMemoryError, "Failed to create C context");
-            return nullptr;
-        }
-        // Apply default C context parameters similar to NativeState::applyDefaultParameters
-        ZL_Report rp;
-        rp = ZL_CCtx_setParameter(cctx, ZL_CParam_stickyParameters, 1);
-        if (ZL_isError(rp)) {
-            ZL_CCtx_free(cctx);
-            env->ReleasePrimitiveArrayCritical(input, srcPtr, JNI_ABORT);
-            throwIllegalState(env, "Failed to set cctx parameter stickyParameters");
-            return nullptr;
-        }
-        rp = ZL_CCtx_setParameter(cctx, ZL_CParam_compressionLevel, ZL_COMPRESSIONLEVEL_DEFAULT);
-        if (ZL_isError(rp)) {
-            ZL_CCtx_free(cctx);
-            env->ReleasePrimitiveArrayCritical(input, srcPtr, JNI_ABORT);
-            throwIllegalState(env, "Failed to set cctx parameter compressionLevel");
-            return nullptr;
-        }
-        rp = ZL_CCtx_setParameter(cctx, ZL_CParam_formatVersion, ZL_getDefaultEncodingVersion());
-        if (ZL_isError(rp)) {
-            ZL_CCtx_free(cctx);
-            env->ReleasePrimitiveArrayCritical(input, srcPtr, JNI_ABORT);
-            throwIllegalState(env, "Failed to set cctx parameter formatVersion");
-            return nullptr;
-        }
-
-        ZL_Report r1 = ZL_CCtx_refCompressor(cctx, compressor.get());
-        if (ZL_isError(r1)) {
-            ZL_CCtx_free(cctx);
-            env->ReleasePrimitiveArrayCritical(input, srcPtr, JNI_ABORT);
-            throwIllegalState(env, "Failed to bind compressor to C context");
-            return nullptr;
-        }
-        ZL_Report r2 = ZL_CCtx_selectStartingGraphID(cctx, compressor.get(), gid, nullptr);
-        if (ZL_isError(r2)) {
-            ZL_CCtx_free(cctx);
-            env->ReleasePrimitiveArrayCritical(input, srcPtr, JNI_ABORT);
-            throwIllegalState(env, "Failed to select starting graph");
-            return nullptr;
-        }
-
+        state = acquireState(ZL_GRAPH_ZSTD);
+        state->usePreset(std::move(preset));
+        jsize len = env->GetArrayLength(input);
         size_t bound = ZL_compressBound(static_cast<size_t>(len));
-        std::unique_ptr<uint8_t[]> dst(new uint8_t[bound]);
-        ZL_Report result = ZL_CCtx_compress(cctx, dst.get(), bound, srcPtr, static_cast<size_t>(len));
-        env->ReleasePrimitiveArrayCritical(input, srcPtr, JNI_ABORT);
-        ZL_CCtx_free(cctx);
-        if (ZL_isError(result)) {
-            throwIllegalState(env, "Compression failed for profile compressor");
-            return nullptr;
-        }
-        size_t compressedSize = ZL_RES_value(result);
-        jbyteArray out = env->NewByteArray(static_cast<jsize>(compressedSize));
-        if (compressedSize > 0) {
-            env->SetByteArrayRegion(out, 0, static_cast<jsize>(compressedSize), reinterpret_cast<const jbyte*>(dst.get()));
+        uint8_t* dst = state->outputScratch.ensure(bound);
+        if (dst == nullptr) {
+            throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate compression output");
+        } else {
+            ByteArrayInput source(env, input, 0, len, state->inputScratch);
+            if (source) {
+                ZL_Report result = ZL_CCtx_compress(state->cctx, dst, bound, source.data(), static_cast<size_t>(len));
+                source.release();
+                if (ZL_isError(result)) {
+                    // No Java object owns the pooled state, so the recorded failure is raised here
+                    // as the OpenZLException that failure() would build from it.
+                    recordCompressError(state, "compressWithProfile", result);
+                    throwRecordedError(env, state, "Compression failed for profile " + profile);
+                } else {
+                    size_t compressedSize = ZL_RES_value(result);
+                    out = env->NewByteArray(static_cast<jsize>(compressedSize));
+                    if (out != nullptr && compressedSize > 0) {
+                        env->SetByteArrayRegion(out, 0, static_cast<jsize>(compressedSize), reinterpret_cast<const jbyte*>(dst));
+                    }
+                }
+            }
         }
-        return out;
+    } catch (const std::bad_alloc&) {
+        throwNew(env, JniRefs().outOfMemoryError, "Failed to compress with profile");
     } catch (const std::exception& ex) {
-        env->ReleasePrimitiveArrayCritical(input, srcPtr, JNI_ABORT);
         throwIllegalState(env, ex.what());
-        return nullptr;
     }
+    recycleState(state);
+    return out;
 }
 
 // Compress a single input using a serialized compressor blob. The first jstring is the profile name
@@ -689,46 +1063,22 @@ extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor
     std::string profile(profileChars);
     env->ReleaseStringUTFChars(profileName, profileChars);
 
-    jsize serLen = env->GetArrayLength(serialized);
-    jbyte* serPtr = static_cast<jbyte*>(env->GetPrimitiveArrayCritical(serialized, nullptr));
-    if (serPtr == nullptr) {
-        throwNew(env, JniRefs().outOfMemoryError, "Failed to access serialized array");
-        return nullptr;
-    }
-
-    jsize inLen = env->GetArrayLength(input);
-    void* inPtr = env->GetPrimitiveArrayCritical(input, nullptr);
-    if (inPtr == nullptr) {
-        env->ReleasePrimitiveArrayCritical(serialized, serPtr, JNI_ABORT);
-        throwNew(env, JniRefs().outOfMemoryError, "Failed to access input array");
-        return nullptr;
+    // The compressor is deserialized before the input is touched, so nothing is pinned while
+    // it is built.
+    std::string serializedBytes(static_cast<size_t>(env->GetArrayLength(serialized)), '\0');
+    if (!serializedBytes.empty()) {
+        env->GetByteArrayRegion(serialized, 0, static_cast<jsize>(serializedBytes.size()),
+                reinterpret_cast<jbyte*>(&serializedBytes[0]));
     }
 
+    ZL_CCtx* cctx = nullptr;
     try {
-        // Prepare compressor by initializing profile components
         openzl::Compressor compressor;
-        const auto& profiles = openzl::cli::compressProfiles();
-        auto it = profiles.find(profile);
-        if (it != profiles.end()) {
-            auto args = makeProfileArgs(profile);
-            auto* profilePtr = it->second.get();
-            try {
-                ZL_GraphID gid = profilePtr->gen(compressor.get(), profilePtr->opaque ? profilePtr->opaque.get() : nullptr, args);
-                compressor.selectStartingGraph(gid);
-            } catch (...) {
-                // ignore: profile init best-effort
-            }
-        }
-
-        // Attempt deserialize
-        std::string_view sv(reinterpret_cast<const char*>(serPtr), static_cast<size_t>(serLen));
-        compressor.deserialize(openzl::poly::string_view(sv.data(), sv.size()));
+        loadSerializedCompressor(compressor, profile, serializedBytes.data(), serializedBytes.size());
 
         // Use compressor via a temporary C ctx
-        ZL_CCtx* cctx = ZL_CCtx_create();
+        cctx = ZL_CCtx_create();
         if (!cctx) {
-            env->ReleasePrimitiveArrayCritical(serialized, serPtr, JNI_ABORT);
-            env->ReleasePrimitiveArrayCritical(input, inPtr, JNI_ABORT);
             throwNew(env, JniRefs().outOfMemoryError, "Failed to create C context");
             return nullptr;
         }
@@ -737,24 +1087,18 @@ extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor
         rp2 = ZL_CCtx_setParameter(cctx, ZL_CParam_stickyParameters, 1);
         if (ZL_isError(rp2)) {
             ZL_CCtx_free(cctx);
-            env->ReleasePrimitiveArrayCritical(serialized, serPtr, JNI_ABORT);
-            env->ReleasePrimitiveArrayCritical(input, inPtr, JNI_ABORT);
             throwIllegalState(env, "Failed to set cctx parameter stickyParameters");
             return nullptr;
         }
         rp2 = ZL_CCtx_setParameter(cctx, ZL_CParam_compressionLevel, ZL_COMPRESSIONLEVEL_DEFAULT);
         if (ZL_isError(rp2)) {
             ZL_CCtx_free(cctx);
-            env->ReleasePrimitiveArrayCritical(serialized, serPtr, JNI_ABORT);
-            env->ReleasePrimitiveArrayCritical(input, inPtr, JNI_ABORT);
             throwIllegalState(env, "Failed to set cctx parameter compressionLevel");
             return nullptr;
         }
         rp2 = ZL_CCtx_setParameter(cctx, ZL_CParam_formatVersion, ZL_getDefaultEncodingVersion());
         if (ZL_isError(rp2)) {
             ZL_CCtx_free(cctx);
-            env->ReleasePrimitiveArrayCritical(serialized, serPtr, JNI_ABORT);
-            env->ReleasePrimitiveArrayCritical(input, inPtr, JNI_ABORT);
             throwIllegalState(env, "Failed to set cctx parameter formatVersion");
             return nullptr;
         }
@@ -762,36 +1106,101 @@ extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor
         ZL_Report r1 = ZL_CCtx_refCompressor(cctx, compressor.get());
         if (ZL_isError(r1)) {
             ZL_CCtx_free(cctx);
-            env->ReleasePrimitiveArrayCritical(serialized, serPtr, JNI_ABORT);
-            env->ReleasePrimitiveArrayCritical(input, inPtr, JNI_ABORT);
             throwIllegalState(env, "Failed to bind compressor to C context");
             return nullptr;
         }
 
+        jsize inLen = env->GetArrayLength(input);
         size_t bound = ZL_compressBound(static_cast<size_t>(inLen));
         std::unique_ptr<uint8_t[]> dst(new uint8_t[bound]);
-        ZL_Report result = ZL_CCtx_compress(cctx, dst.get(), bound, inPtr, static_cast<size_t>(inLen));
-        env->ReleasePrimitiveArrayCritical(serialized, serPtr, JNI_ABORT);
-        env->ReleasePrimitiveArrayCritical(input, inPtr, JNI_ABORT);
+        NativeState::ScratchBuffer scratch;
+        ByteArrayInput source(env, input, 0, inLen, scratch);
+        if (!source) {
+            ZL_CCtx_free(cctx);
+            return nullptr;
+        }
+        ZL_Report result = ZL_CCtx_compress(cctx, dst.get(), bound, source.data(), static_cast<size_t>(inLen));
+        source.release();
         ZL_CCtx_free(cctx);
+        cctx = nullptr;
         if (ZL_isError(result)) {
             throwIllegalState(env, "Compression failed for serialized compressor");
             return nullptr;
         }
         size_t compressedSize = ZL_RES_value(result);
         jbyteArray out = env->NewByteArray(static_cast<jsize>(compressedSize));
-        if (compressedSize > 0) {
+        if (out != nullptr && compressedSize > 0) {
             env->SetByteArrayRegion(out, 0, static_cast<jsize>(compressedSize), reinterpret_cast<const jbyte*>(dst.get()));
         }
         return out;
     } catch (const std::exception& ex) {
-        env->ReleasePrimitiveArrayCritical(serialized, serPtr, JNI_ABORT);
-        env->ReleasePrimitiveArrayCritical(input, inPtr, JNI_ABORT);
+        if (cctx != nullptr) {
+            ZL_CCtx_free(cctx);
+        }
         throwIllegalState(env, ex.what());
         return nullptr;
     }
 }
 
+extern "C" JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_loadCompressorNative(JNIEnv* env,
+        jclass,
+        jstring profileName,
+        jbyteArray serialized)
+{
+    if (profileName == nullptr) {
+        throwNew(env, JniRefs().nullPointerException, "profileName");
+        return 0;
+    }
+    if (serialized == nullptr) {
+        throwNew(env, JniRefs().nullPointerException, "serialized");
+        return 0;
+    }
+    const char* profileChars = env->GetStringUTFChars(profileName, nullptr);
+    if (!profileChars) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to access profileName");
+        return 0;
+    }
+    std::string profile(profileChars);
+    env->ReleaseStringUTFChars(profileName, profileChars);
+
+    try {
+        auto bytes = std::make_shared<std::string>(static_cast<size_t>(env->GetArrayLength(serialized)), '\0');
+        env->GetByteArrayRegion(serialized, 0, static_cast<jsize>(bytes->size()), reinterpret_cast<jbyte*>(&(*bytes)[0]));
+        auto preset = trainedPreset(profile, std::move(bytes));
+        return reinterpret_cast<jlong>(new std::shared_ptr<const CompressionPreset>(std::move(preset)));
+    } catch (const std::bad_alloc&) {
+        throwNew(env, JniRefs().outOfMemoryError, "Failed to load serialized compressor");
+        return 0;
+    } catch (const std::exception& ex) {
+        throwIllegalArgument(env, std::string("Invalid serialized compressor: ") + ex.what());
+        return 0;
+    }
+}
+
+extern "C" JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_releaseCompressorNative(JNIEnv*, jclass, jlong handle)
+{
+    delete reinterpret_cast<std::shared_ptr<const CompressionPreset>*>(handle);
+}
+
+extern "C" JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_attachCompressorNative(JNIEnv* env,
+        jobject obj,
+        jlong handle)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "attachCompressor")) {
+        return;
+    }
+    if (handle == 0) {
+        throwIllegalState(env, "Trained compressor has been released");
+        return;
+    }
+    try {
+        state->usePreset(*reinterpret_cast<std::shared_ptr<const CompressionPreset>*>(handle));
+    } catch (const std::exception& ex) {
+        throwIllegalState(env, ex.what());
+    }
+}
+
 extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLSddl_compileNative(JNIEnv* env,
         jclass,
         jstring source,
@@ -14,18 +14,77 @@ JNIEXPORT jstring JNICALL Java_io_github_hybledav_OpenZLCompressor_serialize(JNI
 JNIEXPORT jstring JNICALL Java_io_github_hybledav_OpenZLCompressor_serializeToJson(JNIEnv*, jobject);
 JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_maxCompressedSizeNative(JNIEnv*, jclass, jint);
 JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_resetNative(JNIEnv*, jobject);
+JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_retainedScratchBytesNative(JNIEnv*, jclass);
+JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_setScratchLimitsNative(JNIEnv*, jclass, jlong, jlong, jlong);
+JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_setStatePoolCapacityNative(JNIEnv*, jclass, jint);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_pooledStateCountNative(JNIEnv*, jclass);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_lastErrorCodeNative(JNIEnv*, jobject);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_lastErrorKindNative(JNIEnv*, jobject);
+JNIEXPORT jstring JNICALL Java_io_github_hybledav_OpenZLCompressor_lastErrorMessageNative(JNIEnv*, jobject);
+JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLCompressor_errorCountsNative(JNIEnv*, jclass);
+JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_setErrorLoggingNative(JNIEnv*, jclass, jboolean);
+JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_setPinningThresholdNative(JNIEnv*, jclass, jlong);
+JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLCompressor_criticalRegionStatsNative(JNIEnv*, jclass);
 JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_destroyCompressor(JNIEnv*, jobject);
 JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_destroyCompressorHandleNative(JNIEnv*, jclass, jlong);
 JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compressIntoNative(JNIEnv*, jobject,
         jbyteArray, jint, jint, jbyteArray, jint, jint);
 JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressIntoNative(JNIEnv*, jobject,
         jbyteArray, jint, jint, jbyteArray, jint, jint);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compressBatchNative(JNIEnv*, jobject,
+        jbyteArray, jintArray, jintArray, jbyteArray, jint, jint, jintArray);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressBatchNative(JNIEnv*, jobject,
+        jbyteArray, jintArray, jintArray, jbyteArray, jint, jint, jintArray);
 JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compress(JNIEnv*, jobject, jbyteArray);
 JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_decompress(JNIEnv*, jobject, jbyteArray);
 JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compressDirect(JNIEnv*, jobject,
         jobject, jint, jint, jobject, jint, jint);
 JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressDirect(JNIEnv*, jobject,
         jobject, jint, jint, jobject, jint, jint);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compressBatchDirect(JNIEnv*, jobject,
+        jobject, jint, jint, jintArray, jintArray, jobject, jint, jint, jintArray);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressBatchDirect(JNIEnv*, jobject,
+        jobject, jint, jint, jintArray, jintArray, jobject, jint, jint, jintArray);
+JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressParallelNative(JNIEnv*, jobject,
+        jbyteArray, jint, jint, jint, jint);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compressParallelDirect(JNIEnv*, jobject,
+        jobject, jint, jint, jobject, jint, jint, jint, jint);
+JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_maxParallelCompressedSizeNative(JNIEnv*, jclass,
+        jlong, jint);
+JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressParallelNative(JNIEnv*, jobject,
+        jbyteArray, jint, jint, jint, jlong);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressParallelIntoNative(JNIEnv*, jobject,
+        jbyteArray, jint, jint, jbyteArray, jint, jint, jint, jlong);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressParallelDirect(JNIEnv*, jobject,
+        jobject, jint, jint, jobject, jint, jint, jint, jlong);
+JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_parallelContentSizeNative(JNIEnv*, jobject,
+        jbyteArray, jint, jint);
+JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_parallelContentSizeDirect(JNIEnv*, jobject,
+        jobject, jint, jint);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressRangeDirect(JNIEnv*, jobject,
+        jobject, jint, jint, jlong, jint, jobject, jint, jint, jint);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressRangeFileNative(JNIEnv*, jobject,
+        jstring, jlong, jint, jobject, jint, jint, jint);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_cachedContainerIndexCountNative(JNIEnv*, jclass);
+JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_compressFileNative(JNIEnv*, jobject,
+        jstring, jstring, jlong, jint, jint);
+JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressFileNative(JNIEnv*, jobject,
+        jstring, jstring, jint);
+JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_compressToNativeNative(JNIEnv*, jobject,
+        jbyteArray, jint, jint);
+JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressToNativeNative(JNIEnv*, jobject,
+        jbyteArray, jint, jint);
+JNIEXPORT jobject JNICALL Java_io_github_hybledav_OpenZLCompressor_nativeBufferViewNative(JNIEnv*, jclass, jlong);
+JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_nativeBufferReleaseNative(JNIEnv*, jclass, jlong);
+JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_streamBufferCreateNative(JNIEnv*, jclass, jint);
+JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_streamBufferDestroyNative(JNIEnv*, jclass, jlong);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_streamAppendNative(JNIEnv*, jclass,
+        jlong, jbyteArray, jint, jint);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_streamCompressNative(JNIEnv*, jobject, jlong);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_streamDecompressNative(JNIEnv*, jobject,
+        jlong, jbyteArray, jint, jint);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_streamReadNative(JNIEnv*, jclass,
+        jlong, jint, jbyteArray, jint, jint);
 JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_getDecompressedSizeNative(JNIEnv*, jobject, jbyteArray);
 JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_getDecompressedSizeDirect(JNIEnv*, jobject,
         jobject, jint, jint);
@@ -37,6 +96,24 @@ JNIEXPORT jintArray JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressI
 JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressLongsNative(JNIEnv*, jobject, jbyteArray);
 JNIEXPORT jfloatArray JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressFloatsNative(JNIEnv*, jobject, jbyteArray);
 JNIEXPORT jdoubleArray JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressDoublesNative(JNIEnv*, jobject, jbyteArray);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compressNumericIntoNative(JNIEnv*, jobject, jarray, jint, jint, jint, jbyteArray, jint, jint);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressNumericIntoNative(JNIEnv*, jobject, jbyteArray, jint, jint, jarray, jint, jint, jint);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compressNumericDirectNative(JNIEnv*, jobject, jobject, jint, jint, jint, jobject, jint, jint);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressNumericDirectNative(JNIEnv*, jobject, jobject, jint, jint, jobject, jint, jint, jint);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compressNumericBufferNative(JNIEnv*, jobject, jobject, jint, jint, jint, jboolean, jobject, jint, jint);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressNumericBufferNative(JNIEnv*, jobject, jobject, jint, jint, jobject, jint, jint, jint, jboolean);
+JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressStructsNative(JNIEnv*, jobject, jobject, jint, jint, jint);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compressStructsDirectNative(JNIEnv*, jobject, jobject, jint, jint, jint, jobject, jint, jint);
+JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressStructsNative(JNIEnv*, jobject, jbyteArray);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressStructsDirectNative(JNIEnv*, jobject, jobject, jint, jint, jobject, jint, jint);
+JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressStringArrayNative(JNIEnv*, jobject, jobjectArray, jlong);
+JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressStringsNative(JNIEnv*, jobject, jbyteArray, jintArray);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressStringsNative(JNIEnv*, jobject, jbyteArray, jbyteArray, jintArray);
+JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressTextArrayNative(JNIEnv*, jobject, jobjectArray, jlong);
+JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressStringNative(JNIEnv*, jobject, jstring);
+JNIEXPORT jstring JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressToStringNative(JNIEnv*, jobject, jbyteArray);
+JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressMultiNative(JNIEnv*, jobject, jobjectArray, jintArray, jintArray, jintArray, jintArray, jobjectArray);
+JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressMultiNative(JNIEnv*, jobject, jbyteArray, jobjectArray, jintArray, jintArray, jintArray, jobjectArray);
 JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLCompressor_describeFrameNative(JNIEnv*, jobject, jbyteArray);
 JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLCompressor_describeFrameDirectNative(JNIEnv*, jobject, jobject, jint, jint);
 JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_configureSddlNative(JNIEnv*, jobject, jbyteArray);
@@ -47,11 +124,23 @@ JNIEXPORT jobjectArray JNICALL Java_io_github_hybledav_OpenZLCompressor_trainNat
         jstring, jobjectArray, jint, jint, jint, jboolean);
 JNIEXPORT jobjectArray JNICALL Java_io_github_hybledav_OpenZLCompressor_trainFromDirectoryNative(JNIEnv*, jclass,
         jstring, jstring, jint, jint, jint, jboolean);
+JNIEXPORT jobjectArray JNICALL Java_io_github_hybledav_OpenZLCompressor_trainDirectNative(JNIEnv*, jclass,
+        jstring, jobjectArray, jintArray, jintArray, jint, jint, jint, jboolean);
+JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_createTrainingJobNative(JNIEnv*, jclass,
+        jstring, jobjectArray, jint, jint, jint, jboolean);
+JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_runTrainingJobNative(JNIEnv*, jclass, jlong);
+JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLCompressor_trainingProgressNative(JNIEnv*, jclass, jlong);
+JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_cancelTrainingNative(JNIEnv*, jclass, jlong);
+JNIEXPORT jobjectArray JNICALL Java_io_github_hybledav_OpenZLCompressor_trainingResultNative(JNIEnv*, jclass, jlong);
+JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_releaseTrainingJobNative(JNIEnv*, jclass, jlong);
 
 JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressWithProfileNative(JNIEnv*, jclass,
         jstring, jbyteArray);
 JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressWithSerializedNative(JNIEnv*, jclass,
         jstring, jbyteArray, jbyteArray);
+JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_loadCompressorNative(JNIEnv*, jclass, jstring, jbyteArray);
+JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_releaseCompressorNative(JNIEnv*, jclass, jlong);
+JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_attachCompressorNative(JNIEnv*, jobject, jlong);
 
 JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLSddl_compileNative(JNIEnv*, jclass, jstring, jboolean, jint);
 
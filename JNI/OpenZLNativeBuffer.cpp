@@ -0,0 +1,173 @@
+#include "OpenZLNativeBuffer.h"
+
+#include <array>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace {
+
+constexpr size_t kMinClassShift = 12; // 4 KiB
+constexpr size_t kClassCount = 11;    // up to 4 MiB
+constexpr uint32_t kUnpooledClass = 0xFF;
+constexpr uint32_t kBlockMagic = 0x4F5A4C42u; // "BLZO"
+constexpr size_t kThreadBlocksPerClass = 4;
+constexpr size_t kSharedBlocksPerClass = 16;
+
+struct alignas(16) BlockHeader {
+    uint64_t capacity;
+    uint64_t size;
+    uint32_t sizeClass;
+    uint32_t magic;
+};
+
+BlockHeader* headerOf(const uint8_t* data)
+{
+    return reinterpret_cast<BlockHeader*>(const_cast<uint8_t*>(data) - sizeof(BlockHeader));
+}
+
+uint8_t* dataOf(BlockHeader* header)
+{
+    return reinterpret_cast<uint8_t*>(header) + sizeof(BlockHeader);
+}
+
+uint32_t classFor(size_t capacity)
+{
+    for (uint32_t cls = 0; cls < kClassCount; ++cls) {
+        if (capacity <= (size_t{ 1 } << (kMinClassShift + cls))) {
+            return cls;
+        }
+    }
+    return kUnpooledClass;
+}
+
+struct SharedBlocks {
+    std::mutex mutex;
+    std::array<std::vector<BlockHeader*>, kClassCount> free;
+};
+
+SharedBlocks& sharedBlocks()
+{
+    // Leaked on purpose: thread caches flush into it during thread exit, which can run after
+    // static destructors on some platforms.
+    static SharedBlocks* shared = new SharedBlocks();
+    return *shared;
+}
+
+void releaseToShared(BlockHeader* header)
+{
+    auto& shared = sharedBlocks();
+    {
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        auto& list = shared.free[header->sizeClass];
+        if (list.size() < kSharedBlocksPerClass) {
+            list.push_back(header);
+            return;
+        }
+    }
+    std::free(header);
+}
+
+BlockHeader* takeFromShared(uint32_t cls)
+{
+    auto& shared = sharedBlocks();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    auto& list = shared.free[cls];
+    if (list.empty()) {
+        return nullptr;
+    }
+    BlockHeader* header = list.back();
+    list.pop_back();
+    return header;
+}
+
+struct ThreadSlab {
+    std::array<std::array<BlockHeader*, kThreadBlocksPerClass>, kClassCount> blocks{};
+    std::array<size_t, kClassCount> counts{};
+
+    ~ThreadSlab()
+    {
+        for (uint32_t cls = 0; cls < kClassCount; ++cls) {
+            for (size_t i = 0; i < counts[cls]; ++i) {
+                releaseToShared(blocks[cls][i]);
+            }
+        }
+    }
+
+    BlockHeader* take(uint32_t cls)
+    {
+        if (counts[cls] == 0) {
+            return nullptr;
+        }
+        return blocks[cls][--counts[cls]];
+    }
+
+    bool put(BlockHeader* header)
+    {
+        uint32_t cls = header->sizeClass;
+        if (counts[cls] == kThreadBlocksPerClass) {
+            return false;
+        }
+        blocks[cls][counts[cls]++] = header;
+        return true;
+    }
+};
+
+thread_local ThreadSlab tlsSlab;
+
+} // namespace
+
+uint8_t* nativeBlockAllocate(size_t capacity)
+{
+    uint32_t cls = classFor(capacity);
+    BlockHeader* header = nullptr;
+    size_t blockCapacity = capacity;
+    if (cls != kUnpooledClass) {
+        blockCapacity = size_t{ 1 } << (kMinClassShift + cls);
+        header = tlsSlab.take(cls);
+        if (header == nullptr) {
+            header = takeFromShared(cls);
+        }
+    }
+    if (header == nullptr) {
+        header = static_cast<BlockHeader*>(std::malloc(sizeof(BlockHeader) + blockCapacity));
+        if (header == nullptr) {
+            return nullptr;
+        }
+        header->capacity = blockCapacity;
+        header->sizeClass = cls;
+        header->magic = kBlockMagic;
+    }
+    header->size = 0;
+    return dataOf(header);
+}
+
+void nativeBlockRelease(uint8_t* data)
+{
+    if (data == nullptr) {
+        return;
+    }
+    BlockHeader* header = headerOf(data);
+    if (header->magic != kBlockMagic) {
+        return;
+    }
+    if (header->sizeClass == kUnpooledClass) {
+        header->magic = 0;
+        std::free(header);
+        return;
+    }
+    if (!tlsSlab.put(header)) {
+        releaseToShared(header);
+    }
+}
+
+size_t nativeBlockSize(const uint8_t* data)
+{
+    return static_cast<size_t>(headerOf(data)->size);
+}
+
+void nativeBlockSetSize(uint8_t* data, size_t size)
+{
+    headerOf(data)->size = size;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Block allocator behind OpenZLNativeBuffer. Blocks come in power-of-two size classes; each
+// thread keeps a few freed blocks per class and hands surplus to a shared overflow list, so
+// blocks released on another thread (for example the Cleaner) are still reused. Requests
+// above the largest class go straight to the system allocator.
+uint8_t* nativeBlockAllocate(size_t capacity);
+void nativeBlockRelease(uint8_t* data);
+size_t nativeBlockSize(const uint8_t* data);
+void nativeBlockSetSize(uint8_t* data, size_t size);
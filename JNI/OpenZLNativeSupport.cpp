@@ -1,8 +1,15 @@
 #include "OpenZLNativeSupport.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <limits>
+#include <list>
+#include <map>
 #include <mutex>
 #include <new>
 #include <stdexcept>
@@ -13,11 +20,44 @@ namespace {
 
 CachedJNIRefs gJNIRefs;
 
-constexpr int MAX_GLOBAL_CACHE = 8;
-NativeState* globalCache[MAX_GLOBAL_CACHE];
-int globalCacheSize = 0;
-std::mutex globalCacheMutex;
-thread_local NativeState* tlsCachedState = nullptr;
+// Idle states live in a fixed array of atomic slots. Slot i belongs to shard i % kPoolShards
+// and states are parked in the shard of their starting graph, so acquire usually finds a state
+// that is already configured for the requested graph. Only the first statePoolCapacity slots
+// are used.
+constexpr size_t kPoolShards = 8;
+
+struct alignas(64) PoolSlot {
+    std::atomic<NativeState*> state{ nullptr };
+    std::atomic<uint32_t> graph{ 0 };
+};
+
+PoolSlot statePool[MAX_STATE_POOL_CAPACITY];
+std::atomic<size_t> statePoolCapacity{ DEFAULT_STATE_POOL_CAPACITY };
+std::atomic<uint32_t> poolProbeSeed{ 0 };
+thread_local uint32_t tlsPoolProbe = poolProbeSeed.fetch_add(1, std::memory_order_relaxed);
+
+std::atomic<size_t> scratchRetained{ 0 };
+std::atomic<size_t> scratchPerStateBytes{ size_t{ 64 } << 20 };
+std::atomic<size_t> scratchTotalBytes{ size_t{ 256 } << 20 };
+std::atomic<size_t> scratchShrinkThresholdBytes{ size_t{ 1 } << 20 };
+// States that are never recycled only see ensure(), so it folds usage in every this many calls.
+constexpr size_t kEnsureDecayInterval = 64;
+
+std::atomic<size_t> pinThreshold{ DEFAULT_PINNING_THRESHOLD };
+std::atomic<uint64_t> criticalCount{ 0 };
+std::atomic<uint64_t> criticalTotalNanos{ 0 };
+std::atomic<uint64_t> criticalMaxNanos{ 0 };
+
+std::array<std::atomic<uint64_t>, ERROR_COUNTER_SLOTS> errorCounters{};
+std::atomic<bool> errorLogging{ std::getenv("OPENZL_JNI_LOG_ERRORS") != nullptr };
+constexpr uint32_t kErrorLogLinesPerSecond = 10;
+std::atomic<int64_t> errorLogWindow{ 0 };
+std::atomic<uint32_t> errorLogLines{ 0 };
+std::atomic<uint64_t> errorLogSuppressed{ 0 };
+
+constexpr size_t MAX_DCTX_CACHE = 64;
+std::vector<ZL_DCtx*> dctxCache;
+std::mutex dctxCacheMutex;
 
 jclass makeGlobalClassRef(JNIEnv* env, const char* name)
 {
@@ -30,7 +70,7 @@ jclass makeGlobalClassRef(JNIEnv* env, const char* name)
     return global;
 }
 
-bool ensureExceptionClass(JNIEnv* env, jclass& target, const char* name)
+bool ensureGlobalClass(JNIEnv* env, jclass& target, const char* name)
 {
     if (target != nullptr) {
         return true;
@@ -46,13 +86,77 @@ CachedJNIRefs& JniRefs()
     return gJNIRefs;
 }
 
+NativeState::ScratchBuffer::~ScratchBuffer()
+{
+    scratchRetained.fetch_sub(capacity, std::memory_order_relaxed);
+}
+
+bool NativeState::ScratchBuffer::reallocate(size_t newCapacity)
+{
+    // The old buffer goes first, so that a failed allocation has as much memory as possible.
+    data.reset();
+    scratchRetained.fetch_sub(capacity, std::memory_order_relaxed);
+    capacity = 0;
+    size = 0;
+    if (newCapacity == 0) {
+        return true;
+    }
+    data.reset(new (std::nothrow) uint8_t[newCapacity]);
+    if (!data) {
+        return false;
+    }
+    scratchRetained.fetch_add(newCapacity, std::memory_order_relaxed);
+    capacity = newCapacity;
+    return true;
+}
+
 uint8_t* NativeState::ScratchBuffer::ensure(size_t required)
 {
+    // Empty requests still get a buffer, so that null always means the allocation failed.
+    required = std::max<size_t>(required, 1);
+    peak = std::max(peak, required);
+    bool ok = true;
     if (capacity < required) {
-        data.reset(required == 0 ? nullptr : new uint8_t[required]);
-        capacity = required;
+        ok = reallocate(required);
+    } else if (capacity > scratchPerStateBytes.load(std::memory_order_relaxed)
+            && required <= scratchPerStateBytes.load(std::memory_order_relaxed)) {
+        // An earlier oversized request is not worth keeping once normal-sized calls resume.
+        ok = reallocate(required);
+    } else if (++ensuresSinceDecay >= kEnsureDecayInterval) {
+        decayUsage();
+        if (capacity > scratchShrinkThresholdBytes.load(std::memory_order_relaxed)
+                && capacity > 2 * recentUsage) {
+            ok = reallocate(std::max(recentUsage, required));
+        }
+    }
+    return ok ? data.get() : nullptr;
+}
+
+void NativeState::ScratchBuffer::decayUsage()
+{
+    recentUsage = std::max(peak, recentUsage - recentUsage / 4);
+    peak = 0;
+    ensuresSinceDecay = 0;
+}
+
+void NativeState::ScratchBuffer::trim()
+{
+    decayUsage();
+    size = 0;
+    if (capacity > scratchPerStateBytes.load(std::memory_order_relaxed)
+            || scratchRetained.load(std::memory_order_relaxed) > scratchTotalBytes.load(std::memory_order_relaxed)) {
+        release();
+    } else if (capacity > scratchShrinkThresholdBytes.load(std::memory_order_relaxed)
+            && capacity > 2 * recentUsage) {
+        reallocate(recentUsage);
+    }
+}
+
+void NativeState::ScratchBuffer::release()
+{
+    if (capacity != 0) {
+        reallocate(0);
     }
-    return data.get();
 }
 
 void NativeState::ScratchBuffer::reset()
@@ -75,16 +179,179 @@ const uint8_t* NativeState::ScratchBuffer::ptr() const
     return data.get();
 }
 
+namespace {
+
+void expectSuccess(ZL_Report report, const char* action)
+{
+    if (ZL_isError(report)) {
+        throw std::runtime_error(std::string(action)
+                + " failed: error code "
+                + std::to_string(static_cast<long>(ZL_RES_code(report))));
+    }
+}
+
+// Presets are looked up by fingerprint: the configuration steps that produced them followed by
+// their sorted explicit parameters. The cache keeps the kMaxCachedPresets most recently used;
+// evicted presets stay alive for the states still bound to them.
+constexpr size_t kMaxCachedPresets = 256;
+
+struct PresetRegistry {
+    std::mutex mutex;
+    // Most recently used first.
+    std::list<std::shared_ptr<const CompressionPreset>> recency;
+    std::map<std::string, std::list<std::shared_ptr<const CompressionPreset>>::iterator> presets;
+};
+
+PresetRegistry& presetRegistry()
+{
+    static PresetRegistry* registry = new PresetRegistry();
+    return *registry;
+}
+
+std::string presetFingerprint(const std::string& configFingerprint, const std::map<int, int>& parameters)
+{
+    std::string fingerprint = configFingerprint;
+    for (const auto& parameter : parameters) {
+        fingerprint.append("|param:")
+                .append(std::to_string(parameter.first))
+                .append("=")
+                .append(std::to_string(parameter.second));
+    }
+    return fingerprint;
+}
+
+std::shared_ptr<const CompressionPreset> findOrBuildPreset(const std::string& configFingerprint,
+        std::function<ZL_GraphID(openzl::Compressor&)> recipe,
+        std::map<int, int> parameters,
+        bool cacheable)
+{
+    auto& registry = presetRegistry();
+    std::string fingerprint = presetFingerprint(configFingerprint, parameters);
+    if (cacheable) {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto it = registry.presets.find(fingerprint);
+        if (it != registry.presets.end()) {
+            registry.recency.splice(registry.recency.begin(), registry.recency, it->second);
+            return *it->second;
+        }
+    }
+
+    auto preset = std::make_shared<CompressionPreset>();
+    preset->fingerprint = std::move(fingerprint);
+    preset->configFingerprint = configFingerprint;
+    preset->recipe = std::move(recipe);
+    preset->parameters = std::move(parameters);
+    preset->cacheable = cacheable;
+    preset->graph = preset->recipe(preset->compressor);
+    for (const auto& parameter : preset->parameters) {
+        preset->compressor.setParameter(static_cast<openzl::CParam>(parameter.first), parameter.second);
+    }
+    expectSuccess(
+            ZL_Compressor_selectStartingGraphID(preset->compressor.get(), preset->graph),
+            "ZL_Compressor_selectStartingGraphID");
+
+    if (!cacheable) {
+        return preset;
+    }
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    // Another thread may have built the same preset meanwhile; keep the first one.
+    auto it = registry.presets.find(preset->fingerprint);
+    if (it != registry.presets.end()) {
+        return *it->second;
+    }
+    if (registry.presets.size() >= kMaxCachedPresets) {
+        registry.presets.erase(registry.recency.back()->fingerprint);
+        registry.recency.pop_back();
+    }
+    registry.recency.push_front(preset);
+    registry.presets.emplace(preset->fingerprint, registry.recency.begin());
+    return preset;
+}
+
+} // namespace
+
+int CompressionPreset::parameter(int param) const
+{
+    std::lock_guard<std::mutex> lock(queryMutex);
+    return compressor.getParameter(static_cast<openzl::CParam>(param));
+}
+
+std::string CompressionPreset::serialize() const
+{
+    std::lock_guard<std::mutex> lock(queryMutex);
+    return compressor.serialize();
+}
+
+std::string CompressionPreset::serializeToJson() const
+{
+    std::lock_guard<std::mutex> lock(queryMutex);
+    return compressor.serializeToJson();
+}
+
+std::shared_ptr<const CompressionPreset> graphPreset(ZL_GraphID graph)
+{
+    return findOrBuildPreset("graph:" + std::to_string(graph.gid),
+            [graph](openzl::Compressor&) { return graph; },
+            {},
+            true);
+}
+
+std::shared_ptr<const CompressionPreset> derivedPreset(const CompressionPreset& base,
+        const std::string& stepKey,
+        const PresetStep& step,
+        bool cacheable)
+{
+    auto baseRecipe = base.recipe;
+    return findOrBuildPreset(base.configFingerprint + "|" + stepKey,
+            [baseRecipe, step](openzl::Compressor& compressor) {
+                return step(compressor, baseRecipe(compressor));
+            },
+            base.parameters,
+            cacheable && base.cacheable);
+}
+
+std::shared_ptr<const CompressionPreset> parameterPreset(const CompressionPreset& base, int param, int value)
+{
+    auto parameters = base.parameters;
+    parameters[param] = value;
+    return findOrBuildPreset(base.configFingerprint, base.recipe, std::move(parameters), base.cacheable);
+}
+
+std::shared_ptr<const CompressionPreset> standalonePreset(const std::string& fingerprint,
+        std::function<ZL_GraphID(openzl::Compressor&)> recipe)
+{
+    return findOrBuildPreset(fingerprint, std::move(recipe), {}, false);
+}
+
+std::shared_ptr<const CompressionPreset> sharedPreset(const std::string& fingerprint,
+        std::function<ZL_GraphID(openzl::Compressor&)> recipe)
+{
+    return findOrBuildPreset(fingerprint, std::move(recipe), {}, true);
+}
+
+size_t cachedPresetCount()
+{
+    auto& registry = presetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.presets.size();
+}
+
 NativeState::NativeState(ZL_GraphID graph)
-        : startingGraph(graph)
+        : baseGraph(graph)
 {
     cctx = ZL_CCtx_create();
     dctx = ZL_DCtx_create();
     if (!cctx || !dctx) {
+        if (cctx) {
+            ZL_CCtx_free(cctx);
+        }
+        if (dctx) {
+            ZL_DCtx_free(dctx);
+        }
         throw std::bad_alloc();
     }
     applyDefaultParameters();
-    configureGraph();
+    usePreset(graphPreset(graph));
 }
 
 NativeState::~NativeState()
@@ -97,15 +364,6 @@ NativeState::~NativeState()
     }
 }
 
-void NativeState::expectSuccess(ZL_Report report, const char* action)
-{
-    if (ZL_isError(report)) {
-        throw std::runtime_error(std::string(action)
-                + " failed: error code "
-                + std::to_string(static_cast<long>(ZL_RES_code(report))));
-    }
-}
-
 void NativeState::applyDefaultParameters()
 {
     expectSuccess(
@@ -124,47 +382,102 @@ void NativeState::applyDefaultParameters()
             "ZL_DCtx_setParameter(stickyParameters)");
 }
 
-void NativeState::configureGraph()
+void NativeState::bindPreset()
 {
+    startingGraph = preset->graph;
     expectSuccess(
-            ZL_Compressor_selectStartingGraphID(compressor.get(), startingGraph),
-            "ZL_Compressor_selectStartingGraphID");
-    expectSuccess(
-            ZL_CCtx_refCompressor(cctx, compressor.get()),
+            ZL_CCtx_refCompressor(cctx, preset->compressor.get()),
             "ZL_CCtx_refCompressor");
     expectSuccess(
-            ZL_CCtx_selectStartingGraphID(cctx, compressor.get(), startingGraph, nullptr),
+            ZL_CCtx_selectStartingGraphID(cctx, preset->compressor.get(), startingGraph, nullptr),
             "ZL_CCtx_selectStartingGraphID");
+    boundCompressor = preset->compressor.get();
+}
+
+void NativeState::usePreset(std::shared_ptr<const CompressionPreset> next)
+{
+    if (next == preset && boundCompressor == preset->compressor.get()) {
+        return;
+    }
+    // Hold the previous preset until the CCtx points elsewhere.
+    auto previous = std::move(preset);
+    preset = std::move(next);
+    bindPreset();
+}
+
+void NativeState::derivePreset(const std::string& stepKey, const PresetStep& step, bool cacheable)
+{
+    usePreset(derivedPreset(*preset, stepKey, step, cacheable));
+}
+
+void NativeState::setPresetParameter(int param, int value)
+{
+    usePreset(parameterPreset(*preset, param, value));
 }
 
 void NativeState::setGraph(ZL_GraphID graph)
 {
-    startingGraph = graph;
-    configureGraph();
+    baseGraph = graph;
+    usePreset(graphPreset(graph));
+}
+
+void NativeState::shareCompressor(const NativeState& owner)
+{
+    usePreset(owner.preset);
 }
 
 void NativeState::reset()
 {
-    expectSuccess(ZL_CCtx_resetParameters(cctx), "ZL_CCtx_resetParameters");
-    expectSuccess(ZL_DCtx_resetParameters(dctx), "ZL_DCtx_resetParameters");
-    applyDefaultParameters();
-    configureGraph();
+    if (cctxCustomized) {
+        expectSuccess(ZL_CCtx_resetParameters(cctx), "ZL_CCtx_resetParameters");
+        applyDefaultParameters();
+        cctxCustomized = false;
+        boundCompressor = nullptr;
+    }
+    if (boundCompressor != preset->compressor.get()) {
+        bindPreset();
+    }
     outputScratch.reset();
+    inputScratch.reset();
+}
+
+void NativeState::restoreBase()
+{
+    reset();
+    lastError.clear();
+    if (preset->fingerprint != "graph:" + std::to_string(baseGraph.gid)) {
+        usePreset(graphPreset(baseGraph));
+    }
 }
 
 bool initJniRefs(JNIEnv* env)
 {
     auto& refs = JniRefs();
-    if (!ensureExceptionClass(env, refs.nullPointerException, "java/lang/NullPointerException")) {
+    if (!ensureGlobalClass(env, refs.nullPointerException, "java/lang/NullPointerException")) {
+        return false;
+    }
+    if (!ensureGlobalClass(env, refs.illegalArgumentException, "java/lang/IllegalArgumentException")) {
+        return false;
+    }
+    if (!ensureGlobalClass(env, refs.illegalStateException, "java/lang/IllegalStateException")) {
+        return false;
+    }
+    if (!ensureGlobalClass(env, refs.outOfMemoryError, "java/lang/OutOfMemoryError")) {
+        return false;
+    }
+    if (!ensureGlobalClass(env, refs.ioException, "java/io/IOException")) {
+        return false;
+    }
+    if (!ensureGlobalClass(env, refs.intArrayClass, "[I")) {
         return false;
     }
-    if (!ensureExceptionClass(env, refs.illegalArgumentException, "java/lang/IllegalArgumentException")) {
+    if (!ensureGlobalClass(env, refs.longArrayClass, "[J")) {
         return false;
     }
-    if (!ensureExceptionClass(env, refs.illegalStateException, "java/lang/IllegalStateException")) {
+    if (!ensureGlobalClass(env, refs.floatArrayClass, "[F")) {
         return false;
     }
-    if (!ensureExceptionClass(env, refs.outOfMemoryError, "java/lang/OutOfMemoryError")) {
+    if (!ensureGlobalClass(env, refs.doubleArrayClass, "[D")) {
         return false;
     }
     return true;
@@ -189,6 +502,21 @@ void clearJniRefs(JNIEnv* env)
         env->DeleteGlobalRef(refs.outOfMemoryError);
         refs.outOfMemoryError = nullptr;
     }
+    if (refs.ioException) {
+        env->DeleteGlobalRef(refs.ioException);
+        refs.ioException = nullptr;
+    }
+    if (refs.openZLException) {
+        env->DeleteGlobalRef(refs.openZLException);
+        refs.openZLException = nullptr;
+    }
+    refs.openZLExceptionCreate = nullptr;
+    for (jclass* arrayClass : { &refs.intArrayClass, &refs.longArrayClass, &refs.floatArrayClass, &refs.doubleArrayClass }) {
+        if (*arrayClass) {
+            env->DeleteGlobalRef(*arrayClass);
+            *arrayClass = nullptr;
+        }
+    }
     refs.nativeHandleField = nullptr;
 }
 
@@ -211,28 +539,73 @@ bool ensureNativeHandleField(JNIEnv* env, jobject obj)
     return refs.nativeHandleField != nullptr;
 }
 
-NativeState* acquireState(ZL_GraphID graph)
+namespace {
+
+size_t shardOf(ZL_GraphID graph)
 {
-    NativeState* state = nullptr;
-    if (tlsCachedState != nullptr) {
-        state = tlsCachedState;
-        tlsCachedState = nullptr;
-        state->reset();
-        state->setGraph(graph);
-        return state;
+    return static_cast<size_t>(graph.gid * 2654435761u) % kPoolShards;
+}
+
+NativeState* takeFromShard(size_t shard, size_t capacity, const ZL_GraphID* graph)
+{
+    size_t perShard = (capacity + kPoolShards - 1 - shard) / kPoolShards;
+    for (size_t n = 0; n < perShard; ++n) {
+        // Threads start at different slots so that they do not all race for the first one.
+        auto& slot = statePool[shard + ((tlsPoolProbe + n) % perShard) * kPoolShards];
+        if (slot.state.load(std::memory_order_relaxed) == nullptr) {
+            continue;
+        }
+        if (graph != nullptr && slot.graph.load(std::memory_order_relaxed) != graph->gid) {
+            continue;
+        }
+        NativeState* state = slot.state.exchange(nullptr, std::memory_order_acquire);
+        if (state != nullptr) {
+            return state;
+        }
     }
-    {
-        std::lock_guard<std::mutex> lock(globalCacheMutex);
-        if (globalCacheSize > 0) {
-            state = globalCache[--globalCacheSize];
+    return nullptr;
+}
+
+bool parkInShard(size_t shard, size_t capacity, NativeState* state)
+{
+    size_t perShard = (capacity + kPoolShards - 1 - shard) / kPoolShards;
+    for (size_t n = 0; n < perShard; ++n) {
+        size_t index = shard + ((tlsPoolProbe + n) % perShard) * kPoolShards;
+        auto& slot = statePool[index];
+        NativeState* expected = nullptr;
+        if (slot.state.load(std::memory_order_relaxed) == nullptr
+                && slot.state.compare_exchange_strong(expected, state, std::memory_order_seq_cst)) {
+            // Written after publishing, so readers may see a stale tag; acquireState checks the
+            // state's own graph once it owns it.
+            slot.graph.store(state->baseGraph.gid, std::memory_order_relaxed);
+            // setStatePoolCapacity publishes a smaller capacity before it sweeps the slots above
+            // it, so either the sweep sees this state or this load sees the new capacity.
+            if (index >= statePoolCapacity.load(std::memory_order_seq_cst)) {
+                delete slot.state.exchange(nullptr, std::memory_order_acq_rel);
+            }
+            return true;
         }
     }
-    if (state != nullptr) {
-        state->reset();
+    return false;
+}
+
+} // namespace
+
+NativeState* acquireState(ZL_GraphID graph)
+{
+    size_t capacity = statePoolCapacity.load(std::memory_order_relaxed);
+    size_t home = shardOf(graph);
+    NativeState* state = takeFromShard(home, capacity, &graph);
+    for (size_t i = 1; state == nullptr && i <= kPoolShards; ++i) {
+        state = takeFromShard((home + i) % kPoolShards, capacity, nullptr);
+    }
+    if (state == nullptr) {
+        return new NativeState(graph);
+    }
+    // Pooled states were restored to their base preset when they were recycled.
+    if (state->baseGraph.gid != graph.gid) {
         state->setGraph(graph);
-        return state;
     }
-    state = new NativeState(graph);
     return state;
 }
 
@@ -241,22 +614,177 @@ void recycleState(NativeState* state)
     if (state == nullptr) {
         return;
     }
-    state->reset();
-    if (tlsCachedState == nullptr) {
-        tlsCachedState = state;
-    } else {
-        bool cached = false;
-        {
-            std::lock_guard<std::mutex> lock(globalCacheMutex);
-            if (globalCacheSize < MAX_GLOBAL_CACHE) {
-                globalCache[globalCacheSize++] = state;
-                cached = true;
-            }
+    state->restoreBase();
+    state->outputScratch.trim();
+    state->inputScratch.trim();
+    size_t capacity = statePoolCapacity.load(std::memory_order_relaxed);
+    size_t home = shardOf(state->baseGraph);
+    for (size_t i = 0; i < kPoolShards; ++i) {
+        if (parkInShard((home + i) % kPoolShards, capacity, state)) {
+            return;
         }
-        if (!cached) {
-            delete state;
+    }
+    delete state;
+}
+
+void setStatePoolCapacity(size_t capacity)
+{
+    capacity = std::min(capacity, MAX_STATE_POOL_CAPACITY);
+    statePoolCapacity.store(capacity, std::memory_order_seq_cst);
+    for (size_t i = capacity; i < MAX_STATE_POOL_CAPACITY; ++i) {
+        delete statePool[i].state.exchange(nullptr, std::memory_order_seq_cst);
+    }
+}
+
+size_t pooledStateCount()
+{
+    size_t count = 0;
+    for (auto& slot : statePool) {
+        if (slot.state.load(std::memory_order_relaxed) != nullptr) {
+            ++count;
         }
     }
+    return count;
+}
+
+ScratchPolicy scratchPolicy()
+{
+    return ScratchPolicy{ scratchPerStateBytes.load(std::memory_order_relaxed),
+        scratchTotalBytes.load(std::memory_order_relaxed),
+        scratchShrinkThresholdBytes.load(std::memory_order_relaxed) };
+}
+
+void setScratchPolicy(const ScratchPolicy& policy)
+{
+    scratchPerStateBytes.store(policy.perStateBytes, std::memory_order_relaxed);
+    scratchTotalBytes.store(policy.totalBytes, std::memory_order_relaxed);
+    scratchShrinkThresholdBytes.store(policy.shrinkThresholdBytes, std::memory_order_relaxed);
+}
+
+size_t retainedScratchBytes()
+{
+    return scratchRetained.load(std::memory_order_relaxed);
+}
+
+size_t pinningThreshold()
+{
+    return pinThreshold.load(std::memory_order_relaxed);
+}
+
+void setPinningThreshold(size_t bytes)
+{
+    pinThreshold.store(bytes, std::memory_order_relaxed);
+}
+
+CriticalRegionStats criticalRegionStats()
+{
+    return CriticalRegionStats{ criticalCount.load(std::memory_order_relaxed),
+        criticalTotalNanos.load(std::memory_order_relaxed),
+        criticalMaxNanos.load(std::memory_order_relaxed) };
+}
+
+CriticalRegionTimer::CriticalRegionTimer()
+        : start(std::chrono::steady_clock::now())
+{
+}
+
+CriticalRegionTimer::~CriticalRegionTimer()
+{
+    stop();
+}
+
+void CriticalRegionTimer::stop()
+{
+    if (!running) {
+        return;
+    }
+    running = false;
+    auto nanos = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+                                               .count());
+    criticalCount.fetch_add(1, std::memory_order_relaxed);
+    criticalTotalNanos.fetch_add(nanos, std::memory_order_relaxed);
+    uint64_t previous = criticalMaxNanos.load(std::memory_order_relaxed);
+    while (nanos > previous
+            && !criticalMaxNanos.compare_exchange_weak(previous, nanos, std::memory_order_relaxed)) {
+    }
+}
+
+ByteArrayInput::ByteArrayInput(JNIEnv* e,
+        jbyteArray a,
+        jint offset,
+        jint length,
+        NativeState::ScratchBuffer& scratch)
+        : env(e), array(a)
+{
+    if (static_cast<size_t>(length) >= pinningThreshold()) {
+        timer.discard();
+        uint8_t* copy = scratch.ensure(static_cast<size_t>(length));
+        if (copy == nullptr) {
+            throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate input buffer");
+            return;
+        }
+        if (length > 0) {
+            env->GetByteArrayRegion(array, offset, length, reinterpret_cast<jbyte*>(copy));
+        }
+        bytes = copy;
+        ok = true;
+        return;
+    }
+    pinned = env->GetPrimitiveArrayCritical(array, nullptr);
+    if (pinned == nullptr) {
+        timer.discard();
+        throwNew(env, JniRefs().outOfMemoryError, "Failed to access source array");
+        return;
+    }
+    bytes = static_cast<const uint8_t*>(pinned) + offset;
+    ok = true;
+}
+
+ByteArrayInput::~ByteArrayInput()
+{
+    release();
+}
+
+void ByteArrayInput::release()
+{
+    if (pinned != nullptr) {
+        env->ReleasePrimitiveArrayCritical(array, pinned, JNI_ABORT);
+        pinned = nullptr;
+        timer.stop();
+    }
+}
+
+ZL_DCtx* acquireDCtx()
+{
+    {
+        std::lock_guard<std::mutex> lock(dctxCacheMutex);
+        if (!dctxCache.empty()) {
+            ZL_DCtx* dctx = dctxCache.back();
+            dctxCache.pop_back();
+            return dctx;
+        }
+    }
+    ZL_DCtx* dctx = ZL_DCtx_create();
+    if (!dctx) {
+        throw std::bad_alloc();
+    }
+    return dctx;
+}
+
+void recycleDCtx(ZL_DCtx* dctx)
+{
+    if (dctx == nullptr) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(dctxCacheMutex);
+        if (dctxCache.size() < MAX_DCTX_CACHE) {
+            dctxCache.push_back(dctx);
+            return;
+        }
+    }
+    ZL_DCtx_free(dctx);
 }
 
 NativeState* getState(JNIEnv* env, jobject obj)
@@ -294,7 +822,7 @@ void throwNew(JNIEnv* env, jclass clazz, const char* message)
 void throwIllegalState(JNIEnv* env, const std::string& message)
 {
     auto& refs = JniRefs();
-    if (!ensureExceptionClass(env, refs.illegalStateException, "java/lang/IllegalStateException")) {
+    if (!ensureGlobalClass(env, refs.illegalStateException, "java/lang/IllegalStateException")) {
         throwNew(env, nullptr, message.c_str());
         return;
     }
@@ -304,16 +832,188 @@ void throwIllegalState(JNIEnv* env, const std::string& message)
 void throwIllegalArgument(JNIEnv* env, const std::string& message)
 {
     auto& refs = JniRefs();
-    if (!ensureExceptionClass(env, refs.illegalArgumentException, "java/lang/IllegalArgumentException")) {
+    if (!ensureGlobalClass(env, refs.illegalArgumentException, "java/lang/IllegalArgumentException")) {
         throwNew(env, nullptr, message.c_str());
         return;
     }
     throwNew(env, refs.illegalArgumentException, message.c_str());
 }
 
+void throwIOException(JNIEnv* env, const std::string& message)
+{
+    auto& refs = JniRefs();
+    if (!ensureGlobalClass(env, refs.ioException, "java/io/IOException")) {
+        throwNew(env, nullptr, message.c_str());
+        return;
+    }
+    throwNew(env, refs.ioException, message.c_str());
+}
+
+void throwRecordedError(JNIEnv* env, const NativeState* state, const std::string& message)
+{
+    auto& refs = JniRefs();
+    if (!ensureGlobalClass(env, refs.openZLException, "io/github/hybledav/OpenZLException")) {
+        throwIllegalState(env, message);
+        return;
+    }
+    if (refs.openZLExceptionCreate == nullptr) {
+        refs.openZLExceptionCreate = env->GetStaticMethodID(refs.openZLException,
+                "create",
+                "(Ljava/lang/String;IILjava/lang/String;)Lio/github/hybledav/OpenZLException;");
+        if (refs.openZLExceptionCreate == nullptr) {
+            return;
+        }
+    }
+    const NativeError& error = state->lastError;
+    jstring text = env->NewStringUTF(message.c_str());
+    if (text == nullptr) {
+        return;
+    }
+    jstring detail = nullptr;
+    if (error.code != 0) {
+        detail = env->NewStringUTF(describeError(error).c_str());
+        if (detail == nullptr) {
+            env->DeleteLocalRef(text);
+            return;
+        }
+    }
+    auto exception = static_cast<jthrowable>(env->CallStaticObjectMethod(refs.openZLException,
+            refs.openZLExceptionCreate,
+            text,
+            static_cast<jint>(error.code),
+            static_cast<jint>(error.kind),
+            detail));
+    if (exception != nullptr) {
+        env->Throw(exception);
+        env->DeleteLocalRef(exception);
+    }
+    env->DeleteLocalRef(text);
+    if (detail != nullptr) {
+        env->DeleteLocalRef(detail);
+    }
+}
+
+void NativeError::clear()
+{
+    code = 0;
+    kind = NativeErrorKind::None;
+    operation = "";
+    context[0] = '\0';
+}
+
+NativeErrorKind classifyError(int code)
+{
+    switch (code) {
+    case ZL_ErrorCode_no_error:
+        return NativeErrorKind::None;
+    case ZL_ErrorCode_srcSize_tooSmall:
+    case ZL_ErrorCode_corruption:
+    case ZL_ErrorCode_header_unknown:
+        return NativeErrorKind::CorruptInput;
+    case ZL_ErrorCode_dstCapacity_tooSmall:
+        return NativeErrorKind::DestinationTooSmall;
+    case ZL_ErrorCode_allocation:
+        return NativeErrorKind::Allocation;
+    default:
+        return NativeErrorKind::Generic;
+    }
+}
+
+namespace {
+
+void logError(const char* operation, int code, const char* context)
+{
+    // At most kErrorLogLinesPerSecond lines per wall-clock second; the rest are counted and
+    // summarised when the next second starts.
+    int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+                          .count();
+    int64_t window = errorLogWindow.load(std::memory_order_relaxed);
+    if (now != window && errorLogWindow.compare_exchange_strong(window, now, std::memory_order_relaxed)) {
+        errorLogLines.store(0, std::memory_order_relaxed);
+        uint64_t suppressed = errorLogSuppressed.exchange(0, std::memory_order_relaxed);
+        if (suppressed != 0) {
+            std::fprintf(stderr, "openzl-jni: %llu error reports suppressed\n",
+                    static_cast<unsigned long long>(suppressed));
+        }
+    }
+    if (errorLogLines.fetch_add(1, std::memory_order_relaxed) >= kErrorLogLinesPerSecond) {
+        errorLogSuppressed.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    std::fprintf(stderr, "openzl-jni: %s failed: error code %d%s%s\n",
+            operation,
+            code,
+            context != nullptr ? ": " : "",
+            context != nullptr ? context : "");
+}
+
+} // namespace
+
+void recordError(NativeState* state, const char* operation, int code, const char* context)
+{
+    size_t slot = code >= 0 && static_cast<size_t>(code) < ERROR_COUNTER_SLOTS
+            ? static_cast<size_t>(code)
+            : ERROR_COUNTER_SLOTS - 1;
+    errorCounters[slot].fetch_add(1, std::memory_order_relaxed);
+    if (state != nullptr) {
+        auto& error = state->lastError;
+        error.code = code;
+        error.kind = classifyError(code);
+        error.operation = operation;
+        error.context[0] = '\0';
+        if (context != nullptr) {
+            std::strncpy(error.context, context, NativeError::kContextCapacity - 1);
+            error.context[NativeError::kContextCapacity - 1] = '\0';
+        }
+    }
+    if (errorLogging.load(std::memory_order_relaxed)) {
+        logError(operation, code, context);
+    }
+}
+
+std::string describeError(const NativeError& error)
+{
+    std::string message = std::string(error.operation) + " failed with OpenZL error " + std::to_string(error.code);
+    if (error.context[0] != '\0') {
+        message.append(": ").append(error.context);
+    }
+    return message;
+}
+
+void recordCompressError(NativeState* state, const char* operation, ZL_Report report)
+{
+    recordError(state,
+            operation,
+            static_cast<int>(ZL_RES_code(report)),
+            ZL_CCtx_getErrorContextString(state->cctx, report));
+}
+
+void recordDecompressError(NativeState* state, const char* operation, ZL_Report report)
+{
+    recordError(state,
+            operation,
+            static_cast<int>(ZL_RES_code(report)),
+            ZL_DCtx_getErrorContextString(state->dctx, report));
+}
+
+uint64_t errorCount(size_t slot)
+{
+    return slot < ERROR_COUNTER_SLOTS ? errorCounters[slot].load(std::memory_order_relaxed) : 0;
+}
+
+void setErrorLogging(bool enabled)
+{
+    errorLogging.store(enabled, std::memory_order_relaxed);
+}
+
 bool ensureState(NativeState* state, const char* method)
 {
     if (state != nullptr) {
+        // Every native operation starts here, so a stale failure is never reported for a
+        // later call that failed without recording one.
+        state->lastError.code = 0;
+        state->lastError.kind = NativeErrorKind::None;
         return true;
     }
     std::fprintf(stderr, "OpenZLCompressor.%s called after close()\n", method);
@@ -321,7 +1021,7 @@ bool ensureState(NativeState* state, const char* method)
 }
 
 bool checkArrayRange(JNIEnv* env,
-        jbyteArray array,
+        jarray array,
         jint offset,
         jint length,
         const char* name)
@@ -385,6 +1085,105 @@ bool ensureDirectRange(JNIEnv* env,
     return true;
 }
 
+BatchTable& threadBatchTable()
+{
+    thread_local BatchTable table;
+    return table;
+}
+
+bool readBatchTable(JNIEnv* env,
+        jintArray offsets,
+        jintArray lengths,
+        jlong sourceLength,
+        jintArray frameOffsets,
+        BatchTable& table)
+{
+    auto& refs = JniRefs();
+    if (offsets == nullptr || lengths == nullptr || frameOffsets == nullptr) {
+        throwNew(env, refs.nullPointerException, "batch offsets and lengths are required");
+        return false;
+    }
+    jsize count = env->GetArrayLength(lengths);
+    if (env->GetArrayLength(offsets) != count) {
+        throwNew(env, refs.illegalArgumentException, "offsets and lengths must have the same length");
+        return false;
+    }
+    if (env->GetArrayLength(frameOffsets) <= count) {
+        throwNew(env, refs.illegalArgumentException, "frameOffsets must hold count + 1 entries");
+        return false;
+    }
+
+    table.offsets.resize(static_cast<size_t>(count));
+    table.lengths.resize(static_cast<size_t>(count));
+    table.frameOffsets.resize(static_cast<size_t>(count) + 1);
+    if (count > 0) {
+        env->GetIntArrayRegion(offsets, 0, count, table.offsets.data());
+        env->GetIntArrayRegion(lengths, 0, count, table.lengths.data());
+        if (env->ExceptionCheck()) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < table.count(); ++i) {
+        jlong offset = table.offsets[i];
+        jlong length = table.lengths[i];
+        if (offset < 0 || length < 0 || offset + length > sourceLength) {
+            throwNew(env, refs.illegalArgumentException, "batch entry out of bounds");
+            return false;
+        }
+    }
+    return true;
+}
+
+jlong compressBatchFrames(NativeState* state,
+        const uint8_t* src,
+        BatchTable& table,
+        uint8_t* dst,
+        size_t dstCapacity,
+        jint dstBase)
+{
+    size_t written = 0;
+    for (size_t i = 0; i < table.count(); ++i) {
+        table.frameOffsets[i] = dstBase + static_cast<jint>(written);
+        ZL_Report result = ZL_CCtx_compress(state->cctx,
+                dst + written,
+                dstCapacity - written,
+                src + table.offsets[i],
+                static_cast<size_t>(table.lengths[i]));
+        if (ZL_isError(result)) {
+            recordCompressError(state, "compressBatch", result);
+            return -1;
+        }
+        written += ZL_RES_value(result);
+    }
+    table.frameOffsets[table.count()] = dstBase + static_cast<jint>(written);
+    return static_cast<jlong>(written);
+}
+
+jlong decompressBatchFrames(NativeState* state,
+        const uint8_t* src,
+        BatchTable& table,
+        uint8_t* dst,
+        size_t dstCapacity,
+        jint dstBase)
+{
+    size_t written = 0;
+    for (size_t i = 0; i < table.count(); ++i) {
+        table.frameOffsets[i] = dstBase + static_cast<jint>(written);
+        ZL_Report result = ZL_DCtx_decompress(state->dctx,
+                dst + written,
+                dstCapacity - written,
+                src + table.offsets[i],
+                static_cast<size_t>(table.lengths[i]));
+        if (ZL_isError(result)) {
+            recordDecompressError(state, "decompressBatch", result);
+            return -1;
+        }
+        written += ZL_RES_value(result);
+    }
+    table.frameOffsets[table.count()] = dstBase + static_cast<jint>(written);
+    return static_cast<jlong>(written);
+}
+
 ZL_GraphID graphIdFromOrdinal(jint ordinal)
 {
     switch (ordinal) {
@@ -1,9 +1,15 @@
 #pragma once
 
 #include <jni.h>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 #include "openzl/cpp/Compressor.hpp"
 #include "openzl/zl_compress.h"
 #include "openzl/zl_compressor.h"
@@ -16,6 +22,86 @@ struct CachedJNIRefs {
     jclass illegalArgumentException = nullptr;
     jclass illegalStateException = nullptr;
     jclass outOfMemoryError = nullptr;
+    jclass ioException = nullptr;
+    // io.github.hybledav.OpenZLException and its create(String, int, int, String) factory.
+    jclass openZLException = nullptr;
+    jmethodID openZLExceptionCreate = nullptr;
+    // Primitive array classes, for natives that take a numeric array as Object.
+    jclass intArrayClass = nullptr;
+    jclass longArrayClass = nullptr;
+    jclass floatArrayClass = nullptr;
+    jclass doubleArrayClass = nullptr;
+};
+
+// One configuration step applied to a compressor: receives the starting graph chosen so far and
+// returns the one to use from now on.
+using PresetStep = std::function<ZL_GraphID(openzl::Compressor&, ZL_GraphID)>;
+
+// Compiled compressor configuration (graph, parameters, profile or SDDL description) shared by
+// every NativeState that uses it. Presets are immutable once built, so CCtxs on any thread may
+// reference the same compressor and switching configuration is a pointer swap.
+struct CompressionPreset {
+    std::string fingerprint;
+    // The configuration without explicit parameters: the graph, profile, SDDL description or
+    // trained compressor the preset starts from. Derived presets replay it on a fresh compressor.
+    std::string configFingerprint;
+    std::function<ZL_GraphID(openzl::Compressor&)> recipe;
+    // Explicit parameters, applied after the recipe in key order. Kept as a map so that setting
+    // the same parameters in any order, or repeatedly, lands on the same preset.
+    std::map<int, int> parameters;
+    // False for presets compiled for one caller; presets derived from them inherit it.
+    bool cacheable = true;
+    openzl::Compressor compressor;
+    ZL_GraphID graph{ ZL_GRAPH_ZSTD };
+
+    // Read-only queries on the shared compressor. OpenZL does not promise that these are safe
+    // to run concurrently, so they are serialized per preset.
+    int parameter(int param) const;
+    std::string serialize() const;
+    std::string serializeToJson() const;
+
+private:
+    mutable std::mutex queryMutex;
+};
+
+std::shared_ptr<const CompressionPreset> graphPreset(ZL_GraphID graph);
+// Presets built with cacheable == false are compiled for the caller only, for steps whose
+// outcome depends on more than stepKey (for example files named in profile arguments).
+std::shared_ptr<const CompressionPreset> derivedPreset(const CompressionPreset& base,
+        const std::string& stepKey,
+        const PresetStep& step,
+        bool cacheable = true);
+// `base` with one explicit parameter set or replaced.
+std::shared_ptr<const CompressionPreset> parameterPreset(const CompressionPreset& base, int param, int value);
+// Builds a preset outside the shared cache, for configurations owned by their caller such as
+// loaded trained compressors. `fingerprint` must identify the configuration uniquely.
+std::shared_ptr<const CompressionPreset> standalonePreset(const std::string& fingerprint,
+        std::function<ZL_GraphID(openzl::Compressor&)> recipe);
+// Builds `recipe` once per fingerprint and shares the result through the preset cache.
+std::shared_ptr<const CompressionPreset> sharedPreset(const std::string& fingerprint,
+        std::function<ZL_GraphID(openzl::Compressor&)> recipe);
+size_t cachedPresetCount();
+
+// Coarse classification of OpenZL error codes, mirrored by OpenZLException.Kind in Java.
+enum class NativeErrorKind : int {
+    None = 0,
+    Generic = 1,
+    CorruptInput = 2,
+    DestinationTooSmall = 3,
+    Allocation = 4,
+};
+
+// Most recent failure recorded on a NativeState. The context is copied into fixed storage so
+// that failure paths never allocate; Java reads it only when it builds an exception.
+struct NativeError {
+    static constexpr size_t kContextCapacity = 256;
+
+    int code = 0;
+    NativeErrorKind kind = NativeErrorKind::None;
+    const char* operation = "";
+    char context[kContextCapacity] = {};
+
+    void clear();
 };
 
 struct NativeState {
@@ -23,19 +109,46 @@ struct NativeState {
         std::unique_ptr<uint8_t[]> data;
         size_t capacity = 0;
         size_t size = 0;
+        // Largest request since the last trim() and its exponentially decayed history.
+        size_t peak = 0;
+        size_t recentUsage = 0;
+        // ensure() calls since usage was last folded into recentUsage.
+        size_t ensuresSinceDecay = 0;
+
+        ScratchBuffer() = default;
+        ~ScratchBuffer();
+        ScratchBuffer(const ScratchBuffer&) = delete;
+        ScratchBuffer& operator=(const ScratchBuffer&) = delete;
 
+        // Contents are not preserved when the buffer is reallocated. Returns null, with the
+        // buffer released, when the allocation fails; callers raise OutOfMemoryError.
         uint8_t* ensure(size_t required);
         void reset();
         void setSize(size_t newSize);
+        // Applies the scratch policy; called whenever the owning state goes idle.
+        void trim();
+        void release();
         uint8_t* ptr();
         const uint8_t* ptr() const;
+
+    private:
+        bool reallocate(size_t newCapacity);
+        void decayUsage();
     };
 
-    openzl::Compressor compressor;
     ZL_CCtx* cctx = nullptr;
     ZL_DCtx* dctx = nullptr;
+    // Graph the state was acquired for; recycling returns the state to its plain preset.
+    ZL_GraphID baseGraph{ ZL_GRAPH_ZSTD };
     ZL_GraphID startingGraph{ ZL_GRAPH_ZSTD };
+    std::shared_ptr<const CompressionPreset> preset;
+    // Set by calls that change CCtx parameters directly, so reset() knows to replay defaults.
+    bool cctxCustomized = false;
     ScratchBuffer outputScratch;
+    // Holds source bytes copied or rearranged before an OpenZL call: byte[] payloads above the
+    // pinning threshold, byte-swapped numeric buffers and gathered string arrays.
+    ScratchBuffer inputScratch;
+    NativeError lastError;
 
     explicit NativeState(ZL_GraphID graph);
     ~NativeState();
@@ -45,11 +158,123 @@ struct NativeState {
 
     void reset();
     void setGraph(ZL_GraphID graph);
+    void usePreset(std::shared_ptr<const CompressionPreset> next);
+    // Switches to the preset obtained by applying `step` on top of the current one.
+    void derivePreset(const std::string& stepKey, const PresetStep& step, bool cacheable = true);
+    void setPresetParameter(int param, int value);
+    // Restores the base graph preset and default parameters before the state is pooled.
+    void restoreBase();
+    // Points this state's CCtx at another state's preset so that helper threads can compress
+    // with the owner's configuration without copying it.
+    void shareCompressor(const NativeState& owner);
 
 private:
-    static void expectSuccess(ZL_Report report, const char* action);
     void applyDefaultParameters();
-    void configureGraph();
+    void bindPreset();
+
+    const ZL_Compressor* boundCompressor = nullptr;
+};
+
+// Limits on scratch memory kept alive between calls. Buffers may grow past them while an
+// operation runs; the limits decide what survives once the owning state goes idle.
+struct ScratchPolicy {
+    size_t perStateBytes;
+    size_t totalBytes;
+    size_t shrinkThresholdBytes;
+};
+
+// byte[] calls whose payload reaches this many bytes copy through native scratch with
+// Get/SetByteArrayRegion instead of pinning the arrays for the whole OpenZL call, which would
+// hold off GC for every thread while it runs.
+constexpr size_t DEFAULT_PINNING_THRESHOLD = size_t{ 1 } << 20;
+size_t pinningThreshold();
+void setPinningThreshold(size_t bytes);
+
+struct CriticalRegionStats {
+    uint64_t count;
+    uint64_t totalNanos;
+    uint64_t maxNanos;
+};
+
+CriticalRegionStats criticalRegionStats();
+
+// Measures one GetPrimitiveArrayCritical..ReleasePrimitiveArrayCritical span; call stop()
+// right after the last release.
+class CriticalRegionTimer {
+public:
+    CriticalRegionTimer();
+    ~CriticalRegionTimer();
+    void stop();
+    // Drops the measurement, for spans that turned out not to pin anything.
+    void discard() { running = false; }
+
+private:
+    std::chrono::steady_clock::time_point start;
+    bool running = true;
+};
+
+// Scoped GetPrimitiveArrayCritical pin. No other JNI call may be made while it is held.
+struct JNICriticalArray {
+    JNIEnv* env;
+    jarray array;
+    void* ptr;
+
+    JNICriticalArray(JNIEnv* e, jarray a) : env(e), array(a) {
+        ptr = env->GetPrimitiveArrayCritical(array, nullptr);
+    }
+
+    ~JNICriticalArray() {
+        release();
+    }
+
+    JNICriticalArray(const JNICriticalArray&) = delete;
+    JNICriticalArray& operator=(const JNICriticalArray&) = delete;
+
+    void* get() const { return ptr; }
+    void release(jint mode = JNI_ABORT) {
+        if (ptr != nullptr) {
+            env->ReleasePrimitiveArrayCritical(array, ptr, mode);
+            ptr = nullptr;
+        }
+    }
+    operator bool() const { return ptr != nullptr; }
+};
+
+// Source range of a byte[] for one OpenZL call, following the pinning policy: ranges that reach
+// the threshold are copied into `scratch`, smaller ones stay pinned (and timed) until release().
+// When the bool conversion is false an OutOfMemoryError has been raised.
+class ByteArrayInput {
+public:
+    ByteArrayInput(JNIEnv* env, jbyteArray array, jint offset, jint length, NativeState::ScratchBuffer& scratch);
+    ~ByteArrayInput();
+
+    ByteArrayInput(const ByteArrayInput&) = delete;
+    ByteArrayInput& operator=(const ByteArrayInput&) = delete;
+
+    const uint8_t* data() const { return bytes; }
+    // Must be called before the next JNI call when the range is pinned.
+    void release();
+    explicit operator bool() const { return ok; }
+
+private:
+    JNIEnv* env;
+    jbyteArray array;
+    void* pinned = nullptr;
+    const uint8_t* bytes = nullptr;
+    bool ok = false;
+    CriticalRegionTimer timer;
+};
+
+ScratchPolicy scratchPolicy();
+void setScratchPolicy(const ScratchPolicy& policy);
+size_t retainedScratchBytes();
+
+struct BatchTable {
+    std::vector<jint> offsets;
+    std::vector<jint> lengths;
+    std::vector<jint> frameOffsets;
+
+    size_t count() const { return lengths.size(); }
 };
 
 CachedJNIRefs& JniRefs();
@@ -60,11 +285,40 @@ void clearJniRefs(JNIEnv* env);
 NativeState* acquireState(ZL_GraphID graph);
 void recycleState(NativeState* state);
 
+// Upper bound on idle NativeStates kept for reuse; states recycled while the pool is full
+// are freed.
+constexpr size_t DEFAULT_STATE_POOL_CAPACITY = 64;
+constexpr size_t MAX_STATE_POOL_CAPACITY = 1024;
+
+void setStatePoolCapacity(size_t capacity);
+size_t pooledStateCount();
+
+ZL_DCtx* acquireDCtx();
+void recycleDCtx(ZL_DCtx* dctx);
+
 NativeState* getState(JNIEnv* env, jobject obj);
 void setNativeHandle(JNIEnv* env, jobject obj, NativeState* value);
 
+// Records a failed call on `state` (which may be null): keeps code and context for Java,
+// bumps the per-code counter and, when enabled, writes a rate-limited line to stderr.
+void recordError(NativeState* state, const char* operation, int code, const char* context);
+void recordCompressError(NativeState* state, const char* operation, ZL_Report report);
+void recordDecompressError(NativeState* state, const char* operation, ZL_Report report);
+NativeErrorKind classifyError(int code);
+// "<operation> failed with OpenZL error <code>[: <context>]", the detail Java shows for a failure.
+std::string describeError(const NativeError& error);
+// Throws the OpenZLException that OpenZLCompressor.failure(message) would build from the error
+// recorded on `state`, for natives that have no Java object to read it back from.
+void throwRecordedError(JNIEnv* env, const NativeState* state, const std::string& message);
+
+// Counters are indexed by OpenZL error code; the last slot collects larger codes.
+constexpr size_t ERROR_COUNTER_SLOTS = 128;
+uint64_t errorCount(size_t slot);
+void setErrorLogging(bool enabled);
+
+// Also clears the state's last error, so call it once at the start of each operation.
 bool ensureState(NativeState* state, const char* method);
-bool checkArrayRange(JNIEnv* env, jbyteArray array, jint offset, jint length, const char* name);
+bool checkArrayRange(JNIEnv* env, jarray array, jint offset, jint length, const char* name);
 bool ensureDirect(JNIEnv* env, jobject buffer, const char* name);
 bool ensureDirectRange(JNIEnv* env,
         jobject buffer,
@@ -72,9 +326,30 @@ bool ensureDirectRange(JNIEnv* env,
         jint length,
         const char* name);
 
+BatchTable& threadBatchTable();
+bool readBatchTable(JNIEnv* env,
+        jintArray offsets,
+        jintArray lengths,
+        jlong sourceLength,
+        jintArray frameOffsets,
+        BatchTable& table);
+jlong compressBatchFrames(NativeState* state,
+        const uint8_t* src,
+        BatchTable& table,
+        uint8_t* dst,
+        size_t dstCapacity,
+        jint dstBase);
+jlong decompressBatchFrames(NativeState* state,
+        const uint8_t* src,
+        BatchTable& table,
+        uint8_t* dst,
+        size_t dstCapacity,
+        jint dstBase);
+
 void throwNew(JNIEnv* env, jclass clazz, const char* message);
 void throwIllegalState(JNIEnv* env, const std::string& message);
 void throwIllegalArgument(JNIEnv* env, const std::string& message);
+void throwIOException(JNIEnv* env, const std::string& message);
 
 ZL_GraphID graphIdFromOrdinal(jint ordinal);
 jint graphOrdinalFromId(ZL_GraphID graph);
@@ -0,0 +1,566 @@
+#include "OpenZLParallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t MAX_POOL_WORKERS = 256;
+
+struct ParallelJob {
+    const std::function<void(unsigned)>* body = nullptr;
+    std::mutex mutex;
+    std::condition_variable done;
+    unsigned running = 0;
+    unsigned nextParticipant = 1;
+    bool closed = false;
+    std::exception_ptr failure;
+
+    void record(std::exception_ptr error)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!failure) {
+            failure = error;
+        }
+    }
+};
+
+void participate(ParallelJob& job)
+{
+    unsigned participant;
+    {
+        std::lock_guard<std::mutex> lock(job.mutex);
+        if (job.closed) {
+            return;
+        }
+        participant = job.nextParticipant++;
+        ++job.running;
+    }
+    try {
+        (*job.body)(participant);
+    } catch (...) {
+        job.record(std::current_exception());
+    }
+    std::lock_guard<std::mutex> lock(job.mutex);
+    if (--job.running == 0) {
+        job.done.notify_all();
+    }
+}
+
+class WorkerPool {
+public:
+    static WorkerPool& instance()
+    {
+        // Intentionally leaked: detached workers may still be parked on the queue at exit.
+        static WorkerPool* pool = new WorkerPool();
+        return *pool;
+    }
+
+    void submit(std::shared_ptr<ParallelJob> job, size_t helpers)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Parked workers take queued entries first; only the shortfall needs new threads.
+        size_t pending = queue_.size() + helpers;
+        size_t spawn = pending > idle_ ? pending - idle_ : 0;
+        spawn = std::min(spawn, MAX_POOL_WORKERS - workers_);
+        for (size_t i = 0; i < spawn; ++i) {
+            std::thread([this] { workerLoop(); }).detach();
+            ++workers_;
+        }
+        for (size_t i = 0; i < helpers; ++i) {
+            queue_.push_back(job);
+        }
+        ready_.notify_all();
+    }
+
+private:
+    void workerLoop()
+    {
+        for (;;) {
+            std::shared_ptr<ParallelJob> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ++idle_;
+                ready_.wait(lock, [this] { return !queue_.empty(); });
+                --idle_;
+                job = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            participate(*job);
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<std::shared_ptr<ParallelJob>> queue_;
+    size_t workers_ = 0;
+    size_t idle_ = 0;
+};
+
+class ByteBudget {
+public:
+    explicit ByteBudget(jlong limit)
+            : limit_(limit > 0 ? static_cast<size_t>(limit) : 0)
+    {
+    }
+
+    void acquire(size_t bytes)
+    {
+        if (limit_ == 0) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(mutex_);
+        available_.wait(lock, [&] { return inFlight_ == 0 || inFlight_ + bytes <= limit_; });
+        inFlight_ += bytes;
+    }
+
+    void release(size_t bytes)
+    {
+        if (limit_ == 0) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        inFlight_ -= bytes;
+        available_.notify_all();
+    }
+
+private:
+    size_t limit_;
+    size_t inFlight_ = 0;
+    std::mutex mutex_;
+    std::condition_variable available_;
+};
+
+struct WorkerDCtxGuard {
+    ZL_DCtx* dctx = nullptr;
+
+    ~WorkerDCtxGuard()
+    {
+        recycleDCtx(dctx);
+    }
+};
+
+struct WorkerStateGuard {
+    NativeState* state = nullptr;
+
+    ~WorkerStateGuard()
+    {
+        recycleState(state);
+    }
+};
+
+} // namespace
+
+void runParallel(unsigned parallelism, const std::function<void(unsigned participant)>& body)
+{
+    if (parallelism <= 1) {
+        body(0);
+        return;
+    }
+    auto job = std::make_shared<ParallelJob>();
+    job->body = &body;
+    WorkerPool::instance().submit(job, parallelism - 1);
+
+    try {
+        body(0);
+    } catch (...) {
+        job->record(std::current_exception());
+    }
+
+    // Helpers that have not started yet see `closed` and return without touching `body`,
+    // so the caller never waits on a queue slot that another job is holding.
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->closed = true;
+    job->done.wait(lock, [&] { return job->running == 0; });
+    if (job->failure) {
+        std::rethrow_exception(job->failure);
+    }
+}
+
+unsigned resolveParallelism(jint threads, size_t taskCount)
+{
+    size_t requested = threads > 0 ? static_cast<size_t>(threads)
+                                   : std::max(1u, std::thread::hardware_concurrency());
+    requested = std::min(requested, MAX_POOL_WORKERS);
+    return static_cast<unsigned>(std::max<size_t>(1, std::min(requested, taskCount)));
+}
+
+uint32_t readLE32(const uint8_t* ptr)
+{
+    return static_cast<uint32_t>(ptr[0]) | (static_cast<uint32_t>(ptr[1]) << 8)
+            | (static_cast<uint32_t>(ptr[2]) << 16) | (static_cast<uint32_t>(ptr[3]) << 24);
+}
+
+uint64_t readLE64(const uint8_t* ptr)
+{
+    return static_cast<uint64_t>(readLE32(ptr)) | (static_cast<uint64_t>(readLE32(ptr + 4)) << 32);
+}
+
+void writeLE16(uint8_t* ptr, uint16_t value)
+{
+    ptr[0] = static_cast<uint8_t>(value);
+    ptr[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void writeLE32(uint8_t* ptr, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i) {
+        ptr[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+void writeLE64(uint8_t* ptr, uint64_t value)
+{
+    writeLE32(ptr, static_cast<uint32_t>(value));
+    writeLE32(ptr + 4, static_cast<uint32_t>(value >> 32));
+}
+
+size_t chunkedContainerBound(size_t contentSize, size_t chunkSize)
+{
+    if (chunkSize == 0) {
+        return 0;
+    }
+    size_t chunkCount = (contentSize + chunkSize - 1) / chunkSize;
+    return kChunkedHeaderSize + chunkCount * (kChunkedEntrySize + ZL_compressBound(chunkSize));
+}
+
+size_t compressChunkedContainer(NativeState* state,
+        const uint8_t* src,
+        size_t srcSize,
+        uint8_t* dst,
+        size_t dstCapacity,
+        size_t chunkSize,
+        jint threads)
+{
+    if (chunkSize < kChunkedMinChunkSize || chunkSize > kChunkedMaxChunkSize) {
+        throw std::invalid_argument("chunkSize out of range");
+    }
+    size_t chunkCount = (srcSize + chunkSize - 1) / chunkSize;
+    if (chunkCount > UINT32_MAX) {
+        throw std::invalid_argument("Input has too many chunks");
+    }
+    size_t tableEnd = kChunkedHeaderSize + chunkCount * kChunkedEntrySize;
+    size_t stride = ZL_compressBound(chunkSize);
+    if (dstCapacity < chunkedContainerBound(srcSize, chunkSize)) {
+        throw ChunkedError(ZL_ErrorCode_dstCapacity_tooSmall, "Destination too small for chunked container");
+    }
+
+    // Every chunk owns a worst-case slot so workers never coordinate on output offsets;
+    // the frames are compacted behind the table once all of them are done.
+    std::vector<ChunkedEntry> entries(chunkCount);
+    std::atomic<size_t> nextChunk{ 0 };
+    std::atomic<bool> failed{ false };
+    unsigned parallelism = resolveParallelism(threads, chunkCount);
+
+    runParallel(parallelism, [&](unsigned participant) {
+        WorkerStateGuard guard;
+        NativeState* worker = state;
+        if (participant != 0) {
+            guard.state = acquireState(state->baseGraph);
+            guard.state->shareCompressor(*state);
+            worker = guard.state;
+        }
+        for (;;) {
+            size_t index = nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (index >= chunkCount || failed.load(std::memory_order_relaxed)) {
+                return;
+            }
+            size_t offset = index * chunkSize;
+            size_t length = std::min(chunkSize, srcSize - offset);
+            ZL_Report r = ZL_CCtx_compress(
+                    worker->cctx, dst + tableEnd + index * stride, stride, src + offset, length);
+            if (ZL_isError(r)) {
+                failed.store(true, std::memory_order_relaxed);
+                const char* ctx = ZL_CCtx_getErrorContextString(worker->cctx, r);
+                throw ChunkedError(static_cast<int>(ZL_RES_code(r)),
+                        std::string("Chunk ") + std::to_string(index) + " failed to compress"
+                                + (ctx && ctx[0] != '\0' ? std::string(": ") + ctx : ""));
+            }
+            entries[index].compressedSize = static_cast<uint32_t>(ZL_RES_value(r));
+            entries[index].contentSize = static_cast<uint32_t>(length);
+        }
+    });
+
+    size_t written = tableEnd;
+    for (size_t i = 0; i < chunkCount; ++i) {
+        uint8_t* slot = dst + tableEnd + i * stride;
+        if (slot != dst + written) {
+            std::memmove(dst + written, slot, entries[i].compressedSize);
+        }
+        uint8_t* entry = dst + kChunkedHeaderSize + i * kChunkedEntrySize;
+        writeLE32(entry, entries[i].compressedSize);
+        writeLE32(entry + 4, entries[i].contentSize);
+        written += entries[i].compressedSize;
+    }
+
+    writeLE32(dst, kChunkedMagic);
+    writeLE16(dst + 4, kChunkedVersion);
+    writeLE16(dst + 6, 0);
+    writeLE32(dst + 8, static_cast<uint32_t>(chunkSize));
+    writeLE32(dst + 12, static_cast<uint32_t>(chunkCount));
+    writeLE64(dst + 16, static_cast<uint64_t>(srcSize));
+    return written;
+}
+
+bool parseChunkedContainer(const uint8_t* src, size_t srcSize, ChunkedLayout& layout, std::string& error)
+{
+    if (srcSize < kChunkedHeaderSize || readLE32(src) != kChunkedMagic) {
+        error = "Input is not an OpenZL chunked container";
+        return false;
+    }
+    uint16_t version = static_cast<uint16_t>(src[4] | (src[5] << 8));
+    if (version != kChunkedVersion) {
+        error = "Unsupported chunked container version " + std::to_string(version);
+        return false;
+    }
+    size_t chunkCount = readLE32(src + 12);
+    layout.chunkSize = readLE32(src + 8);
+    uint64_t contentSize = readLE64(src + 16);
+    if (chunkCount > (srcSize - kChunkedHeaderSize) / kChunkedEntrySize) {
+        error = "Chunk table exceeds container size";
+        return false;
+    }
+    if (contentSize > SIZE_MAX) {
+        error = "Container content size exceeds addressable memory";
+        return false;
+    }
+    layout.contentSize = static_cast<size_t>(contentSize);
+
+    size_t frameOffset = kChunkedHeaderSize + chunkCount * kChunkedEntrySize;
+    size_t contentOffset = 0;
+    layout.entries.resize(chunkCount);
+    layout.frameOffsets.resize(chunkCount);
+    layout.contentOffsets.resize(chunkCount);
+    for (size_t i = 0; i < chunkCount; ++i) {
+        const uint8_t* entry = src + kChunkedHeaderSize + i * kChunkedEntrySize;
+        ChunkedEntry& e = layout.entries[i];
+        e.compressedSize = readLE32(entry);
+        e.contentSize = readLE32(entry + 4);
+        if (e.compressedSize > srcSize - frameOffset) {
+            error = "Chunk " + std::to_string(i) + " extends past the end of the container";
+            return false;
+        }
+        if (e.contentSize > layout.chunkSize || e.contentSize > layout.contentSize - contentOffset) {
+            error = "Chunk " + std::to_string(i) + " has an invalid content size";
+            return false;
+        }
+        layout.frameOffsets[i] = frameOffset;
+        layout.contentOffsets[i] = contentOffset;
+        frameOffset += e.compressedSize;
+        contentOffset += e.contentSize;
+    }
+    if (contentOffset != layout.contentSize) {
+        error = "Chunk table does not add up to the container content size";
+        return false;
+    }
+    return true;
+}
+
+void decompressChunkedContainer(NativeState* state,
+        const ChunkedLayout& layout,
+        const uint8_t* src,
+        uint8_t* dst,
+        size_t dstCapacity,
+        jint threads,
+        jlong maxInFlightBytes)
+{
+    if (dstCapacity < layout.contentSize) {
+        throw ChunkedError(ZL_ErrorCode_dstCapacity_tooSmall, "Destination too small for chunked container content");
+    }
+    size_t chunkCount = layout.entries.size();
+    std::atomic<size_t> nextChunk{ 0 };
+    std::atomic<bool> failed{ false };
+    ByteBudget budget(maxInFlightBytes);
+    unsigned parallelism = resolveParallelism(threads, chunkCount);
+
+    runParallel(parallelism, [&](unsigned participant) {
+        WorkerDCtxGuard guard;
+        ZL_DCtx* dctx = state->dctx;
+        if (participant != 0) {
+            guard.dctx = acquireDCtx();
+            dctx = guard.dctx;
+        }
+        for (;;) {
+            size_t index = nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (index >= chunkCount || failed.load(std::memory_order_relaxed)) {
+                return;
+            }
+            const ChunkedEntry& entry = layout.entries[index];
+            budget.acquire(entry.contentSize);
+            ZL_Report r = ZL_DCtx_decompress(dctx,
+                    dst + layout.contentOffsets[index],
+                    entry.contentSize,
+                    src + layout.frameOffsets[index],
+                    entry.compressedSize);
+            budget.release(entry.contentSize);
+            if (ZL_isError(r) || ZL_RES_value(r) != entry.contentSize) {
+                failed.store(true, std::memory_order_relaxed);
+                std::string message = "Chunk " + std::to_string(index) + " failed to decompress";
+                if (ZL_isError(r)) {
+                    const char* ctx = ZL_DCtx_getErrorContextString(dctx, r);
+                    if (ctx && ctx[0] != '\0') {
+                        message.append(": ").append(ctx);
+                    }
+                }
+                throw ChunkedError(
+                        ZL_isError(r) ? static_cast<int>(ZL_RES_code(r)) : ZL_ErrorCode_corruption, message);
+            }
+        }
+    });
+}
+
+namespace {
+
+struct CachedChunkedLayout {
+    const uint8_t* address = nullptr;
+    size_t size = 0;
+    // Header and chunk table as they were parsed, compared on every hit. The header holds the
+    // chunk count, so a rewritten container with a different count never matches.
+    std::vector<uint8_t> table;
+    std::shared_ptr<const ChunkedLayout> layout;
+};
+
+std::mutex& chunkedLayoutCacheMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+// Most recently used first.
+std::deque<CachedChunkedLayout>& chunkedLayoutCache()
+{
+    static std::deque<CachedChunkedLayout> cache;
+    return cache;
+}
+
+} // namespace
+
+std::shared_ptr<const ChunkedLayout> cachedChunkedLayout(const uint8_t* src, size_t srcSize, std::string& error)
+{
+    // Too-short inputs fall through to parseChunkedContainer, which reports them.
+    if (srcSize >= kChunkedHeaderSize) {
+        std::lock_guard<std::mutex> lock(chunkedLayoutCacheMutex());
+        auto& cache = chunkedLayoutCache();
+        for (auto it = cache.begin(); it != cache.end(); ++it) {
+            if (it->address == src && it->size == srcSize
+                    && std::memcmp(it->table.data(), src, it->table.size()) == 0) {
+                CachedChunkedLayout hit = std::move(*it);
+                cache.erase(it);
+                cache.push_front(std::move(hit));
+                return cache.front().layout;
+            }
+        }
+    }
+
+    auto layout = std::make_shared<ChunkedLayout>();
+    if (!parseChunkedContainer(src, srcSize, *layout, error)) {
+        return nullptr;
+    }
+    CachedChunkedLayout entry;
+    entry.address = src;
+    entry.size = srcSize;
+    entry.table.assign(src, src + kChunkedHeaderSize + layout->entries.size() * kChunkedEntrySize);
+    entry.layout = layout;
+
+    std::lock_guard<std::mutex> lock(chunkedLayoutCacheMutex());
+    auto& cache = chunkedLayoutCache();
+    for (auto it = cache.begin(); it != cache.end(); ++it) {
+        if (it->address == src && it->size == srcSize) {
+            cache.erase(it);
+            break;
+        }
+    }
+    cache.push_front(std::move(entry));
+    if (cache.size() > kChunkedIndexCacheEntries) {
+        cache.pop_back();
+    }
+    return layout;
+}
+
+size_t cachedChunkedLayoutCount()
+{
+    std::lock_guard<std::mutex> lock(chunkedLayoutCacheMutex());
+    return chunkedLayoutCache().size();
+}
+
+void decompressChunkedRange(NativeState* state,
+        const ChunkedLayout& layout,
+        const uint8_t* src,
+        size_t offset,
+        size_t length,
+        uint8_t* dst,
+        jint threads)
+{
+    if (length == 0) {
+        return;
+    }
+    size_t end = offset + length;
+    const auto& starts = layout.contentOffsets;
+    size_t first = static_cast<size_t>(std::upper_bound(starts.begin(), starts.end(), offset) - starts.begin()) - 1;
+    size_t last = static_cast<size_t>(std::lower_bound(starts.begin(), starts.end(), end) - starts.begin()) - 1;
+    size_t chunkCount = last - first + 1;
+    std::atomic<size_t> nextChunk{ 0 };
+    std::atomic<bool> failed{ false };
+    unsigned parallelism = resolveParallelism(threads, chunkCount);
+
+    runParallel(parallelism, [&](unsigned participant) {
+        WorkerDCtxGuard guard;
+        ZL_DCtx* dctx = state->dctx;
+        if (participant != 0) {
+            guard.dctx = acquireDCtx();
+            dctx = guard.dctx;
+        }
+        // Chunks cut by the range boundary are decoded here and only their overlap copied.
+        std::unique_ptr<uint8_t[]> partial;
+        size_t partialSize = 0;
+        for (;;) {
+            size_t slot = nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (slot >= chunkCount || failed.load(std::memory_order_relaxed)) {
+                return;
+            }
+            size_t index = first + slot;
+            const ChunkedEntry& entry = layout.entries[index];
+            size_t chunkStart = starts[index];
+            size_t from = std::max(offset, chunkStart);
+            size_t to = std::min(end, chunkStart + entry.contentSize);
+            bool whole = from == chunkStart && to == chunkStart + entry.contentSize;
+            // Sized from the validated table: the header's chunk size is not checked against it.
+            if (!whole && partialSize < entry.contentSize) {
+                partial.reset(new uint8_t[entry.contentSize]);
+                partialSize = entry.contentSize;
+            }
+            uint8_t* target = whole ? dst + (chunkStart - offset) : partial.get();
+            ZL_Report r = ZL_DCtx_decompress(dctx,
+                    target,
+                    entry.contentSize,
+                    src + layout.frameOffsets[index],
+                    entry.compressedSize);
+            if (ZL_isError(r) || ZL_RES_value(r) != entry.contentSize) {
+                failed.store(true, std::memory_order_relaxed);
+                std::string message = "Chunk " + std::to_string(index) + " failed to decompress";
+                if (ZL_isError(r)) {
+                    const char* ctx = ZL_DCtx_getErrorContextString(dctx, r);
+                    if (ctx && ctx[0] != '\0') {
+                        message.append(": ").append(ctx);
+                    }
+                }
+                throw ChunkedError(
+                        ZL_isError(r) ? static_cast<int>(ZL_RES_code(r)) : ZL_ErrorCode_corruption, message);
+            }
+            if (!whole) {
+                std::memcpy(dst + (from - offset), partial.get() + (from - chunkStart), to - from);
+            }
+        }
+    });
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "OpenZLNativeSupport.h"
+
+// Chunked container layout (all integers little endian):
+//   u32 magic, u16 version, u16 flags, u32 chunkSize, u32 chunkCount, u64 contentSize
+//   chunkCount x { u32 compressedSize, u32 contentSize }
+//   chunkCount OpenZL frames, back to back
+constexpr uint32_t kChunkedMagic = 0x504C5A4Fu; // "OZLP"
+constexpr uint16_t kChunkedVersion = 1;
+constexpr size_t kChunkedHeaderSize = 24;
+constexpr size_t kChunkedEntrySize = 8;
+constexpr size_t kChunkedMinChunkSize = 64 * 1024;
+constexpr size_t kChunkedMaxChunkSize = 1024u * 1024u * 1024u;
+// Parsed chunk tables kept for containers read by range.
+constexpr size_t kChunkedIndexCacheEntries = 16;
+
+struct ChunkedEntry {
+    uint32_t compressedSize = 0;
+    uint32_t contentSize = 0;
+};
+
+struct ChunkedLayout {
+    size_t chunkSize = 0;
+    size_t contentSize = 0;
+    std::vector<ChunkedEntry> entries;
+    // Absolute offsets of each frame in the container and of each chunk in the output.
+    std::vector<size_t> frameOffsets;
+    std::vector<size_t> contentOffsets;
+};
+
+// Failure of a chunked operation that maps to an OpenZL error code.
+struct ChunkedError : std::runtime_error {
+    int code;
+
+    ChunkedError(int errorCode, const std::string& message)
+            : std::runtime_error(message), code(errorCode)
+    {
+    }
+};
+
+// Runs body(participant) on up to `parallelism` threads, the calling thread included, and
+// returns once every participant that started has finished. Helpers come from a process-wide
+// pool that grows on demand; the first exception thrown by a participant is rethrown here.
+void runParallel(unsigned parallelism, const std::function<void(unsigned participant)>& body);
+
+unsigned resolveParallelism(jint threads, size_t taskCount);
+uint32_t readLE32(const uint8_t* ptr);
+uint64_t readLE64(const uint8_t* ptr);
+void writeLE16(uint8_t* ptr, uint16_t value);
+void writeLE32(uint8_t* ptr, uint32_t value);
+void writeLE64(uint8_t* ptr, uint64_t value);
+
+size_t chunkedContainerBound(size_t contentSize, size_t chunkSize);
+size_t compressChunkedContainer(NativeState* state,
+        const uint8_t* src,
+        size_t srcSize,
+        uint8_t* dst,
+        size_t dstCapacity,
+        size_t chunkSize,
+        jint threads);
+
+// Validates the header and chunk table; on failure returns false and fills `error`.
+bool parseChunkedContainer(const uint8_t* src, size_t srcSize, ChunkedLayout& layout, std::string& error);
+// Decodes every chunk straight into dst at its content offset. A positive `maxInFlightBytes`
+// caps the decompressed bytes being produced concurrently; one chunk may always proceed.
+void decompressChunkedContainer(NativeState* state,
+        const ChunkedLayout& layout,
+        const uint8_t* src,
+        uint8_t* dst,
+        size_t dstCapacity,
+        jint threads,
+        jlong maxInFlightBytes);
+
+// Returns the parsed layout of the container at `src`, reusing the one cached for the same
+// address and size when its header and chunk table bytes are unchanged. Returns null and
+// fills `error` when the container is invalid.
+std::shared_ptr<const ChunkedLayout> cachedChunkedLayout(const uint8_t* src, size_t srcSize, std::string& error);
+size_t cachedChunkedLayoutCount();
+// Decodes content bytes [offset, offset + length) into dst, touching only the chunks that
+// overlap the range; the caller checks the range against layout.contentSize.
+void decompressChunkedRange(NativeState* state,
+        const ChunkedLayout& layout,
+        const uint8_t* src,
+        size_t offset,
+        size_t length,
+        uint8_t* dst,
+        jint threads);
+// Clips [offset, offset + length) to the content of `layout` and decodes it into `dst`, shared
+// by the buffer and file range natives. Returns the bytes written, or -1 once an exception is
+// pending or the failure is recorded on the state.
+jint decodeContainerRange(JNIEnv* env,
+        NativeState* state,
+        const ChunkedLayout& layout,
+        const uint8_t* src,
+        jlong offset,
+        jint length,
+        uint8_t* dst,
+        jint dstLen,
+        jint threads);
@@ -1,8 +1,10 @@
 #include "OpenZLProtobuf.h"
 #include "OpenZLNativeSupport.h"
+#include "OpenZLTraining.h"
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -12,6 +14,7 @@
 #include <mutex>
 #include <string>
 #include <stdexcept>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 #include <deque>
@@ -34,31 +37,6 @@
 #include "tools/training/utils/utils.h"
 
 namespace {
-struct JNICriticalArray {
-    JNIEnv* env;
-    jarray array;
-    void* ptr;
-
-    JNICriticalArray(JNIEnv* e, jarray a) : env(e), array(a) {
-        ptr = env->GetPrimitiveArrayCritical(array, nullptr);
-    }
-
-    ~JNICriticalArray() {
-        if (ptr != nullptr) {
-            env->ReleasePrimitiveArrayCritical(array, ptr, JNI_ABORT);
-        }
-    }
-
-    void* get() const { return ptr; }
-    void release() {
-        if (ptr != nullptr) {
-            env->ReleasePrimitiveArrayCritical(array, ptr, JNI_ABORT);
-            ptr = nullptr;
-        }
-    }
-    operator bool() const { return ptr != nullptr; }
-};
-
 enum class Protocol : jint {
     Proto = 0,
     Zl    = 1,
@@ -196,13 +174,7 @@ std::string copyArray(JNIEnv* env, jbyteArray array)
     if (length == 0) {
         return data;
     }
-    JNICriticalArray raw(env, array);
-    if (!raw) {
-        throwNew(env, JniRefs().outOfMemoryError, "Failed to access array contents");
-        return {};
-    }
-    std::memcpy(data.data(), raw.get(), static_cast<size_t>(length));
-    raw.release();
+    env->GetByteArrayRegion(array, 0, length, reinterpret_cast<jbyte*>(&data[0]));
     return data;
 }
 
@@ -782,6 +754,109 @@ void applyTrainedCompressor(
     }
 }
 
+void trainAndPublish(
+        const std::string& typeName,
+        const std::vector<std::string>& samples,
+        size_t minSamples)
+{
+    std::string serialized;
+    try {
+        serialized = trainCompressorFromSamples(typeName, samples, minSamples);
+    } catch (...) {
+        serialized.clear();
+    }
+
+    auto& registryState = CompressorTrainingRegistry::instance().state(typeName);
+    std::lock_guard<std::mutex> lock(registryState.mutex);
+    registryState.trainingInProgress = false;
+    if (!serialized.empty()) {
+        // Converts pick the new compressor up through applyTrainedCompressor on their next call.
+        registryState.serialized       = serialized;
+        registryState.trainingComplete = true;
+        ++registryState.generation;
+    } else {
+        // Training failed: keep gathering more samples.
+        registryState.trainingComplete = false;
+    }
+}
+
+// Auto-training runs on one background thread so that the convert call that crosses the sample
+// threshold returns at once; converts keep using the current compressor meanwhile. At most one
+// job per message type is queued because trainingInProgress stays set until it is published.
+class AutoTrainingWorker {
+public:
+    struct Job {
+        std::string typeName;
+        std::vector<std::string> samples;
+        size_t minSamples;
+    };
+
+    struct Status {
+        size_t queued;
+        bool running;
+        uint64_t completed;
+        uint64_t lastDurationNanos;
+    };
+
+    static AutoTrainingWorker& instance()
+    {
+        // Never destroyed: the detached worker may still be waiting on it at exit.
+        static auto* worker = new AutoTrainingWorker();
+        return *worker;
+    }
+
+    void submit(Job job)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!started_) {
+            std::thread([this]() { run(); }).detach();
+            started_ = true;
+        }
+        queue_.push_back(std::move(job));
+        ready_.notify_one();
+    }
+
+    Status status()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return Status{ queue_.size(), running_, completed_, lastDurationNanos_ };
+    }
+
+private:
+    AutoTrainingWorker() = default;
+
+    void run()
+    {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_.wait(lock, [this]() { return !queue_.empty(); });
+                job = std::move(queue_.front());
+                queue_.pop_front();
+                running_ = true;
+            }
+            auto start = std::chrono::steady_clock::now();
+            trainAndPublish(job.typeName, job.samples, job.minSamples);
+            auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start)
+                                 .count();
+            std::lock_guard<std::mutex> lock(mutex_);
+            running_ = false;
+            ++completed_;
+            lastDurationNanos_ = static_cast<uint64_t>(nanos);
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<Job> queue_;
+    bool started_ = false;
+    bool running_ = false;
+    uint64_t completed_ = 0;
+    uint64_t lastDurationNanos_ = 0;
+};
+
 void maybeAugmentTraining(
         const std::string& typeName,
         Protocol inputProtocol,
@@ -834,34 +909,16 @@ void maybeAugmentTraining(
         return;
     }
 
-    std::string serialized;
     try {
-        serialized = trainCompressorFromSamples(typeName, samplesToTrain, minSamplesForTraining);
+        AutoTrainingWorker::instance().submit(
+                AutoTrainingWorker::Job{ typeName, std::move(samplesToTrain), minSamplesForTraining });
     } catch (...) {
-        serialized.clear();
-    }
-
-    bool publish = false;
-    {
+        // The worker could not take the job; let a later call collect samples again.
         std::lock_guard<std::mutex> lock(registryState.mutex);
         registryState.trainingInProgress = false;
-        if (!serialized.empty()) {
-            registryState.serialized       = serialized;
-            registryState.trainingComplete = true;
-            ++registryState.generation;
-            publish = true;
-        } else {
-            // Training failed: keep gathering more samples.
-            registryState.trainingComplete = false;
-        }
-    }
-
-    if (publish) {
-        applyTrainedCompressor(typeName, entry);
     }
 }
 
-
 struct StructuredJNIRefs {
     jclass inputsClass = nullptr;
     jfieldID fieldIdsField = nullptr;
@@ -1881,7 +1938,7 @@ jbyteArray convertPayload(JNIEnv* env,
                     payloadPtr,
                     payloadLength,
                     *serializerEntry);
-            // Training may have swapped the compressor; refresh pointer for clarity.
+            // A newly published compressor may have been applied; refresh pointer for clarity.
             serializerPtr = &serializerEntry->serializer;
         }
 
@@ -1895,6 +1952,154 @@ jbyteArray convertPayload(JNIEnv* env,
         return nullptr;
     }
 }
+
+// Protobuf samples parsed for training. The training inputs own their bytes; the serializer
+// holds the base compressor that training starts from.
+struct ProtobufTrainingSet {
+    openzl::protobuf::ProtoSerializer serializer;
+    std::vector<openzl::training::MultiInput> multiInputs;
+};
+
+// Returns null with a pending Java exception when a sample cannot be read.
+std::shared_ptr<ProtobufTrainingSet> protobufTrainingSet(
+        JNIEnv* env,
+        jobjectArray samples,
+        Protocol inProto,
+        const std::string& typeName)
+{
+    jsize count = env->GetArrayLength(samples);
+    auto set = std::make_shared<ProtobufTrainingSet>();
+    openzl::protobuf::ProtoDeserializer deserializer;
+    set->multiInputs.reserve(static_cast<size_t>(count));
+
+    for (jsize idx = 0; idx < count; ++idx) {
+        auto sample = static_cast<jbyteArray>(env->GetObjectArrayElement(samples, idx));
+        if (sample == nullptr) {
+            throwNew(env, JniRefs().nullPointerException, "samples element");
+            return nullptr;
+        }
+        std::string payload = copyArray(env, sample);
+        env->DeleteLocalRef(sample);
+
+        google::protobuf::Message& message = reusableMessage(typeName);
+        parseIntoMessage(env, inProto, payload, message, deserializer);
+        if (env->ExceptionCheck()) {
+            return nullptr;
+        }
+
+        auto trainingInputs = set->serializer.getTrainingInputs(message);
+        openzl::training::MultiInput multi;
+        for (auto& input : trainingInputs) {
+            multi.add(std::move(input));
+        }
+        set->multiInputs.emplace_back(std::move(multi));
+    }
+    return set;
+}
+
+std::vector<std::string> trainProtobuf(
+        ProtobufTrainingSet& set,
+        openzl::training::TrainParams params,
+        const CandidateHook& onCandidate)
+{
+    // The candidate builder may run on the trainer's threads, so a graph failure is kept here
+    // and reported once the trainer returns.
+    auto genFailure = std::make_shared<CandidateFailure>();
+    params.compressorGenFunc = [onCandidate, genFailure](openzl::poly::string_view serialized) {
+        auto up = std::make_unique<openzl::Compressor>();
+        try {
+            ZL_GraphID gid = openzl::protobuf::ZL_Protobuf_registerGraph(up->get());
+            up->selectStartingGraph(gid);
+        } catch (const std::exception& ex) {
+            genFailure->record(ex.what());
+        } catch (...) {
+            genFailure->record("unknown error");
+        }
+        up->deserialize(serialized);
+        if (onCandidate) {
+            onCandidate(*up);
+        }
+        return up;
+    };
+
+    auto trained = openzl::training::train(set.multiInputs, *set.serializer.getCompressor(), params);
+    genFailure->rethrow("Protobuf graph failed to build a candidate");
+    return serializedCandidates(trained);
+}
+
+// Structured samples parsed for training. The training inputs point into `storages`, whose
+// buffers stay put when the vector grows.
+struct StructuredTrainingSet {
+    explicit StructuredTrainingSet(const std::string& type)
+        : typeName(type), baseCompressor(createStructuredCompressorForType(type))
+    {
+    }
+
+    std::string typeName;
+    openzl::Compressor baseCompressor;
+    std::vector<StructuredSampleStorage> storages;
+    std::vector<openzl::training::MultiInput> multiInputs;
+};
+
+// Returns null with a pending Java exception when a sample is missing.
+std::shared_ptr<StructuredTrainingSet> structuredTrainingSet(
+        JNIEnv* env,
+        jobjectArray samples,
+        const std::string& typeName)
+{
+    jsize count = env->GetArrayLength(samples);
+    auto set = std::make_shared<StructuredTrainingSet>(typeName);
+    set->storages.reserve(static_cast<size_t>(count));
+    set->multiInputs.reserve(static_cast<size_t>(count));
+
+    for (jsize idx = 0; idx < count; ++idx) {
+        auto sample = static_cast<jbyteArray>(env->GetObjectArrayElement(samples, idx));
+        if (sample == nullptr) {
+            throwNew(env, JniRefs().nullPointerException, "samples element");
+            return nullptr;
+        }
+        std::string payload = copyArray(env, sample);
+        env->DeleteLocalRef(sample);
+        set->storages.emplace_back(parseStructuredSample(payload));
+        auto inputs = buildStructuredInputs(set->storages.back());
+        openzl::training::MultiInput multi;
+        for (auto& input : inputs) {
+            multi.add(std::move(input));
+        }
+        set->multiInputs.emplace_back(std::move(multi));
+    }
+    return set;
+}
+
+std::vector<std::string> trainStructured(
+        StructuredTrainingSet& set,
+        openzl::training::TrainParams params,
+        const CandidateHook& onCandidate)
+{
+    auto genFailure = std::make_shared<CandidateFailure>();
+    std::string typeName = set.typeName;
+    params.compressorGenFunc = [typeName, onCandidate, genFailure](openzl::poly::string_view serialized) {
+        std::unique_ptr<openzl::Compressor> up;
+        try {
+            up = std::make_unique<openzl::Compressor>(createStructuredCompressorForType(typeName));
+        } catch (const std::exception& ex) {
+            genFailure->record(ex.what());
+            up = std::make_unique<openzl::Compressor>();
+        } catch (...) {
+            genFailure->record("unknown error");
+            up = std::make_unique<openzl::Compressor>();
+        }
+        up->deserialize(serialized);
+        if (onCandidate) {
+            onCandidate(*up);
+        }
+        return up;
+    };
+
+    auto trained = openzl::training::train(set.multiInputs, set.baseCompressor, params);
+    genFailure->rethrow("Structured protobuf graph failed to build a candidate");
+    return serializedCandidates(trained);
+}
 } // namespace
 
 extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLProtobuf_convertNative(
@@ -1926,21 +2131,18 @@ extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLProtobuf_c
     }
 
     try {
-        jsize length = env->GetArrayLength(payload);
-        JNICriticalArray raw(env, payload);
-        if (!raw) {
-            throwNew(env, JniRefs().outOfMemoryError, "Failed to access payload contents");
+        // convertPayload makes JNI calls, so the payload is copied rather than pinned.
+        std::string input = copyArray(env, payload);
+        if (env->ExceptionCheck()) {
             return nullptr;
         }
-        jbyteArray result = convertPayload(env,
+        return convertPayload(env,
                 inProto,
                 outProto,
-                raw.get(),
-                static_cast<size_t>(length),
+                input.data(),
+                input.size(),
                 compressorBytes,
                 typeName);
-        raw.release();
-        return result;
     } catch (const std::exception& ex) {
         throwIllegalState(env, ex.what());
         return nullptr;
@@ -2074,6 +2276,26 @@ extern "C" JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLProtobuf_d
     return out;
 }
 
+// Returns [queued, running, completed, lastDurationNanos] for the auto-training worker.
+extern "C" JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLProtobuf_autoTrainingStatusNative(
+        JNIEnv* env,
+        jclass)
+{
+    auto status = AutoTrainingWorker::instance().status();
+    jlong values[4] = {
+            static_cast<jlong>(status.queued),
+            status.running ? 1 : 0,
+            static_cast<jlong>(status.completed),
+            static_cast<jlong>(status.lastDurationNanos)};
+    jlongArray out = env->NewLongArray(4);
+    if (out == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate auto-training status");
+        return nullptr;
+    }
+    env->SetLongArrayRegion(out, 0, 4, values);
+    return out;
+}
+
 extern "C" JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLProtobuf_structuredProfileNative(
         JNIEnv* env,
         jclass)
@@ -2257,72 +2479,61 @@ extern "C" JNIEXPORT jobjectArray JNICALL Java_io_github_hybledav_OpenZLStructur
     }
 
     try {
-        openzl::Compressor baseCompressor = createStructuredCompressorForType(typeName);
-        std::vector<StructuredSampleStorage> storages;
-        storages.reserve(static_cast<size_t>(count));
-        std::vector<openzl::training::MultiInput> multiInputs;
-        multiInputs.reserve(static_cast<size_t>(count));
-
-        for (jsize idx = 0; idx < count; ++idx) {
-            auto sample = static_cast<jbyteArray>(env->GetObjectArrayElement(samples, idx));
-            if (sample == nullptr) {
-                throwNew(env, JniRefs().nullPointerException, "samples element");
-                return nullptr;
-            }
-            std::string payload = copyArray(env, sample);
-            env->DeleteLocalRef(sample);
-            storages.emplace_back(parseStructuredSample(payload));
-            auto inputs = buildStructuredInputs(storages.back());
-            openzl::training::MultiInput multi;
-            for (auto& input : inputs) {
-                multi.add(std::move(input));
-            }
-            multiInputs.emplace_back(std::move(multi));
+        auto set = structuredTrainingSet(env, samples, typeName);
+        if (set == nullptr) {
+            return nullptr;
         }
+        return toByteArrays(env,
+                trainStructured(*set, makeTrainParams(maxTimeSecs, threads, numSamples, pareto), nullptr));
+    } catch (const std::exception& ex) {
+        throwIllegalState(env, ex.what());
+        return nullptr;
+    }
+}
 
-        openzl::training::TrainParams params;
-        if (threads > 0) {
-            params.threads = static_cast<uint32_t>(threads);
-        }
-        if (numSamples > 0) {
-            params.numSamples = static_cast<size_t>(numSamples);
-        }
-        if (maxTimeSecs > 0) {
-            params.maxTimeSecs = static_cast<size_t>(maxTimeSecs);
-        }
-        params.paretoFrontier = pareto != JNI_FALSE;
-        params.compressorGenFunc = [typeName](openzl::poly::string_view serialized) {
-            auto up = std::make_unique<openzl::Compressor>(createStructuredCompressorForType(typeName));
-            up->deserialize(serialized);
-            return up;
-        };
+// Parses the samples into a training job and returns its handle; OpenZLTrainingJob runs it.
+extern "C" JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLStructuredProtoBridge_createStructuredTrainingJobNative(
+        JNIEnv* env,
+        jclass,
+        jobjectArray samples,
+        jint maxTimeSecs,
+        jint threads,
+        jint numSamples,
+        jboolean pareto,
+        jstring messageType)
+{
+    if (samples == nullptr) {
+        throwNew(env, JniRefs().nullPointerException, "samples");
+        return 0;
+    }
+    if (env->GetArrayLength(samples) == 0) {
+        throwIllegalArgument(env, "samples must not be empty");
+        return 0;
+    }
 
-        auto trained = openzl::training::train(multiInputs, baseCompressor, params);
+    std::string typeName = requireMessageType(env, messageType);
+    if (env->ExceptionCheck()) {
+        return 0;
+    }
+    if (!DescriptorRegistry::instance().hasType(typeName)) {
+        throwIllegalArgument(env, "Unknown protobuf message type: " + typeName);
+        return 0;
+    }
 
-        jclass byteArrClass = env->FindClass("[B");
-        if (!byteArrClass) {
-            return nullptr;
-        }
-        jobjectArray out = env->NewObjectArray(static_cast<jsize>(trained.size()), byteArrClass, nullptr);
-        if (out == nullptr) {
-            return nullptr;
-        }
-        for (size_t i = 0; i < trained.size(); ++i) {
-            const std::string_view& sv = *trained[i];
-            jbyteArray elem = env->NewByteArray(static_cast<jsize>(sv.size()));
-            if (elem == nullptr) {
-                return nullptr;
-            }
-            if (!sv.empty()) {
-                env->SetByteArrayRegion(elem, 0, static_cast<jsize>(sv.size()), reinterpret_cast<const jbyte*>(sv.data()));
-            }
-            env->SetObjectArrayElement(out, static_cast<jsize>(i), elem);
-            env->DeleteLocalRef(elem);
+    try {
+        auto set = structuredTrainingSet(env, samples, typeName);
+        if (set == nullptr) {
+            return 0;
         }
-        return out;
+        auto params = makeTrainParams(maxTimeSecs, threads, numSamples, pareto);
+        auto job = std::make_unique<TrainingJob>();
+        job->train = [set, params](const CandidateHook& onCandidate) {
+            return trainStructured(*set, params, onCandidate);
+        };
+        return trainingJobHandle(std::move(job));
     } catch (const std::exception& ex) {
         throwIllegalState(env, ex.what());
-        return nullptr;
+        return 0;
     }
 }
 
@@ -2528,22 +2739,15 @@ extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLProtobuf_c
         return nullptr;
     }
 
-    JNICriticalArray raw(env, payload);
-    if (!raw) {
-        throwNew(env, JniRefs().outOfMemoryError, "Failed to access payload contents");
-        return nullptr;
-    }
-    
     std::string input;
     try {
-        input.assign(reinterpret_cast<const char*>(static_cast<const jbyte*>(raw.get()) + offset), static_cast<size_t>(length));
+        input.resize(static_cast<size_t>(length));
     } catch (const std::exception& ex) {
         throwIllegalState(env, ex.what());
         return nullptr;
     }
-    raw.release();
-    if (env->ExceptionCheck()) {
-        return nullptr;
+    if (length > 0) {
+        env->GetByteArrayRegion(payload, offset, length, reinterpret_cast<jbyte*>(&input[0]));
     }
 
     try {
@@ -2593,88 +2797,63 @@ extern "C" JNIEXPORT jobjectArray JNICALL Java_io_github_hybledav_OpenZLProtobuf
     }
 
     try {
-        openzl::protobuf::ProtoSerializer serializer;
-        openzl::protobuf::ProtoDeserializer deserializer;
-        std::vector<openzl::training::MultiInput> multiInputs;
-        multiInputs.reserve(static_cast<size_t>(count));
-
-        for (jsize idx = 0; idx < count; ++idx) {
-            auto sample = static_cast<jbyteArray>(env->GetObjectArrayElement(samples, idx));
-            if (sample == nullptr) {
-                throwNew(env, JniRefs().nullPointerException, "samples element");
-                return nullptr;
-            }
-            std::string payload = copyArray(env, sample);
-            env->DeleteLocalRef(sample);
-
-            google::protobuf::Message& message = reusableMessage(typeName);
-            parseIntoMessage(env, inProto, payload, message, deserializer);
-            if (env->ExceptionCheck()) {
-                return nullptr;
-            }
-
-            auto trainingInputs = serializer.getTrainingInputs(message);
-            openzl::training::MultiInput multi;
-            for (auto& input : trainingInputs) {
-                multi.add(std::move(input));
-            }
-            multiInputs.emplace_back(std::move(multi));
+        auto set = protobufTrainingSet(env, samples, inProto, typeName);
+        if (set == nullptr) {
+            return nullptr;
         }
+        return toByteArrays(env,
+                trainProtobuf(*set, makeTrainParams(maxTimeSecs, threads, numSamples, pareto), nullptr));
+    } catch (const std::exception& ex) {
+        throwIllegalState(env, ex.what());
+        return nullptr;
+    }
+}
 
-        openzl::training::TrainParams params;
-        if (threads > 0) {
-            params.threads = static_cast<uint32_t>(threads);
-        }
-        if (numSamples > 0) {
-            params.numSamples = static_cast<size_t>(numSamples);
-        }
-        if (maxTimeSecs > 0) {
-            params.maxTimeSecs = static_cast<size_t>(maxTimeSecs);
-        }
-        params.paretoFrontier = pareto != JNI_FALSE;
-        params.compressorGenFunc = [](openzl::poly::string_view serialized) {
-            auto up = std::make_unique<openzl::Compressor>();
-            try {
-                ZL_GraphID gid = openzl::protobuf::ZL_Protobuf_registerGraph(up->get());
-                up->selectStartingGraph(gid);
-            } catch (...) {
-            }
-            up->deserialize(serialized);
-            return up;
-        };
+// Parses the samples into a training job and returns its handle; OpenZLTrainingJob runs it.
+extern "C" JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLProtobuf_createTrainingJobNative(
+        JNIEnv* env,
+        jclass,
+        jobjectArray samples,
+        jint inputProtocol,
+        jint maxTimeSecs,
+        jint threads,
+        jint numSamples,
+        jboolean pareto,
+        jstring messageType)
+{
+    if (samples == nullptr) {
+        throwNew(env, JniRefs().nullPointerException, "samples");
+        return 0;
+    }
+    if (env->GetArrayLength(samples) == 0) {
+        throwIllegalArgument(env, "samples must not be empty");
+        return 0;
+    }
 
-        auto trained = openzl::training::train(
-                multiInputs, *serializer.getCompressor(), params);
+    Protocol inProto = parseProtocol(env, inputProtocol);
+    if (env->ExceptionCheck()) {
+        return 0;
+    }
 
-        jclass byteArrClass = env->FindClass("[B");
-        if (!byteArrClass) {
-            return nullptr;
-        }
-        jobjectArray out = env->NewObjectArray(
-                static_cast<jsize>(trained.size()), byteArrClass, nullptr);
-        if (out == nullptr) {
-            return nullptr;
-        }
-        for (size_t i = 0; i < trained.size(); ++i) {
-            const std::string_view& sv = *trained[i];
-            jbyteArray elem = env->NewByteArray(static_cast<jsize>(sv.size()));
-            if (elem == nullptr) {
-                return nullptr;
-            }
-            if (!sv.empty()) {
-                env->SetByteArrayRegion(
-                        elem,
-                        0,
-                        static_cast<jsize>(sv.size()),
-                        reinterpret_cast<const jbyte*>(sv.data()));
-            }
-            env->SetObjectArrayElement(out, static_cast<jsize>(i), elem);
-            env->DeleteLocalRef(elem);
+    std::string typeName = requireMessageType(env, messageType);
+    if (env->ExceptionCheck()) {
+        return 0;
+    }
+
+    try {
+        auto set = protobufTrainingSet(env, samples, inProto, typeName);
+        if (set == nullptr) {
+            return 0;
         }
-        return out;
+        auto params = makeTrainParams(maxTimeSecs, threads, numSamples, pareto);
+        auto job = std::make_unique<TrainingJob>();
+        job->train = [set, params](const CandidateHook& onCandidate) {
+            return trainProtobuf(*set, params, onCandidate);
+        };
+        return trainingJobHandle(std::move(job));
     } catch (const std::exception& ex) {
         throwIllegalState(env, ex.what());
-        return nullptr;
+        return 0;
     }
 }
 
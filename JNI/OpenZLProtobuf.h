@@ -17,6 +17,7 @@ JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLProtobuf_convertDirectIntoN
         jobject, jint, jint, jint, jbyteArray, jstring, jobject, jint, jint);
 JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLProtobuf_directIntoProfileNative(JNIEnv*, jclass);
 JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLProtobuf_structuredProfileNative(JNIEnv*, jclass);
+JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLProtobuf_autoTrainingStatusNative(JNIEnv*, jclass);
 JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLStructuredProtoBridge_compressStructuredNative(JNIEnv*, jclass,
         jobject, jbyteArray, jstring);
 JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLStructuredProtoBridge_compressStructuredIntoNative(JNIEnv*, jclass,
@@ -25,10 +26,14 @@ JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLStructuredProtoBridge
         jbyteArray, jstring);
 JNIEXPORT jobjectArray JNICALL Java_io_github_hybledav_OpenZLStructuredProtoBridge_trainStructuredNative(JNIEnv*, jclass,
         jobjectArray, jint, jint, jint, jboolean, jstring);
+JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLStructuredProtoBridge_createStructuredTrainingJobNative(JNIEnv*, jclass,
+        jobjectArray, jint, jint, jint, jboolean, jstring);
 JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLStructuredProtoBridge_compressStructuredSampleNative(JNIEnv*, jclass,
         jbyteArray, jbyteArray, jstring);
 JNIEXPORT jobjectArray JNICALL Java_io_github_hybledav_OpenZLProtobuf_trainNative(JNIEnv*, jclass,
         jobjectArray, jint, jint, jint, jint, jboolean, jstring);
+JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLProtobuf_createTrainingJobNative(JNIEnv*, jclass,
+        jobjectArray, jint, jint, jint, jint, jboolean, jstring);
 JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLProtobuf_configureTrainingNative(JNIEnv*, jclass,
         jstring, jint);
 JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLProtobuf_registerSchemaNative(JNIEnv*, jclass,
@@ -0,0 +1,193 @@
+#include "OpenZLTraining.h"
+#include "OpenZLNativeSupport.h"
+
+#include <cmath>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+// Ratios are estimated on a small prefix of the samples for one candidate in every
+// kRatioSampleInterval, so that progress reporting stays cheap next to the trainer's own work.
+constexpr size_t kRatioSampleBytes = 64u << 10;
+constexpr uint64_t kRatioSampleInterval = 16;
+
+// Thrown from the candidate hook to unwind the trainer once a job is cancelled, only on the
+// thread that runs the job.
+struct TrainingCancelled : std::exception {
+    const char* what() const noexcept override { return "Training job was cancelled"; }
+};
+
+void raiseBestRatio(std::atomic<double>& best, double ratio)
+{
+    if (std::isnan(ratio)) {
+        return;
+    }
+    double current = best.load(std::memory_order_relaxed);
+    while ((std::isnan(current) || ratio > current)
+            && !best.compare_exchange_weak(current, ratio, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+void CandidateFailure::record(const char* what)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (message.empty()) {
+        message = what[0] != '\0' ? what : "unknown error";
+    }
+}
+
+void CandidateFailure::rethrow(const std::string& context)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!message.empty()) {
+        throw std::runtime_error(context + ": " + message);
+    }
+}
+
+openzl::training::TrainParams makeTrainParams(jint maxTimeSecs, jint threads, jint numSamples, jboolean pareto)
+{
+    openzl::training::TrainParams params;
+    if (threads > 0) {
+        params.threads = static_cast<uint32_t>(threads);
+    }
+    if (numSamples > 0) {
+        params.numSamples = static_cast<size_t>(numSamples);
+    }
+    if (maxTimeSecs > 0) {
+        params.maxTimeSecs = static_cast<size_t>(maxTimeSecs);
+    }
+    params.paretoFrontier = pareto != JNI_FALSE;
+    return params;
+}
+
+jobjectArray toByteArrays(JNIEnv* env, const std::vector<std::string>& blobs)
+{
+    jclass byteArrClass = env->FindClass("[B");
+    if (!byteArrClass) {
+        return nullptr;
+    }
+    jobjectArray out = env->NewObjectArray(static_cast<jsize>(blobs.size()), byteArrClass, nullptr);
+    if (out == nullptr) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < blobs.size(); ++i) {
+        jbyteArray ba = env->NewByteArray(static_cast<jsize>(blobs[i].size()));
+        if (ba == nullptr) {
+            return nullptr;
+        }
+        if (!blobs[i].empty()) {
+            env->SetByteArrayRegion(ba, 0, static_cast<jsize>(blobs[i].size()), reinterpret_cast<const jbyte*>(blobs[i].data()));
+        }
+        env->SetObjectArrayElement(out, static_cast<jsize>(i), ba);
+        env->DeleteLocalRef(ba);
+    }
+    return out;
+}
+
+// Each thread keeps one context and output buffer for its candidates.
+double candidateRatio(openzl::Compressor& candidate, const std::vector<std::string>& samples)
+{
+    thread_local std::unique_ptr<ZL_CCtx, decltype(&ZL_CCtx_free)> cctx(nullptr, &ZL_CCtx_free);
+    thread_local NativeState::ScratchBuffer scratch;
+    if (!cctx) {
+        cctx.reset(ZL_CCtx_create());
+        if (!cctx
+                || ZL_isError(ZL_CCtx_setParameter(cctx.get(), ZL_CParam_stickyParameters, 1))
+                || ZL_isError(ZL_CCtx_setParameter(cctx.get(), ZL_CParam_formatVersion, ZL_getDefaultEncodingVersion()))) {
+            cctx.reset();
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+    if (ZL_isError(ZL_CCtx_refCompressor(cctx.get(), candidate.get()))) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    size_t original = 0;
+    size_t compressed = 0;
+    for (const auto& sample : samples) {
+        if (original >= kRatioSampleBytes) {
+            break;
+        }
+        size_t bound = ZL_compressBound(sample.size());
+        uint8_t* dst = scratch.ensure(bound);
+        if (dst == nullptr) {
+            break;
+        }
+        ZL_Report result = ZL_CCtx_compress(cctx.get(), dst, bound, sample.data(), sample.size());
+        if (ZL_isError(result)) {
+            continue;
+        }
+        original += sample.size();
+        compressed += ZL_RES_value(result);
+    }
+    if (compressed == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return static_cast<double>(original) / static_cast<double>(compressed);
+}
+
+TrainingJob* trainingJob(JNIEnv* env, jlong handle)
+{
+    if (handle == 0) {
+        throwIllegalState(env, "Training job has been released");
+        return nullptr;
+    }
+    return reinterpret_cast<TrainingJob*>(handle);
+}
+
+void runTrainingJob(TrainingJob& job)
+{
+    try {
+        // A job cancelled while it waited for an executor thread never starts the trainer.
+        if (job.cancelled.load(std::memory_order_relaxed)) {
+            throw TrainingCancelled();
+        }
+        const std::thread::id owner = std::this_thread::get_id();
+        auto results = job.train([&job, owner](openzl::Compressor& candidate) {
+            if (job.cancelled.load(std::memory_order_relaxed)) {
+                // The trainer's worker threads are not ours to unwind: there the hook only stops
+                // doing work, and the run ends at the next candidate built on this thread or at
+                // its time budget.
+                if (std::this_thread::get_id() == owner) {
+                    throw TrainingCancelled();
+                }
+                return;
+            }
+            uint64_t seen = job.candidates.fetch_add(1, std::memory_order_relaxed);
+            if (job.measure && seen % kRatioSampleInterval == 0) {
+                raiseBestRatio(job.bestRatio, job.measure(candidate));
+            }
+        });
+        if (job.cancelled.load(std::memory_order_relaxed)) {
+            throw TrainingCancelled();
+        }
+        {
+            std::lock_guard<std::mutex> lock(job.mutex);
+            job.results = std::move(results);
+        }
+        job.status.store(TrainingJob::SUCCEEDED, std::memory_order_release);
+    } catch (const TrainingCancelled&) {
+        job.status.store(TrainingJob::CANCELLED, std::memory_order_release);
+    } catch (const std::exception& ex) {
+        // Whatever ended a cancelled run, the job reports the cancellation.
+        if (job.cancelled.load(std::memory_order_relaxed)) {
+            job.status.store(TrainingJob::CANCELLED, std::memory_order_release);
+        } else {
+            {
+                std::lock_guard<std::mutex> lock(job.mutex);
+                job.error = ex.what();
+            }
+            job.status.store(TrainingJob::FAILED, std::memory_order_release);
+        }
+    }
+    job.elapsedNanos.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now() - job.start)
+                                   .count(),
+            std::memory_order_relaxed);
+    // The samples live in the trainer's captures and may be large.
+    job.train = nullptr;
+    job.measure = nullptr;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <jni.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "openzl/cpp/Compressor.hpp"
+#include "tools/training/train.h"
+
+// Called with every candidate compressor the trainer builds, before the trainer evaluates it.
+// It may run on the trainer's own threads, where an exception would not reach our caller.
+using CandidateHook = std::function<void(openzl::Compressor&)>;
+
+// First failure seen while building candidates, possibly on several threads. Candidate builders
+// record failures here instead of throwing, and the caller reports them once the trainer returns.
+struct CandidateFailure {
+    std::mutex mutex;
+    std::string message;
+
+    void record(const char* what);
+    // Throws std::runtime_error prefixed with `context` when a failure was recorded.
+    void rethrow(const std::string& context);
+};
+
+openzl::training::TrainParams makeTrainParams(jint maxTimeSecs, jint threads, jint numSamples, jboolean pareto);
+
+// Copies the trainer's output, which points into the trainer's own storage.
+template <typename Trained>
+std::vector<std::string> serializedCandidates(const Trained& trained)
+{
+    std::vector<std::string> serialized;
+    serialized.reserve(trained.size());
+    for (const auto& candidate : trained) {
+        serialized.emplace_back(candidate->data(), candidate->size());
+    }
+    return serialized;
+}
+
+jobjectArray toByteArrays(JNIEnv* env, const std::vector<std::string>& blobs);
+
+// Compression ratio of `candidate` over a small prefix of serial samples; NaN when no sample
+// compresses.
+double candidateRatio(openzl::Compressor& candidate, const std::vector<std::string>& samples);
+
+// A training run behind an OpenZLTrainingJob handle. The Java job runs it on one of its bounded
+// executor threads, so no native thread ever calls back into the VM.
+struct TrainingJob {
+    enum Status : jlong { RUNNING = 0, SUCCEEDED = 1, FAILED = 2, CANCELLED = 3 };
+
+    // Runs the trainer with the hook installed on every candidate and returns the serialized
+    // candidates. It owns the samples, which are released once the job ends.
+    std::function<std::vector<std::string>(const CandidateHook&)> train;
+    // Estimates a candidate's compression ratio, NaN when it cannot. Jobs whose candidates take
+    // structured inputs leave it empty and report no ratio.
+    std::function<double(openzl::Compressor&)> measure;
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    std::atomic<jlong> status{ RUNNING };
+    std::atomic<bool> cancelled{ false };
+    std::atomic<uint64_t> candidates{ 0 };
+    std::atomic<int64_t> elapsedNanos{ -1 };
+    std::atomic<double> bestRatio{ std::numeric_limits<double>::quiet_NaN() };
+
+    std::mutex mutex;
+    std::vector<std::string> results;
+    std::string error;
+};
+
+inline jlong trainingJobHandle(std::unique_ptr<TrainingJob> job)
+{
+    return reinterpret_cast<jlong>(job.release());
+}
+
+// Throws IllegalStateException and returns null for a released handle.
+TrainingJob* trainingJob(JNIEnv* env, jlong handle);
+// Runs the job to completion on the calling thread and records its outcome.
+void runTrainingJob(TrainingJob& job);
@@ -0,0 +1,173 @@
+#include "OpenZLUtf8.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define OPENZL_JNI_UTF8_SSE2 1
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define OPENZL_JNI_UTF8_NEON 1
+#endif
+
+namespace {
+
+constexpr uint16_t REPLACEMENT = 0xFFFD;
+
+// Encodes the leading run of ASCII units eight at a time and returns how many were consumed.
+size_t encodeAsciiRun(const uint16_t* src, size_t length, uint8_t* dst)
+{
+    size_t i = 0;
+#if defined(OPENZL_JNI_UTF8_SSE2)
+    const __m128i highBits = _mm_set1_epi16(static_cast<short>(0xFF80));
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 8 <= length; i += 8) {
+        __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i high = _mm_cmpeq_epi16(_mm_and_si128(units, highBits), zero);
+        if (_mm_movemask_epi8(high) != 0xFFFF) {
+            break;
+        }
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(units, units));
+    }
+#elif defined(OPENZL_JNI_UTF8_NEON)
+    for (; i + 8 <= length; i += 8) {
+        uint16x8_t units = vld1q_u16(src + i);
+        if (vmaxvq_u16(units) >= 0x80) {
+            break;
+        }
+        vst1_u8(dst + i, vmovn_u16(units));
+    }
+#endif
+    for (; i < length && src[i] < 0x80; ++i) {
+        dst[i] = static_cast<uint8_t>(src[i]);
+    }
+    return i;
+}
+
+// Decodes the leading run of ASCII bytes sixteen at a time and returns how many were consumed.
+size_t decodeAsciiRun(const uint8_t* src, size_t length, uint16_t* dst)
+{
+    size_t i = 0;
+#if defined(OPENZL_JNI_UTF8_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 16 <= length; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        if (_mm_movemask_epi8(bytes) != 0) {
+            break;
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi8(bytes, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_unpackhi_epi8(bytes, zero));
+    }
+#elif defined(OPENZL_JNI_UTF8_NEON)
+    for (; i + 16 <= length; i += 16) {
+        uint8x16_t bytes = vld1q_u8(src + i);
+        if (vmaxvq_u8(bytes) >= 0x80) {
+            break;
+        }
+        vst1q_u16(dst + i, vmovl_u8(vget_low_u8(bytes)));
+        vst1q_u16(dst + i + 8, vmovl_u8(vget_high_u8(bytes)));
+    }
+#endif
+    for (; i < length && src[i] < 0x80; ++i) {
+        dst[i] = src[i];
+    }
+    return i;
+}
+
+inline bool isContinuation(uint8_t byte)
+{
+    return (byte & 0xC0) == 0x80;
+}
+
+} // namespace
+
+size_t utf16ToUtf8(const uint16_t* src, size_t length, uint8_t* dst)
+{
+    size_t in = 0;
+    size_t out = 0;
+    while (in < length) {
+        size_t ascii = encodeAsciiRun(src + in, length - in, dst + out);
+        in += ascii;
+        out += ascii;
+        // Handle the non-ASCII stretch unit by unit until ASCII resumes.
+        while (in < length && src[in] >= 0x80) {
+            uint32_t unit = src[in++];
+            if (unit < 0x800) {
+                dst[out++] = static_cast<uint8_t>(0xC0 | (unit >> 6));
+                dst[out++] = static_cast<uint8_t>(0x80 | (unit & 0x3F));
+            } else if (unit < 0xD800 || unit > 0xDFFF) {
+                dst[out++] = static_cast<uint8_t>(0xE0 | (unit >> 12));
+                dst[out++] = static_cast<uint8_t>(0x80 | ((unit >> 6) & 0x3F));
+                dst[out++] = static_cast<uint8_t>(0x80 | (unit & 0x3F));
+            } else if (unit <= 0xDBFF && in < length && src[in] >= 0xDC00 && src[in] <= 0xDFFF) {
+                uint32_t codePoint = 0x10000 + ((unit - 0xD800) << 10) + (src[in++] - 0xDC00);
+                dst[out++] = static_cast<uint8_t>(0xF0 | (codePoint >> 18));
+                dst[out++] = static_cast<uint8_t>(0x80 | ((codePoint >> 12) & 0x3F));
+                dst[out++] = static_cast<uint8_t>(0x80 | ((codePoint >> 6) & 0x3F));
+                dst[out++] = static_cast<uint8_t>(0x80 | (codePoint & 0x3F));
+            } else {
+                dst[out++] = '?';
+            }
+        }
+    }
+    return out;
+}
+
+size_t utf8ToUtf16(const uint8_t* src, size_t length, uint16_t* dst)
+{
+    size_t in = 0;
+    size_t out = 0;
+    while (in < length) {
+        size_t ascii = decodeAsciiRun(src + in, length - in, dst + out);
+        in += ascii;
+        out += ascii;
+        while (in < length && src[in] >= 0x80) {
+            uint8_t lead = src[in];
+            size_t remaining = length - in;
+            // Bounds for the second byte exclude overlong forms, surrogates and values past
+            // U+10FFFF; later bytes are plain continuations.
+            size_t need = 0;
+            uint8_t low = 0x80;
+            uint8_t high = 0xBF;
+            uint32_t codePoint = 0;
+            if (lead >= 0xC2 && lead <= 0xDF) {
+                need = 2;
+                codePoint = lead & 0x1F;
+            } else if (lead >= 0xE0 && lead <= 0xEF) {
+                need = 3;
+                codePoint = lead & 0x0F;
+                low = lead == 0xE0 ? 0xA0 : 0x80;
+                high = lead == 0xED ? 0x9F : 0xBF;
+            } else if (lead >= 0xF0 && lead <= 0xF4) {
+                need = 4;
+                codePoint = lead & 0x07;
+                low = lead == 0xF0 ? 0x90 : 0x80;
+                high = lead == 0xF4 ? 0x8F : 0xBF;
+            }
+            size_t consumed = 1;
+            bool valid = need != 0;
+            if (valid) {
+                if (remaining < 2 || src[in + 1] < low || src[in + 1] > high) {
+                    valid = false;
+                } else {
+                    codePoint = (codePoint << 6) | (src[in + 1] & 0x3F);
+                    consumed = 2;
+                    while (consumed < need && consumed < remaining && isContinuation(src[in + consumed])) {
+                        codePoint = (codePoint << 6) | (src[in + consumed] & 0x3F);
+                        ++consumed;
+                    }
+                    valid = consumed == need;
+                }
+            }
+            in += consumed;
+            if (!valid) {
+                dst[out++] = REPLACEMENT;
+            } else if (codePoint < 0x10000) {
+                dst[out++] = static_cast<uint16_t>(codePoint);
+            } else {
+                codePoint -= 0x10000;
+                dst[out++] = static_cast<uint16_t>(0xD800 + (codePoint >> 10));
+                dst[out++] = static_cast<uint16_t>(0xDC00 + (codePoint & 0x3FF));
+            }
+        }
+    }
+    return out;
+}
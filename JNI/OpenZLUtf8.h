@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Worst case UTF-8 size of `length` UTF-16 code units: three bytes per unit, since a surrogate
+// pair (two units) needs only four.
+constexpr size_t maxUtf8Length(size_t utf16Length)
+{
+    return utf16Length * 3;
+}
+
+// Encodes UTF-16 as UTF-8 and returns the number of bytes written. Unpaired surrogates become
+// '?', matching String.getBytes(StandardCharsets.UTF_8).
+size_t utf16ToUtf8(const uint16_t* src, size_t length, uint8_t* dst);
+
+// Decodes UTF-8 into UTF-16 and returns the number of code units written, never more than
+// `length`. Each maximal ill-formed subsequence becomes U+FFFD, as new String(bytes, UTF_8) does.
+size_t utf8ToUtf16(const uint8_t* src, size_t length, uint16_t* dst);
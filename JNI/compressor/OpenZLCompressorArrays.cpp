@@ -1,10 +1,175 @@
 #include "OpenZLCompressor.h"
 #include "OpenZLNativeSupport.h"
+#include "OpenZLUtf8.h"
 #include "openzl/zl_compress.h"
 #include "openzl/zl_decompress.h"
-#include <cstdio>
+#include <algorithm>
 #include <limits>
 
+namespace {
+
+// Copies `length` bytes of `array` into the state's input scratch so the OpenZL call can run
+// without pinning the array. Returns null after raising OutOfMemoryError.
+const uint8_t* copyIn(JNIEnv* env, NativeState* state, jbyteArray array, jint offset, jint length)
+{
+    uint8_t* bytes = state->inputScratch.ensure(static_cast<size_t>(length));
+    if (bytes == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+        return nullptr;
+    }
+    if (length > 0) {
+        env->GetByteArrayRegion(array, offset, length, reinterpret_cast<jbyte*>(bytes));
+    }
+    return bytes;
+}
+
+jbyteArray copyOutNewArray(JNIEnv* env, const uint8_t* bytes, size_t size)
+{
+    jbyteArray result = env->NewByteArray(static_cast<jsize>(size));
+    if (result != nullptr && size > 0) {
+        env->SetByteArrayRegion(result, 0, static_cast<jsize>(size), reinterpret_cast<const jbyte*>(bytes));
+    }
+    return result;
+}
+
+// Decodes a whole byte[] frame into the output scratch, copying the source first when it reaches
+// the pinning threshold. Returns false after recording the failure or raising an exception.
+bool decompressToScratch(JNIEnv* env, NativeState* state, jbyteArray input, const char* op)
+{
+    jsize len = env->GetArrayLength(input);
+    if (static_cast<size_t>(len) >= pinningThreshold()) {
+        const uint8_t* srcBytes = copyIn(env, state, input, 0, len);
+        if (srcBytes == nullptr) {
+            return false;
+        }
+        ZL_Report sizeReport = ZL_getDecompressedSize(srcBytes, static_cast<size_t>(len));
+        if (ZL_isError(sizeReport)) {
+            recordError(state, op, static_cast<int>(ZL_RES_code(sizeReport)), nullptr);
+            return false;
+        }
+        size_t outCap = ZL_RES_value(sizeReport);
+        uint8_t* dstPtr = state->outputScratch.ensure(outCap);
+        if (dstPtr == nullptr) {
+            throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+            return false;
+        }
+        ZL_Report result = ZL_DCtx_decompress(state->dctx, dstPtr, outCap, srcBytes, static_cast<size_t>(len));
+        if (ZL_isError(result)) {
+            recordDecompressError(state, op, result);
+            return false;
+        }
+        state->outputScratch.setSize(ZL_RES_value(result));
+        return true;
+    }
+
+    void* srcPtr = env->GetPrimitiveArrayCritical(input, nullptr);
+    if (srcPtr == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "GetPrimitiveArrayCritical returned null");
+        return false;
+    }
+    CriticalRegionTimer critical;
+
+    ZL_Report sizeReport = ZL_getDecompressedSize(srcPtr,
+            static_cast<size_t>(len));
+    if (ZL_isError(sizeReport)) {
+        env->ReleasePrimitiveArrayCritical(input, srcPtr, JNI_ABORT);
+        critical.stop();
+        recordError(state, op, static_cast<int>(ZL_RES_code(sizeReport)), nullptr);
+        return false;
+    }
+
+    size_t outCap = ZL_RES_value(sizeReport);
+    uint8_t* dstPtr = state->outputScratch.ensure(outCap);
+    if (dstPtr == nullptr) {
+        env->ReleasePrimitiveArrayCritical(input, srcPtr, JNI_ABORT);
+        critical.stop();
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+        return false;
+    }
+
+    ZL_Report result = ZL_DCtx_decompress(state->dctx,
+            dstPtr,
+            outCap,
+            srcPtr,
+            static_cast<size_t>(len));
+
+    env->ReleasePrimitiveArrayCritical(input, srcPtr, JNI_ABORT);
+    critical.stop();
+
+    if (ZL_isError(result)) {
+        recordDecompressError(state, op, result);
+        return false;
+    }
+
+    state->outputScratch.setSize(ZL_RES_value(result));
+    return true;
+}
+
+jint compressIntoCopying(JNIEnv* env,
+        NativeState* state,
+        jbyteArray src,
+        jint srcOff,
+        jint srcLen,
+        jbyteArray dst,
+        jint dstOff,
+        jint dstLen)
+{
+    const uint8_t* srcBytes = copyIn(env, state, src, srcOff, srcLen);
+    if (srcBytes == nullptr) {
+        return -1;
+    }
+    // Capacity beyond the bound is never used, and a smaller one keeps the too-small error.
+    size_t capacity = std::min(static_cast<size_t>(dstLen), ZL_compressBound(static_cast<size_t>(srcLen)));
+    uint8_t* dstBytes = state->outputScratch.ensure(capacity);
+    if (dstBytes == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+        return -1;
+    }
+    ZL_Report result = ZL_CCtx_compress(state->cctx, dstBytes, capacity, srcBytes, static_cast<size_t>(srcLen));
+    if (ZL_isError(result)) {
+        recordCompressError(state, "compressInto", result);
+        return -1;
+    }
+    size_t written = ZL_RES_value(result);
+    env->SetByteArrayRegion(dst, dstOff, static_cast<jsize>(written), reinterpret_cast<const jbyte*>(dstBytes));
+    return static_cast<jint>(written);
+}
+
+jint decompressIntoCopying(JNIEnv* env,
+        NativeState* state,
+        jbyteArray src,
+        jint srcOff,
+        jint srcLen,
+        jbyteArray dst,
+        jint dstOff,
+        jint dstLen)
+{
+    const uint8_t* srcBytes = copyIn(env, state, src, srcOff, srcLen);
+    if (srcBytes == nullptr) {
+        return -1;
+    }
+    size_t capacity = static_cast<size_t>(dstLen);
+    ZL_Report sizeReport = ZL_getDecompressedSize(srcBytes, static_cast<size_t>(srcLen));
+    if (!ZL_isError(sizeReport)) {
+        capacity = std::min(capacity, ZL_RES_value(sizeReport));
+    }
+    uint8_t* dstBytes = state->outputScratch.ensure(capacity);
+    if (dstBytes == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+        return -1;
+    }
+    ZL_Report result = ZL_DCtx_decompress(state->dctx, dstBytes, capacity, srcBytes, static_cast<size_t>(srcLen));
+    if (ZL_isError(result)) {
+        recordDecompressError(state, "decompressInto", result);
+        return -1;
+    }
+    size_t written = ZL_RES_value(result);
+    env->SetByteArrayRegion(dst, dstOff, static_cast<jsize>(written), reinterpret_cast<const jbyte*>(dstBytes));
+    return static_cast<jint>(written);
+}
+
+} // namespace
+
 extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compressIntoNative(JNIEnv* env,
         jobject obj,
         jbyteArray src,
@@ -24,12 +189,16 @@ extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compr
     if (!checkArrayRange(env, dst, dstOff, dstLen, "dst")) {
         return -1;
     }
+    if (static_cast<size_t>(srcLen) >= pinningThreshold()) {
+        return compressIntoCopying(env, state, src, srcOff, srcLen, dst, dstOff, dstLen);
+    }
 
     void* srcPtr = env->GetPrimitiveArrayCritical(src, nullptr);
     if (srcPtr == nullptr) {
         throwNew(env, JniRefs().outOfMemoryError, "Failed to access source array");
         return -1;
     }
+    CriticalRegionTimer critical;
     void* dstPtr = env->GetPrimitiveArrayCritical(dst, nullptr);
     if (dstPtr == nullptr) {
         env->ReleasePrimitiveArrayCritical(src, srcPtr, JNI_ABORT);
@@ -50,16 +219,13 @@ extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compr
 
     if (ZL_isError(result)) {
         env->ReleasePrimitiveArrayCritical(dst, dstPtr, JNI_ABORT);
-        std::fprintf(stderr, "ZL_CCtx_compress failed: error code %ld\n",
-                (long)ZL_RES_code(result));
-        const char* context = ZL_CCtx_getErrorContextString(state->cctx, result);
-        if (context != nullptr) {
-            std::fprintf(stderr, "ZL_CCtx_compress context: %s\n", context);
-        }
+        critical.stop();
+        recordCompressError(state, "compressInto", result);
         return -1;
     }
 
     env->ReleasePrimitiveArrayCritical(dst, dstPtr, 0);
+    critical.stop();
     return static_cast<jint>(ZL_RES_value(result));
 }
 
@@ -76,41 +242,43 @@ extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor
     }
 
     jsize len = env->GetArrayLength(input);
-    void* srcPtr = env->GetPrimitiveArrayCritical(input, nullptr);
-    if (srcPtr == nullptr) {
-        throwNew(env, JniRefs().outOfMemoryError, "GetPrimitiveArrayCritical returned null");
-        return nullptr;
-    }
-
     size_t bound = ZL_compressBound(static_cast<size_t>(len));
     uint8_t* dstPtr = state->outputScratch.ensure(bound);
+    if (dstPtr == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+        return nullptr;
+    }
+    ZL_Report result;
 
-    ZL_Report result = ZL_CCtx_compress(state->cctx,
-            dstPtr,
-            bound,
-            srcPtr,
-            static_cast<size_t>(len));
-
-    env->ReleasePrimitiveArrayCritical(input, srcPtr, JNI_ABORT);
+    if (static_cast<size_t>(len) >= pinningThreshold()) {
+        const uint8_t* srcBytes = copyIn(env, state, input, 0, len);
+        if (srcBytes == nullptr) {
+            return nullptr;
+        }
+        result = ZL_CCtx_compress(state->cctx, dstPtr, bound, srcBytes, static_cast<size_t>(len));
+    } else {
+        void* srcPtr = env->GetPrimitiveArrayCritical(input, nullptr);
+        if (srcPtr == nullptr) {
+            throwNew(env, JniRefs().outOfMemoryError, "GetPrimitiveArrayCritical returned null");
+            return nullptr;
+        }
+        CriticalRegionTimer critical;
+        result = ZL_CCtx_compress(state->cctx,
+                dstPtr,
+                bound,
+                srcPtr,
+                static_cast<size_t>(len));
+        env->ReleasePrimitiveArrayCritical(input, srcPtr, JNI_ABORT);
+    }
 
     if (ZL_isError(result)) {
-        std::fprintf(stderr, "ZL_CCtx_compress failed: error code %ld\n",
-                (long)ZL_RES_code(result));
-        const char* context = ZL_CCtx_getErrorContextString(state->cctx, result);
-        if (context != nullptr) {
-            std::fprintf(stderr, "ZL_CCtx_compress context: %s\n", context);
-        }
+        recordCompressError(state, "compress", result);
         return nullptr;
     }
 
     size_t compressedSize = ZL_RES_value(result);
     state->outputScratch.setSize(compressedSize);
-    jbyteArray jresult = env->NewByteArray(static_cast<jsize>(compressedSize));
-    if (compressedSize > 0 && state->outputScratch.ptr() != nullptr) {
-        env->SetByteArrayRegion(jresult, 0, static_cast<jsize>(compressedSize),
-                reinterpret_cast<jbyte*>(state->outputScratch.ptr()));
-    }
-    return jresult;
+    return copyOutNewArray(env, state->outputScratch.ptr(), compressedSize);
 }
 
 extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_decompress(JNIEnv* env, jobject obj, jbyteArray input)
@@ -125,52 +293,83 @@ extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor
         return nullptr;
     }
 
-    jsize len = env->GetArrayLength(input);
-    void* srcPtr = env->GetPrimitiveArrayCritical(input, nullptr);
-    if (srcPtr == nullptr) {
-        throwNew(env, JniRefs().outOfMemoryError, "GetPrimitiveArrayCritical returned null");
+    if (!decompressToScratch(env, state, input, "decompress")) {
         return nullptr;
     }
+    return copyOutNewArray(env, state->outputScratch.ptr(), state->outputScratch.size);
+}
 
-    ZL_Report sizeReport = ZL_getDecompressedSize(srcPtr,
-            static_cast<size_t>(len));
-    if (ZL_isError(sizeReport)) {
-        std::fprintf(stderr,
-                "ZL_getDecompressedSize failed: error code %ld, input size %ld\n",
-                (long)ZL_RES_code(sizeReport),
-                (long)len);
-        env->ReleasePrimitiveArrayCritical(input, srcPtr, JNI_ABORT);
+extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressStringNative(JNIEnv* env, jobject obj, jstring text)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "compressString")) {
+        return nullptr;
+    }
+    if (text == nullptr) {
+        throwNew(env, JniRefs().nullPointerException, "text is null");
         return nullptr;
     }
 
-    size_t outCap = ZL_RES_value(sizeReport);
-    uint8_t* dstPtr = state->outputScratch.ensure(outCap);
-
-    ZL_Report result = ZL_DCtx_decompress(state->dctx,
-            dstPtr,
-            outCap,
-            srcPtr,
-            static_cast<size_t>(len));
-
-    env->ReleasePrimitiveArrayCritical(input, srcPtr, JNI_ABORT);
+    jsize length = env->GetStringLength(text);
+    uint8_t* utf8 = state->inputScratch.ensure(maxUtf8Length(static_cast<size_t>(length)));
+    if (utf8 == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+        return nullptr;
+    }
+    const jchar* chars = env->GetStringCritical(text, nullptr);
+    if (chars == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "GetStringCritical returned null");
+        return nullptr;
+    }
+    CriticalRegionTimer critical;
+    size_t utf8Size = utf16ToUtf8(reinterpret_cast<const uint16_t*>(chars), static_cast<size_t>(length), utf8);
+    env->ReleaseStringCritical(text, chars);
+    critical.stop();
 
+    size_t bound = ZL_compressBound(utf8Size);
+    uint8_t* dstPtr = state->outputScratch.ensure(bound);
+    if (dstPtr == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+        return nullptr;
+    }
+    ZL_Report result = ZL_CCtx_compress(state->cctx, dstPtr, bound, utf8, utf8Size);
     if (ZL_isError(result)) {
-        std::fprintf(stderr,
-                "ZL_DCtx_decompress failed: error code %ld, input size %ld, output buffer size %zu\n",
-                (long)ZL_RES_code(result),
-                (long)len,
-                outCap);
+        recordCompressError(state, "compressString", result);
         return nullptr;
     }
+    state->outputScratch.setSize(ZL_RES_value(result));
+    return copyOutNewArray(env, dstPtr, ZL_RES_value(result));
+}
 
-    size_t decompressedSize = ZL_RES_value(result);
-    state->outputScratch.setSize(decompressedSize);
-    jbyteArray jresult = env->NewByteArray(static_cast<jsize>(decompressedSize));
-    if (decompressedSize > 0 && state->outputScratch.ptr() != nullptr) {
-        env->SetByteArrayRegion(jresult, 0, static_cast<jsize>(decompressedSize),
-                reinterpret_cast<jbyte*>(state->outputScratch.ptr()));
+extern "C" JNIEXPORT jstring JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressToStringNative(JNIEnv* env,
+        jobject obj,
+        jbyteArray input)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "decompressToString")) {
+        return nullptr;
+    }
+    if (input == nullptr) {
+        throwNew(env, JniRefs().nullPointerException, "input is null");
+        return nullptr;
     }
-    return jresult;
+
+    if (!decompressToScratch(env, state, input, "decompressToString")) {
+        return nullptr;
+    }
+    size_t utf8Size = state->outputScratch.size;
+    if (utf8Size > static_cast<size_t>(std::numeric_limits<jsize>::max())) {
+        throwIllegalState(env, "Decompressed text is too large for a String");
+        return nullptr;
+    }
+    // The source frame is no longer needed, so the input scratch takes the UTF-16 form.
+    auto* utf16 = reinterpret_cast<uint16_t*>(state->inputScratch.ensure(utf8Size * sizeof(jchar)));
+    if (utf16 == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+        return nullptr;
+    }
+    size_t units = utf8ToUtf16(state->outputScratch.ptr(), utf8Size, utf16);
+    return env->NewString(reinterpret_cast<const jchar*>(utf16), static_cast<jsize>(units));
 }
 
 extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressIntoNative(JNIEnv* env,
@@ -192,12 +391,19 @@ extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decom
     if (!checkArrayRange(env, dst, dstOff, dstLen, "dst")) {
         return -1;
     }
+    // Decompression time follows the output size, so a large destination also takes the
+    // copying path.
+    size_t threshold = pinningThreshold();
+    if (static_cast<size_t>(srcLen) >= threshold || static_cast<size_t>(dstLen) >= threshold) {
+        return decompressIntoCopying(env, state, src, srcOff, srcLen, dst, dstOff, dstLen);
+    }
 
     void* srcPtr = env->GetPrimitiveArrayCritical(src, nullptr);
     if (srcPtr == nullptr) {
         throwNew(env, JniRefs().outOfMemoryError, "Failed to access source array");
         return -1;
     }
+    CriticalRegionTimer critical;
     void* dstPtr = env->GetPrimitiveArrayCritical(dst, nullptr);
     if (dstPtr == nullptr) {
         env->ReleasePrimitiveArrayCritical(src, srcPtr, JNI_ABORT);
@@ -218,18 +424,133 @@ extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decom
 
     if (ZL_isError(result)) {
         env->ReleasePrimitiveArrayCritical(dst, dstPtr, JNI_ABORT);
-        std::fprintf(stderr,
-                "ZL_DCtx_decompress failed: error code %ld, input size %ld, output buffer size %ld\n",
-                (long)ZL_RES_code(result),
-                (long)srcLen,
-                (long)dstLen);
+        critical.stop();
+        recordDecompressError(state, "decompressInto", result);
         return -1;
     }
 
     env->ReleasePrimitiveArrayCritical(dst, dstPtr, 0);
+    critical.stop();
     return static_cast<jint>(ZL_RES_value(result));
 }
 
+namespace {
+
+jint runBatchOnArrays(JNIEnv* env,
+        NativeState* state,
+        bool compress,
+        jbyteArray src,
+        jintArray srcOffsets,
+        jintArray srcLengths,
+        jbyteArray dst,
+        jint dstOff,
+        jint dstLen,
+        jintArray dstOffsets)
+{
+    if (src == nullptr) {
+        throwNew(env, JniRefs().nullPointerException, "src");
+        return -1;
+    }
+    auto& table = threadBatchTable();
+    if (!readBatchTable(env, srcOffsets, srcLengths, env->GetArrayLength(src), dstOffsets, table)) {
+        return -1;
+    }
+    if (!checkArrayRange(env, dst, dstOff, dstLen, "dst")) {
+        return -1;
+    }
+
+    jsize srcLen = env->GetArrayLength(src);
+    size_t threshold = pinningThreshold();
+    jlong written;
+    if (static_cast<size_t>(srcLen) >= threshold || static_cast<size_t>(dstLen) >= threshold) {
+        // Table offsets index the whole source array, so all of it is copied.
+        const uint8_t* srcBytes = copyIn(env, state, src, 0, srcLen);
+        if (srcBytes == nullptr) {
+            return -1;
+        }
+        uint8_t* dstBytes = state->outputScratch.ensure(static_cast<size_t>(dstLen));
+        if (dstBytes == nullptr) {
+            throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+            return -1;
+        }
+        written = compress
+                ? compressBatchFrames(state, srcBytes, table, dstBytes, static_cast<size_t>(dstLen), dstOff)
+                : decompressBatchFrames(state, srcBytes, table, dstBytes, static_cast<size_t>(dstLen), dstOff);
+        if (written > 0) {
+            env->SetByteArrayRegion(dst, dstOff, static_cast<jsize>(written), reinterpret_cast<const jbyte*>(dstBytes));
+        }
+    } else {
+        void* srcPtr = env->GetPrimitiveArrayCritical(src, nullptr);
+        if (srcPtr == nullptr) {
+            throwNew(env, JniRefs().outOfMemoryError, "Failed to access source array");
+            return -1;
+        }
+        CriticalRegionTimer critical;
+        void* dstPtr = env->GetPrimitiveArrayCritical(dst, nullptr);
+        if (dstPtr == nullptr) {
+            env->ReleasePrimitiveArrayCritical(src, srcPtr, JNI_ABORT);
+            critical.stop();
+            throwNew(env, JniRefs().outOfMemoryError, "Failed to access destination array");
+            return -1;
+        }
+
+        auto* srcBytes = static_cast<const uint8_t*>(srcPtr);
+        auto* dstBytes = static_cast<uint8_t*>(dstPtr) + dstOff;
+        written = compress
+                ? compressBatchFrames(state, srcBytes, table, dstBytes, static_cast<size_t>(dstLen), dstOff)
+                : decompressBatchFrames(state, srcBytes, table, dstBytes, static_cast<size_t>(dstLen), dstOff);
+
+        env->ReleasePrimitiveArrayCritical(src, srcPtr, JNI_ABORT);
+        env->ReleasePrimitiveArrayCritical(dst, dstPtr, written < 0 ? JNI_ABORT : 0);
+        critical.stop();
+    }
+    if (written < 0) {
+        return -1;
+    }
+
+    env->SetIntArrayRegion(dstOffsets,
+            0,
+            static_cast<jsize>(table.frameOffsets.size()),
+            table.frameOffsets.data());
+    return static_cast<jint>(written);
+}
+
+} // namespace
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compressBatchNative(JNIEnv* env,
+        jobject obj,
+        jbyteArray src,
+        jintArray srcOffsets,
+        jintArray srcLengths,
+        jbyteArray dst,
+        jint dstOff,
+        jint dstLen,
+        jintArray dstOffsets)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "compressBatch")) {
+        return -1;
+    }
+    return runBatchOnArrays(env, state, true, src, srcOffsets, srcLengths, dst, dstOff, dstLen, dstOffsets);
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressBatchNative(JNIEnv* env,
+        jobject obj,
+        jbyteArray src,
+        jintArray srcOffsets,
+        jintArray srcLengths,
+        jbyteArray dst,
+        jint dstOff,
+        jint dstLen,
+        jintArray dstOffsets)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "decompressBatch")) {
+        return -1;
+    }
+    return runBatchOnArrays(env, state, false, src, srcOffsets, srcLengths, dst, dstOff, dstLen, dstOffsets);
+}
+
 extern "C" JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_getDecompressedSizeNative(JNIEnv* env,
         jobject obj,
         jbyteArray input)
@@ -245,14 +566,16 @@ extern "C" JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_getD
     }
 
     jsize len = env->GetArrayLength(input);
-    void* ptr = env->GetPrimitiveArrayCritical(input, nullptr);
-    if (ptr == nullptr) {
+    JNICriticalArray pinned(env, input);
+    if (!pinned) {
         throwNew(env, JniRefs().outOfMemoryError, "GetPrimitiveArrayCritical returned null");
         return -1;
     }
+    CriticalRegionTimer critical;
 
-    ZL_Report sizeReport = ZL_getDecompressedSize(ptr, static_cast<size_t>(len));
-    env->ReleasePrimitiveArrayCritical(input, ptr, JNI_ABORT);
+    ZL_Report sizeReport = ZL_getDecompressedSize(pinned.get(), static_cast<size_t>(len));
+    pinned.release();
+    critical.stop();
     if (ZL_isError(sizeReport)) {
         return -1;
     }
@@ -2,7 +2,6 @@
 #include "OpenZLNativeSupport.h"
 #include "openzl/zl_compress.h"
 #include "openzl/zl_decompress.h"
-#include <cstdio>
 
 extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compressDirect(JNIEnv* env,
         jobject obj,
@@ -40,12 +39,7 @@ extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compr
             srcPtr,
             static_cast<size_t>(srcLen));
     if (ZL_isError(result)) {
-        std::fprintf(stderr, "ZL_CCtx_compress failed: error code %ld\n",
-                (long)ZL_RES_code(result));
-        const char* context = ZL_CCtx_getErrorContextString(state->cctx, result);
-        if (context != nullptr) {
-            std::fprintf(stderr, "ZL_CCtx_compress context: %s\n", context);
-        }
+        recordCompressError(state, "compressDirect", result);
         return -1;
     }
     return static_cast<jint>(ZL_RES_value(result));
@@ -87,16 +81,101 @@ extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decom
             srcPtr,
             static_cast<size_t>(srcLen));
     if (ZL_isError(result)) {
-        std::fprintf(stderr,
-                "ZL_DCtx_decompress failed: error code %ld, input size %ld, output buffer size %ld\n",
-                (long)ZL_RES_code(result),
-                (long)srcLen,
-                (long)dstLen);
+        recordDecompressError(state, "decompressDirect", result);
         return -1;
     }
     return static_cast<jint>(ZL_RES_value(result));
 }
 
+namespace {
+
+jint runBatchOnDirect(JNIEnv* env,
+        NativeState* state,
+        bool compress,
+        jobject src,
+        jint srcPos,
+        jint srcLen,
+        jintArray srcOffsets,
+        jintArray srcLengths,
+        jobject dst,
+        jint dstPos,
+        jint dstLen,
+        jintArray dstOffsets)
+{
+    if (!ensureDirectRange(env, src, srcPos, srcLen, "src")) {
+        return -1;
+    }
+    if (!ensureDirectRange(env, dst, dstPos, dstLen, "dst")) {
+        return -1;
+    }
+    auto& table = threadBatchTable();
+    if (!readBatchTable(env, srcOffsets, srcLengths, srcLen, dstOffsets, table)) {
+        return -1;
+    }
+
+    auto* srcPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(src));
+    auto* dstPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(dst));
+    if (!srcPtr || !dstPtr) {
+        return -1;
+    }
+
+    // Batch offsets are relative to the buffer positions handed over by the caller.
+    jlong written = compress
+            ? compressBatchFrames(state, srcPtr + srcPos, table, dstPtr + dstPos, static_cast<size_t>(dstLen), 0)
+            : decompressBatchFrames(state, srcPtr + srcPos, table, dstPtr + dstPos, static_cast<size_t>(dstLen), 0);
+    if (written < 0) {
+        return -1;
+    }
+
+    env->SetIntArrayRegion(dstOffsets,
+            0,
+            static_cast<jsize>(table.frameOffsets.size()),
+            table.frameOffsets.data());
+    return static_cast<jint>(written);
+}
+
+} // namespace
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compressBatchDirect(JNIEnv* env,
+        jobject obj,
+        jobject src,
+        jint srcPos,
+        jint srcLen,
+        jintArray srcOffsets,
+        jintArray srcLengths,
+        jobject dst,
+        jint dstPos,
+        jint dstLen,
+        jintArray dstOffsets)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "compressBatch")) {
+        return -1;
+    }
+    return runBatchOnDirect(env, state, true, src, srcPos, srcLen, srcOffsets, srcLengths,
+            dst, dstPos, dstLen, dstOffsets);
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressBatchDirect(JNIEnv* env,
+        jobject obj,
+        jobject src,
+        jint srcPos,
+        jint srcLen,
+        jintArray srcOffsets,
+        jintArray srcLengths,
+        jobject dst,
+        jint dstPos,
+        jint dstLen,
+        jintArray dstOffsets)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "decompressBatch")) {
+        return -1;
+    }
+    return runBatchOnDirect(env, state, false, src, srcPos, srcLen, srcOffsets, srcLengths,
+            dst, dstPos, dstLen, dstOffsets);
+}
+
 extern "C" JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_getDecompressedSizeDirect(JNIEnv* env,
         jobject obj,
         jobject src,
@@ -0,0 +1,420 @@
+#include "OpenZLCompressor.h"
+#include "OpenZLNativeSupport.h"
+#include "OpenZLParallel.h"
+#include "OpenZLUtf8.h"
+#include "openzl/zl_compress.h"
+#include "openzl/zl_decompress.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef _WIN32
+using NativePath = std::wstring;
+
+std::string lastErrorText(const char* action)
+{
+    return std::string(action) + " failed: error " + std::to_string(static_cast<unsigned long>(GetLastError()));
+}
+#else
+using NativePath = std::string;
+
+std::string lastErrorText(const char* action)
+{
+    return std::string(action) + " failed: " + std::strerror(errno);
+}
+#endif
+
+// Paths are read as UTF-16: kept as they are on Windows, encoded as standard UTF-8 elsewhere
+// (GetStringUTFChars would give modified UTF-8). An embedded NUL would silently truncate the
+// path handed to the OS, so it is rejected.
+bool readPath(JNIEnv* env, jstring path, const char* name, NativePath& out)
+{
+    if (path == nullptr) {
+        throwNew(env, JniRefs().nullPointerException, name);
+        return false;
+    }
+    size_t length = static_cast<size_t>(env->GetStringLength(path));
+    const jchar* chars = env->GetStringChars(path, nullptr);
+    if (chars == nullptr) {
+        return false;
+    }
+    if (std::find(chars, chars + length, jchar{ 0 }) != chars + length) {
+        env->ReleaseStringChars(path, chars);
+        throwIllegalArgument(env, std::string(name) + " contains a NUL character");
+        return false;
+    }
+#ifdef _WIN32
+    out.assign(reinterpret_cast<const wchar_t*>(chars), length);
+#else
+    out.resize(maxUtf8Length(length));
+    size_t written = utf16ToUtf8(reinterpret_cast<const uint16_t*>(chars), length, reinterpret_cast<uint8_t*>(&out[0]));
+    out.resize(written);
+#endif
+    env->ReleaseStringChars(path, chars);
+    return true;
+}
+
+// Read-only or read-write mapping of a whole file. Writable mappings are created at their
+// worst-case size and cut down to the bytes actually produced by finish().
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile()
+    {
+        unmap();
+        closeHandle();
+        if (writable_ && !finished_) {
+            removeFile();
+        }
+    }
+
+    // `sequential` mappings are read front to back; range reads touch scattered chunks.
+    void openRead(const NativePath& path, bool sequential = true)
+    {
+        sequential_ = sequential;
+        path_ = path;
+#ifdef _WIN32
+        file_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            throw std::runtime_error(lastErrorText("CreateFile"));
+        }
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size)) {
+            throw std::runtime_error(lastErrorText("GetFileSizeEx"));
+        }
+        size_ = static_cast<size_t>(size.QuadPart);
+#else
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        if (fd_ < 0) {
+            throw std::runtime_error(lastErrorText("open"));
+        }
+        struct stat st;
+        if (::fstat(fd_, &st) != 0) {
+            throw std::runtime_error(lastErrorText("fstat"));
+        }
+        size_ = static_cast<size_t>(st.st_size);
+#endif
+        map(false);
+    }
+
+    void createWrite(const NativePath& path, size_t size)
+    {
+        path_ = path;
+        writable_ = true;
+        size_ = size;
+#ifdef _WIN32
+        file_ = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            writable_ = false;
+            throw std::runtime_error(lastErrorText("CreateFile"));
+        }
+#else
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0) {
+            writable_ = false;
+            throw std::runtime_error(lastErrorText("open"));
+        }
+        if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+            throw std::runtime_error(lastErrorText("ftruncate"));
+        }
+#endif
+        map(true);
+    }
+
+    uint8_t* data() { return data_; }
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    void finish(size_t finalSize)
+    {
+        unmap();
+#ifdef _WIN32
+        LARGE_INTEGER end;
+        end.QuadPart = static_cast<LONGLONG>(finalSize);
+        if (!SetFilePointerEx(file_, end, nullptr, FILE_BEGIN) || !SetEndOfFile(file_)) {
+            throw std::runtime_error(lastErrorText("SetEndOfFile"));
+        }
+#else
+        if (::ftruncate(fd_, static_cast<off_t>(finalSize)) != 0) {
+            throw std::runtime_error(lastErrorText("ftruncate"));
+        }
+#endif
+        closeHandle();
+        finished_ = true;
+    }
+
+private:
+    void map(bool write)
+    {
+        if (size_ == 0) {
+            return;
+        }
+#ifdef _WIN32
+        mapping_ = CreateFileMappingW(file_, nullptr, write ? PAGE_READWRITE : PAGE_READONLY,
+                static_cast<DWORD>(static_cast<uint64_t>(size_) >> 32),
+                static_cast<DWORD>(size_ & 0xFFFFFFFFu), nullptr);
+        if (mapping_ == nullptr) {
+            throw std::runtime_error(lastErrorText("CreateFileMapping"));
+        }
+        void* view = MapViewOfFile(mapping_, write ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size_);
+        if (view == nullptr) {
+            throw std::runtime_error(lastErrorText("MapViewOfFile"));
+        }
+        data_ = static_cast<uint8_t*>(view);
+#else
+        void* view = ::mmap(nullptr, size_, write ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd_, 0);
+        if (view == MAP_FAILED) {
+            throw std::runtime_error(lastErrorText("mmap"));
+        }
+        data_ = static_cast<uint8_t*>(view);
+        if (!write) {
+            ::madvise(view, size_, sequential_ ? MADV_SEQUENTIAL : MADV_RANDOM);
+        }
+#endif
+    }
+
+    void unmap()
+    {
+        if (data_ == nullptr) {
+            return;
+        }
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+#else
+        ::munmap(data_, size_);
+#endif
+        data_ = nullptr;
+    }
+
+    void closeHandle()
+    {
+#ifdef _WIN32
+        if (file_ != INVALID_HANDLE_VALUE) {
+            CloseHandle(file_);
+            file_ = INVALID_HANDLE_VALUE;
+        }
+#else
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+#endif
+    }
+
+    void removeFile()
+    {
+#ifdef _WIN32
+        DeleteFileW(path_.c_str());
+#else
+        ::unlink(path_.c_str());
+#endif
+    }
+
+    NativePath path_;
+    uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    bool writable_ = false;
+    bool finished_ = false;
+    bool sequential_ = true;
+#ifdef _WIN32
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+};
+
+// Stand-in source for empty inputs, which cannot be mapped.
+const uint8_t kEmptyInput[1] = { 0 };
+
+const uint8_t* sourceBytes(const MappedFile& file)
+{
+    return file.size() == 0 ? kEmptyInput : file.data();
+}
+
+size_t compressFrameInto(NativeState* state, const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity)
+{
+    ZL_Report result = ZL_CCtx_compress(state->cctx, dst, dstCapacity, src, srcSize);
+    if (ZL_isError(result)) {
+        const char* context = ZL_CCtx_getErrorContextString(state->cctx, result);
+        throw std::runtime_error(std::string("ZL_CCtx_compress failed: error code ")
+                + std::to_string(static_cast<long>(ZL_RES_code(result)))
+                + (context != nullptr && context[0] != '\0' ? std::string(": ") + context : ""));
+    }
+    return ZL_RES_value(result);
+}
+
+} // namespace
+
+extern "C" JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_compressFileNative(JNIEnv* env,
+        jobject obj,
+        jstring inPath,
+        jstring outPath,
+        jlong parallelThreshold,
+        jint chunkSize,
+        jint threads)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "compressFile")) {
+        return -1;
+    }
+    if (parallelThreshold >= 0
+            && (chunkSize < static_cast<jint>(kChunkedMinChunkSize)
+                    || static_cast<size_t>(chunkSize) > kChunkedMaxChunkSize)) {
+        throwIllegalArgument(env, "chunkSize must be between 64 KiB and 1 GiB");
+        return -1;
+    }
+    NativePath in;
+    NativePath out;
+    if (!readPath(env, inPath, "in", in) || !readPath(env, outPath, "out", out)) {
+        return -1;
+    }
+
+    try {
+        MappedFile source;
+        source.openRead(in);
+        bool chunked = parallelThreshold >= 0 && source.size() >= static_cast<uint64_t>(parallelThreshold);
+        size_t bound = chunked
+                ? chunkedContainerBound(source.size(), static_cast<size_t>(chunkSize))
+                : ZL_compressBound(source.size());
+
+        MappedFile target;
+        target.createWrite(out, bound);
+        size_t written = chunked
+                ? compressChunkedContainer(state, source.data(), source.size(), target.data(), bound,
+                        static_cast<size_t>(chunkSize), threads)
+                : compressFrameInto(state, sourceBytes(source), source.size(), target.data(), bound);
+        target.finish(written);
+        return static_cast<jlong>(written);
+    } catch (const std::exception& ex) {
+        throwIOException(env, std::string("compressFile: ") + ex.what());
+    }
+    return -1;
+}
+
+extern "C" JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressFileNative(JNIEnv* env,
+        jobject obj,
+        jstring inPath,
+        jstring outPath,
+        jint threads)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "decompressFile")) {
+        return -1;
+    }
+    NativePath in;
+    NativePath out;
+    if (!readPath(env, inPath, "in", in) || !readPath(env, outPath, "out", out)) {
+        return -1;
+    }
+
+    try {
+        MappedFile source;
+        source.openRead(in);
+        const uint8_t* src = sourceBytes(source);
+
+        ChunkedLayout layout;
+        std::string error;
+        bool chunked = source.size() >= 4 && readLE32(src) == kChunkedMagic;
+        if (chunked && !parseChunkedContainer(src, source.size(), layout, error)) {
+            throw std::runtime_error(error);
+        }
+        size_t contentSize = layout.contentSize;
+        if (!chunked) {
+            ZL_Report sizeReport = ZL_getDecompressedSize(src, source.size());
+            if (ZL_isError(sizeReport)) {
+                throw std::runtime_error("ZL_getDecompressedSize failed: error code "
+                        + std::to_string(static_cast<long>(ZL_RES_code(sizeReport))));
+            }
+            contentSize = ZL_RES_value(sizeReport);
+        }
+
+        MappedFile target;
+        target.createWrite(out, contentSize);
+        if (chunked) {
+            decompressChunkedContainer(state, layout, src, target.data(), contentSize, threads, 0);
+        } else if (contentSize > 0) {
+            ZL_Report result = ZL_DCtx_decompress(state->dctx, target.data(), contentSize, src, source.size());
+            if (ZL_isError(result) || ZL_RES_value(result) != contentSize) {
+                throw std::runtime_error("ZL_DCtx_decompress failed: error code "
+                        + std::to_string(static_cast<long>(ZL_isError(result) ? ZL_RES_code(result) : 0)));
+            }
+        }
+        target.finish(contentSize);
+        return static_cast<jlong>(contentSize);
+    } catch (const std::exception& ex) {
+        throwIOException(env, std::string("decompressFile: ") + ex.what());
+    }
+    return -1;
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressRangeFileNative(JNIEnv* env,
+        jobject obj,
+        jstring inPath,
+        jlong offset,
+        jint length,
+        jobject dst,
+        jint dstPos,
+        jint dstLen,
+        jint threads)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "decompressRange")) {
+        return -1;
+    }
+    if (!ensureDirectRange(env, dst, dstPos, dstLen, "dst")) {
+        return -1;
+    }
+    if (offset < 0 || length < 0) {
+        throwIllegalArgument(env, "offset and length must be non-negative");
+        return -1;
+    }
+    auto* dstPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(dst));
+    NativePath in;
+    if (dstPtr == nullptr || !readPath(env, inPath, "container", in)) {
+        return -1;
+    }
+
+    // The mapping is addressed with size_t, so containers are not limited to the 2 GiB a
+    // ByteBuffer can span. Each call maps the file afresh, so the chunk table is parsed every
+    // time rather than cached by address.
+    MappedFile source;
+    try {
+        source.openRead(in, false);
+    } catch (const std::exception& ex) {
+        throwIOException(env, std::string("decompressRange: ") + ex.what());
+        return -1;
+    }
+    ChunkedLayout layout;
+    std::string error;
+    if (!parseChunkedContainer(sourceBytes(source), source.size(), layout, error)) {
+        throwIllegalArgument(env, error);
+        return -1;
+    }
+    return decodeContainerRange(env, state, layout, source.data(), offset, length, dstPtr + dstPos, dstLen, threads);
+}
@@ -3,7 +3,7 @@
 #include "openzl/zl_data.h"
 #include "openzl/zl_decompress.h"
 #include "openzl/zl_opaque_types.h"
-#include <array>
+#include <vector>
 
 namespace {
 
@@ -25,77 +25,114 @@ jint inferGraphOrdinal(ZL_Type outputType, size_t compressedSize, size_t decompr
     }
 }
 
-jlongArray describeFrameInternal(JNIEnv* env, const uint8_t* data, size_t length)
+// Reads the frame header into the describeFrame layout. Makes no JNI calls, so it may run while
+// the frame is pinned; on failure `error` names what could not be read.
+bool readFrameMeta(const uint8_t* data, size_t length, std::vector<jlong>& meta, const char*& error)
 {
     ZL_FrameInfo* frameInfo = ZL_FrameInfo_create(data, length);
     if (frameInfo == nullptr) {
-        throwNew(env, JniRefs().illegalStateException, "Failed to create frame info");
-        return nullptr;
+        error = "Failed to create frame info";
+        return false;
     }
 
     ZL_Report formatReport = ZL_FrameInfo_getFormatVersion(frameInfo);
     if (ZL_isError(formatReport)) {
         ZL_FrameInfo_free(frameInfo);
-        throwNew(env, JniRefs().illegalStateException, "Unable to read frame format version");
-        return nullptr;
+        error = "Unable to read frame format version";
+        return false;
     }
 
     ZL_Report outputsReport = ZL_FrameInfo_getNumOutputs(frameInfo);
     if (ZL_isError(outputsReport)) {
         ZL_FrameInfo_free(frameInfo);
-        throwNew(env, JniRefs().illegalStateException, "Unable to read frame outputs");
-        return nullptr;
+        error = "Unable to read frame outputs";
+        return false;
     }
 
     size_t numOutputs = ZL_RES_value(outputsReport);
     if (numOutputs == 0) {
         ZL_FrameInfo_free(frameInfo);
-        throwNew(env, JniRefs().illegalStateException, "Frame does not expose outputs");
-        return nullptr;
-    }
-
-    ZL_Report decompressedReport = ZL_FrameInfo_getDecompressedSize(frameInfo, 0);
-    if (ZL_isError(decompressedReport)) {
-        ZL_FrameInfo_free(frameInfo);
-        throwNew(env, JniRefs().illegalStateException, "Unable to determine decompressed size");
-        return nullptr;
+        error = "Frame does not expose outputs";
+        return false;
     }
-    size_t decompressedSize = ZL_RES_value(decompressedReport);
 
-    ZL_Report typeReport = ZL_FrameInfo_getOutputType(frameInfo, 0);
-    if (ZL_isError(typeReport)) {
-        ZL_FrameInfo_free(frameInfo);
-        throwNew(env, JniRefs().illegalStateException, "Unable to determine output type");
-        return nullptr;
+    // Every output is listed after the fixed fields as (type, size, element count, width);
+    // the fixed fields describe output 0.
+    std::vector<jlong> outputs;
+    outputs.reserve(numOutputs * 4);
+    size_t totalSize = 0;
+    for (size_t i = 0; i < numOutputs; ++i) {
+        ZL_Report sizeReport = ZL_FrameInfo_getDecompressedSize(frameInfo, static_cast<int>(i));
+        if (ZL_isError(sizeReport)) {
+            ZL_FrameInfo_free(frameInfo);
+            error = "Unable to determine decompressed size";
+            return false;
+        }
+        ZL_Report typeReport = ZL_FrameInfo_getOutputType(frameInfo, static_cast<int>(i));
+        if (ZL_isError(typeReport)) {
+            ZL_FrameInfo_free(frameInfo);
+            error = "Unable to determine output type";
+            return false;
+        }
+        size_t size = ZL_RES_value(sizeReport);
+        auto type = static_cast<ZL_Type>(ZL_RES_value(typeReport));
+        long elementCount = -1;
+        ZL_Report elementsReport = ZL_FrameInfo_getNumElts(frameInfo, static_cast<int>(i));
+        if (!ZL_isError(elementsReport)) {
+            elementCount = static_cast<long>(ZL_RES_value(elementsReport));
+        }
+        // Only fixed-width outputs have an element width; the frame header stores it
+        // implicitly as size / count.
+        long elementWidth = -1;
+        if ((type == ZL_Type_struct || type == ZL_Type_numeric) && elementCount > 0) {
+            elementWidth = static_cast<long>(size / static_cast<size_t>(elementCount));
+        }
+        outputs.push_back(static_cast<jlong>(type));
+        outputs.push_back(static_cast<jlong>(size));
+        outputs.push_back(static_cast<jlong>(elementCount));
+        outputs.push_back(static_cast<jlong>(elementWidth));
+        totalSize += size;
     }
-    int outputType = static_cast<int>(ZL_RES_value(typeReport));
 
-    long elementCount = -1;
-    ZL_Report elementsReport = ZL_FrameInfo_getNumElts(frameInfo, 0);
-    if (!ZL_isError(elementsReport)) {
-        elementCount = static_cast<long>(ZL_RES_value(elementsReport));
-    }
+    auto outputType = static_cast<ZL_Type>(outputs[0]);
+    jint graphOrdinal = inferGraphOrdinal(outputType, length, totalSize);
 
-    jint graphOrdinal = inferGraphOrdinal(static_cast<ZL_Type>(outputType), length, decompressedSize);
-
-    std::array<jlong, 6> meta = {
-        static_cast<jlong>(decompressedSize),
+    meta = {
+        outputs[1],
         static_cast<jlong>(length),
-        static_cast<jlong>(outputType),
+        outputs[0],
         static_cast<jlong>(graphOrdinal),
-        static_cast<jlong>(elementCount),
+        outputs[2],
         static_cast<jlong>(ZL_RES_value(formatReport)),
+        outputs[3],
+        static_cast<jlong>(numOutputs),
     };
+    meta.insert(meta.end(), outputs.begin(), outputs.end());
 
     ZL_FrameInfo_free(frameInfo);
+    return true;
+}
 
-    jlongArray result = env->NewLongArray(static_cast<jsize>(meta.size()));
+jlongArray toLongArray(JNIEnv* env, const std::vector<jlong>& values)
+{
+    jlongArray result = env->NewLongArray(static_cast<jsize>(values.size()));
     if (result != nullptr) {
-        env->SetLongArrayRegion(result, 0, static_cast<jsize>(meta.size()), meta.data());
+        env->SetLongArrayRegion(result, 0, static_cast<jsize>(values.size()), values.data());
     }
     return result;
 }
 
+jlongArray describeFrameInternal(JNIEnv* env, const uint8_t* data, size_t length)
+{
+    std::vector<jlong> meta;
+    const char* error = nullptr;
+    if (!readFrameMeta(data, length, meta, error)) {
+        throwNew(env, JniRefs().illegalStateException, error);
+        return nullptr;
+    }
+    return toLongArray(env, meta);
+}
+
 } // namespace
 
 extern "C" JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLCompressor_describeFrameNative(JNIEnv* env, jobject, jbyteArray src)
@@ -105,16 +142,26 @@ extern "C" JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLCompressor
         return nullptr;
     }
     jsize len = env->GetArrayLength(src);
-    void* srcPtr = env->GetPrimitiveArrayCritical(src, nullptr);
-    if (srcPtr == nullptr) {
-        throwNew(env, JniRefs().outOfMemoryError, "Unable to access compressed payload");
+    std::vector<jlong> meta;
+    const char* error = nullptr;
+    bool described;
+    {
+        // Only the header is read, so the pin is short whatever the frame size.
+        JNICriticalArray frame(env, src);
+        if (!frame) {
+            throwNew(env, JniRefs().outOfMemoryError, "Unable to access compressed payload");
+            return nullptr;
+        }
+        CriticalRegionTimer critical;
+        described = readFrameMeta(static_cast<const uint8_t*>(frame.get()), static_cast<size_t>(len), meta, error);
+        frame.release();
+        critical.stop();
+    }
+    if (!described) {
+        throwNew(env, JniRefs().illegalStateException, error);
         return nullptr;
     }
-    jlongArray result = describeFrameInternal(env,
-            static_cast<const uint8_t*>(srcPtr),
-            static_cast<size_t>(len));
-    env->ReleasePrimitiveArrayCritical(src, srcPtr, JNI_ABORT);
-    return result;
+    return toLongArray(env, meta);
 }
 
 extern "C" JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLCompressor_describeFrameDirectNative(JNIEnv* env, jobject, jobject buffer, jint position, jint length)
@@ -0,0 +1,408 @@
+#include "OpenZLCompressor.h"
+#include "OpenZLNativeSupport.h"
+#include "openzl/zl_compress.h"
+#include "openzl/zl_data.h"
+#include "openzl/zl_decompress.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+// Column kinds shared with OpenZLMultiInput; the values are the ZL_Type codes.
+constexpr jint COLUMN_SERIAL = ZL_Type_serial;
+constexpr jint COLUMN_STRUCT = ZL_Type_struct;
+constexpr jint COLUMN_NUMERIC = ZL_Type_numeric;
+constexpr jint COLUMN_STRING = ZL_Type_string;
+
+// One column of a multi-input call: `data` is a primitive array or a direct ByteBuffer, and
+// string columns carry their element lengths in a separate int[].
+struct Column {
+    jint type = 0;
+    size_t width = 1;
+    size_t offset = 0;
+    size_t size = 0;
+    jobject data = nullptr;
+    jintArray lengths = nullptr;
+    uint8_t* address = nullptr;
+    size_t lengthCount = 0;
+    uint32_t* lengthTable = nullptr;
+};
+
+// Critical pins held over a whole multi-input call, released together. Several arrays may be
+// pinned at once as long as no other JNI call is made until they are all released.
+class PinSet {
+public:
+    explicit PinSet(JNIEnv* e) : env(e) {}
+    ~PinSet() { release(JNI_ABORT); }
+    PinSet(const PinSet&) = delete;
+    PinSet& operator=(const PinSet&) = delete;
+
+    void* pin(jarray array)
+    {
+        void* ptr = env->GetPrimitiveArrayCritical(array, nullptr);
+        if (ptr != nullptr) {
+            pins.push_back({ array, ptr });
+        }
+        return ptr;
+    }
+
+    void release(jint mode)
+    {
+        for (auto it = pins.rbegin(); it != pins.rend(); ++it) {
+            env->ReleasePrimitiveArrayCritical(it->first, it->second, mode);
+        }
+        pins.clear();
+    }
+
+private:
+    JNIEnv* env;
+    std::vector<std::pair<jarray, void*>> pins;
+};
+
+bool readIntArray(JNIEnv* env, jintArray array, size_t count, std::vector<jint>& out, const char* name)
+{
+    if (array == nullptr || static_cast<size_t>(env->GetArrayLength(array)) != count) {
+        throwIllegalArgument(env, std::string(name) + " must have one entry per column");
+        return false;
+    }
+    out.resize(count);
+    if (count > 0) {
+        env->GetIntArrayRegion(array, 0, static_cast<jsize>(count), out.data());
+    }
+    return true;
+}
+
+// Resolves every column's object references and checks its byte range, before anything is
+// pinned. Each column holds at most two local references. `offsets` may be null for columns
+// that start at the beginning of their data.
+bool collectColumns(JNIEnv* env,
+        jobjectArray data,
+        jintArray types,
+        jintArray widths,
+        jintArray offsets,
+        jintArray sizes,
+        jobjectArray lengths,
+        std::vector<Column>& columns)
+{
+    if (data == nullptr) {
+        throwNew(env, JniRefs().nullPointerException, "columns");
+        return false;
+    }
+    size_t count = static_cast<size_t>(env->GetArrayLength(data));
+    std::vector<jint> typeValues;
+    std::vector<jint> widthValues;
+    std::vector<jint> offsetValues;
+    std::vector<jint> sizeValues;
+    if (!readIntArray(env, types, count, typeValues, "types")
+            || !readIntArray(env, widths, count, widthValues, "widths")
+            || (offsets != nullptr && !readIntArray(env, offsets, count, offsetValues, "offsets"))
+            || !readIntArray(env, sizes, count, sizeValues, "sizes")) {
+        return false;
+    }
+    // Output columns always start at the beginning of their arrays.
+    if (offsets == nullptr) {
+        offsetValues.assign(count, 0);
+    }
+    if (lengths == nullptr || static_cast<size_t>(env->GetArrayLength(lengths)) != count) {
+        throwIllegalArgument(env, "lengths must have one entry per column");
+        return false;
+    }
+    if (env->EnsureLocalCapacity(static_cast<jint>(count * 2)) != 0) {
+        return false;
+    }
+
+    columns.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        Column& column = columns[i];
+        column.type = typeValues[i];
+        if (widthValues[i] <= 0 || offsetValues[i] < 0 || sizeValues[i] < 0) {
+            throwIllegalArgument(env, "column width, offset and size must be valid");
+            return false;
+        }
+        column.width = static_cast<size_t>(widthValues[i]);
+        column.offset = static_cast<size_t>(offsetValues[i]);
+        column.size = static_cast<size_t>(sizeValues[i]);
+        column.data = env->GetObjectArrayElement(data, static_cast<jsize>(i));
+        if (column.data == nullptr) {
+            throwNew(env, JniRefs().nullPointerException, "column data is null");
+            return false;
+        }
+
+        size_t componentWidth = 1;
+        switch (column.type) {
+        case COLUMN_NUMERIC:
+            componentWidth = column.width;
+            [[fallthrough]];
+        case COLUMN_STRUCT:
+            if (column.size % column.width != 0) {
+                throwIllegalArgument(env, "column size must be a multiple of its width");
+                return false;
+            }
+            break;
+        case COLUMN_STRING:
+            column.lengths = static_cast<jintArray>(env->GetObjectArrayElement(lengths, static_cast<jsize>(i)));
+            if (column.lengths == nullptr) {
+                throwNew(env, JniRefs().nullPointerException, "string column lengths are null");
+                return false;
+            }
+            column.lengthCount = static_cast<size_t>(env->GetArrayLength(column.lengths));
+            break;
+        case COLUMN_SERIAL:
+            break;
+        default:
+            throwIllegalArgument(env, "unknown column type");
+            return false;
+        }
+
+        void* direct = env->GetDirectBufferAddress(column.data);
+        size_t capacity = 0;
+        if (direct != nullptr) {
+            column.address = static_cast<uint8_t*>(direct);
+            capacity = static_cast<size_t>(env->GetDirectBufferCapacity(column.data));
+        } else {
+            capacity = static_cast<size_t>(env->GetArrayLength(static_cast<jarray>(column.data))) * componentWidth;
+        }
+        if (column.offset > capacity || column.size > capacity - column.offset) {
+            throwIllegalArgument(env, "column range exceeds its data");
+            return false;
+        }
+    }
+    return true;
+}
+
+// Sums the string lengths of `column` once pinned. Makes no JNI calls.
+bool stringLengthsMatch(const Column& column)
+{
+    size_t sum = 0;
+    for (size_t i = 0; i < column.lengthCount; ++i) {
+        auto length = static_cast<jint>(column.lengthTable[i]);
+        if (length < 0 || static_cast<size_t>(length) > column.size - sum) {
+            return false;
+        }
+        sum += static_cast<size_t>(length);
+    }
+    return sum == column.size;
+}
+
+ZL_TypedRef* createTypedRef(const Column& column)
+{
+    const uint8_t* ptr = column.address + column.offset;
+    switch (column.type) {
+    case COLUMN_NUMERIC:
+        return ZL_TypedRef_createNumeric(ptr, column.width, column.size / column.width);
+    case COLUMN_STRUCT:
+        return ZL_TypedRef_createStruct(ptr, column.width, column.size / column.width);
+    case COLUMN_STRING:
+        return ZL_TypedRef_createString(ptr, column.size, column.lengthTable, column.lengthCount);
+    default:
+        return ZL_TypedRef_createSerial(ptr, column.size);
+    }
+}
+
+ZL_TypedBuffer* wrapOutput(const Column& column)
+{
+    switch (column.type) {
+    case COLUMN_NUMERIC:
+        return ZL_TypedBuffer_createWrapNumeric(column.address, column.width, column.size / column.width);
+    case COLUMN_STRUCT:
+        return ZL_TypedBuffer_createWrapStruct(column.address, column.width, column.size / column.width);
+    case COLUMN_STRING:
+        return ZL_TypedBuffer_createWrapString(column.address, column.size, column.lengthTable, column.lengthCount);
+    default:
+        return ZL_TypedBuffer_createWrapSerial(column.address, column.size);
+    }
+}
+
+// Pins every array-backed column and its lengths table. Returns false, with everything
+// released, when a pin fails.
+bool pinColumns(PinSet& pins, std::vector<Column>& columns)
+{
+    for (Column& column : columns) {
+        if (column.address == nullptr) {
+            column.address = static_cast<uint8_t*>(pins.pin(static_cast<jarray>(column.data)));
+            if (column.address == nullptr) {
+                pins.release(JNI_ABORT);
+                return false;
+            }
+        }
+        if (column.lengths != nullptr) {
+            column.lengthTable = static_cast<uint32_t*>(pins.pin(column.lengths));
+            if (column.lengthTable == nullptr) {
+                pins.release(JNI_ABORT);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressMultiNative(JNIEnv* env,
+        jobject obj,
+        jobjectArray data,
+        jintArray types,
+        jintArray widths,
+        jintArray offsets,
+        jintArray sizes,
+        jobjectArray lengths)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "compressMulti")) {
+        return nullptr;
+    }
+    std::vector<Column> columns;
+    if (!collectColumns(env, data, types, widths, offsets, sizes, lengths, columns)) {
+        return nullptr;
+    }
+    if (columns.empty()) {
+        throwIllegalArgument(env, "at least one column is required");
+        return nullptr;
+    }
+    size_t bound = 0;
+    for (const Column& column : columns) {
+        bound += ZL_compressBound(column.size + column.lengthCount * sizeof(uint32_t));
+    }
+    uint8_t* dstPtr = state->outputScratch.ensure(bound);
+    if (dstPtr == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+        return nullptr;
+    }
+
+    // Columns are handed to OpenZL where they live: arrays pinned, direct buffers by address.
+    PinSet pins(env);
+    CriticalRegionTimer critical;
+    if (!pinColumns(pins, columns)) {
+        critical.stop();
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to access column data");
+        return nullptr;
+    }
+    bool consistent = true;
+    for (const Column& column : columns) {
+        consistent = consistent && (column.type != COLUMN_STRING || stringLengthsMatch(column));
+    }
+    std::vector<ZL_TypedRef*> refs;
+    bool allocated = true;
+    ZL_Report report{};
+    if (consistent) {
+        refs.reserve(columns.size());
+        for (const Column& column : columns) {
+            ZL_TypedRef* ref = createTypedRef(column);
+            allocated = allocated && ref != nullptr;
+            refs.push_back(ref);
+        }
+        if (allocated) {
+            report = ZL_CCtx_compressMultiTypedRef(state->cctx,
+                    dstPtr,
+                    bound,
+                    const_cast<const ZL_TypedRef**>(refs.data()),
+                    refs.size());
+        }
+        for (ZL_TypedRef* ref : refs) {
+            ZL_TypedRef_free(ref);
+        }
+    }
+    pins.release(JNI_ABORT);
+    critical.stop();
+
+    if (!consistent) {
+        throwIllegalArgument(env, "string lengths must be non-negative and sum to the column size");
+        return nullptr;
+    }
+    if (!allocated) {
+        throwNew(env, JniRefs().outOfMemoryError, "Failed to allocate column typed reference");
+        return nullptr;
+    }
+    if (ZL_isError(report)) {
+        recordCompressError(state, "compressMulti", report);
+        return nullptr;
+    }
+    size_t produced = ZL_RES_value(report);
+    state->outputScratch.setSize(produced);
+    jbyteArray result = env->NewByteArray(static_cast<jsize>(produced));
+    if (result != nullptr && produced > 0) {
+        env->SetByteArrayRegion(result, 0, static_cast<jsize>(produced), reinterpret_cast<const jbyte*>(dstPtr));
+    }
+    return result;
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressMultiNative(JNIEnv* env,
+        jobject obj,
+        jbyteArray src,
+        jobjectArray outputs,
+        jintArray types,
+        jintArray widths,
+        jintArray sizes,
+        jobjectArray lengths)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "decompressMulti")) {
+        return -1;
+    }
+    if (src == nullptr) {
+        throwNew(env, JniRefs().nullPointerException, "compressed");
+        return -1;
+    }
+    std::vector<Column> columns;
+    if (!collectColumns(env, outputs, types, widths, nullptr, sizes, lengths, columns)) {
+        return -1;
+    }
+    jsize srcLen = env->GetArrayLength(src);
+
+    // The output arrays were sized from the frame header, so every output is decoded in place.
+    PinSet pins(env);
+    CriticalRegionTimer critical;
+    void* frame = pins.pin(src);
+    if (frame == nullptr || !pinColumns(pins, columns)) {
+        pins.release(JNI_ABORT);
+        critical.stop();
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to access output columns");
+        return -1;
+    }
+    std::vector<ZL_TypedBuffer*> buffers;
+    buffers.reserve(columns.size());
+    bool allocated = true;
+    for (const Column& column : columns) {
+        ZL_TypedBuffer* buffer = wrapOutput(column);
+        allocated = allocated && buffer != nullptr;
+        buffers.push_back(buffer);
+    }
+    ZL_Report report{};
+    bool complete = true;
+    if (allocated) {
+        report = ZL_DCtx_decompressMultiTBuffer(state->dctx,
+                buffers.data(),
+                buffers.size(),
+                frame,
+                static_cast<size_t>(srcLen));
+        for (size_t i = 0; i < columns.size() && !ZL_isError(report); ++i) {
+            const Column& column = columns[i];
+            size_t expected = column.type == COLUMN_STRING ? column.lengthCount : column.size / column.width;
+            complete = complete
+                    && ZL_TypedBuffer_byteSize(buffers[i]) == column.size
+                    && ZL_TypedBuffer_numElts(buffers[i]) == expected;
+        }
+    }
+    for (ZL_TypedBuffer* buffer : buffers) {
+        if (buffer != nullptr) {
+            ZL_TypedBuffer_free(buffer);
+        }
+    }
+    bool ok = allocated && !ZL_isError(report) && complete;
+    pins.release(ok ? 0 : JNI_ABORT);
+    critical.stop();
+
+    if (!allocated) {
+        throwNew(env, JniRefs().outOfMemoryError, "Failed to allocate column output buffer");
+        return -1;
+    }
+    if (ZL_isError(report)) {
+        recordDecompressError(state, "decompressMulti", report);
+        return -1;
+    }
+    if (!complete) {
+        throwNew(env, JniRefs().illegalStateException, "Decoded columns do not match the frame header");
+        return -1;
+    }
+    return static_cast<jint>(columns.size());
+}
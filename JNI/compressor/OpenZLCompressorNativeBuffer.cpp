@@ -0,0 +1,111 @@
+#include "OpenZLCompressor.h"
+#include "OpenZLNativeBuffer.h"
+#include "OpenZLNativeSupport.h"
+#include "openzl/zl_compress.h"
+#include "openzl/zl_decompress.h"
+
+extern "C" JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_compressToNativeNative(JNIEnv* env,
+        jobject obj,
+        jbyteArray src,
+        jint srcOff,
+        jint srcLen)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "compressToNative")) {
+        return 0;
+    }
+    if (!checkArrayRange(env, src, srcOff, srcLen, "src")) {
+        return 0;
+    }
+
+    size_t bound = ZL_compressBound(static_cast<size_t>(srcLen));
+    uint8_t* block = nativeBlockAllocate(bound);
+    if (block == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native result buffer");
+        return 0;
+    }
+
+    ByteArrayInput input(env, src, srcOff, srcLen, state->inputScratch);
+    if (!input) {
+        nativeBlockRelease(block);
+        return 0;
+    }
+    ZL_Report result = ZL_CCtx_compress(state->cctx,
+            block,
+            bound,
+            input.data(),
+            static_cast<size_t>(srcLen));
+    input.release();
+
+    if (ZL_isError(result)) {
+        recordCompressError(state, "compressToNative", result);
+        nativeBlockRelease(block);
+        return 0;
+    }
+    nativeBlockSetSize(block, ZL_RES_value(result));
+    return reinterpret_cast<jlong>(block);
+}
+
+extern "C" JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressToNativeNative(JNIEnv* env,
+        jobject obj,
+        jbyteArray src,
+        jint srcOff,
+        jint srcLen)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "decompressToNative")) {
+        return 0;
+    }
+    if (!checkArrayRange(env, src, srcOff, srcLen, "src")) {
+        return 0;
+    }
+
+    ByteArrayInput input(env, src, srcOff, srcLen, state->inputScratch);
+    if (!input) {
+        return 0;
+    }
+    const uint8_t* srcBytes = input.data();
+    ZL_Report sizeReport = ZL_getDecompressedSize(srcBytes, static_cast<size_t>(srcLen));
+    if (ZL_isError(sizeReport)) {
+        input.release();
+        recordError(state, "decompressToNative", static_cast<int>(ZL_RES_code(sizeReport)), nullptr);
+        return 0;
+    }
+
+    size_t outCap = ZL_RES_value(sizeReport);
+    uint8_t* block = nativeBlockAllocate(outCap);
+    if (block == nullptr) {
+        input.release();
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native result buffer");
+        return 0;
+    }
+    ZL_Report result = ZL_DCtx_decompress(state->dctx, block, outCap, srcBytes, static_cast<size_t>(srcLen));
+    input.release();
+
+    if (ZL_isError(result)) {
+        recordDecompressError(state, "decompressToNative", result);
+        nativeBlockRelease(block);
+        return 0;
+    }
+    nativeBlockSetSize(block, ZL_RES_value(result));
+    return reinterpret_cast<jlong>(block);
+}
+
+extern "C" JNIEXPORT jobject JNICALL Java_io_github_hybledav_OpenZLCompressor_nativeBufferViewNative(JNIEnv* env,
+        jclass,
+        jlong handle)
+{
+    auto* block = reinterpret_cast<uint8_t*>(handle);
+    if (block == nullptr) {
+        throwNew(env, JniRefs().illegalStateException, "Native buffer already released");
+        return nullptr;
+    }
+    return env->NewDirectByteBuffer(block, static_cast<jlong>(nativeBlockSize(block)));
+}
+
+extern "C" JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_nativeBufferReleaseNative(JNIEnv*,
+        jclass,
+        jlong handle)
+{
+    nativeBlockRelease(reinterpret_cast<uint8_t*>(handle));
+}
@@ -1,59 +1,313 @@
+#include "OpenZLByteSwap.h"
 #include "OpenZLCompressor.h"
 #include "OpenZLNativeSupport.h"
 #include "openzl/zl_compress.h"
 #include "openzl/zl_data.h"
 #include "openzl/zl_decompress.h"
-#include <cstdio>
+#include <algorithm>
 #include <limits>
-#include <vector>
 
 namespace {
 
-struct JNICriticalArray {
-    JNIEnv* env;
-    jarray array;
-    void* ptr;
+template <typename T>
+struct NumericArrayTraits;
 
-    JNICriticalArray(JNIEnv* e, jarray a) : env(e), array(a) {
-        ptr = env->GetPrimitiveArrayCritical(array, nullptr);
+template <>
+struct NumericArrayTraits<jint> {
+    using ArrayType = jintArray;
+    static constexpr const char* mismatch = "Compressed stream is not an int array";
+    static ArrayType create(JNIEnv* env, jsize length) { return env->NewIntArray(length); }
+};
+
+template <>
+struct NumericArrayTraits<jlong> {
+    using ArrayType = jlongArray;
+    static constexpr const char* mismatch = "Compressed stream is not a long array";
+    static ArrayType create(JNIEnv* env, jsize length) { return env->NewLongArray(length); }
+};
+
+template <>
+struct NumericArrayTraits<jfloat> {
+    using ArrayType = jfloatArray;
+    static constexpr const char* mismatch = "Compressed stream is not a float array";
+    static ArrayType create(JNIEnv* env, jsize length) { return env->NewFloatArray(length); }
+};
+
+template <>
+struct NumericArrayTraits<jdouble> {
+    using ArrayType = jdoubleArray;
+    static constexpr const char* mismatch = "Compressed stream is not a double array";
+    static ArrayType create(JNIEnv* env, jsize length) { return env->NewDoubleArray(length); }
+};
+
+enum class NumericFrame {
+    Ok,
+    Failed,
+    Mismatch,
+    TooLarge,
+};
+
+// Reads the element count of a single fixed-width output of type `expected` from the frame
+// header. A `width` of 0 accepts any width and reports the one found. Makes no JNI calls, so it
+// may run while arrays are pinned; OpenZL failures are recorded on the state.
+NumericFrame inspectFixedWidthFrame(NativeState* state,
+        const void* frame,
+        size_t length,
+        ZL_Type expected,
+        const char* op,
+        size_t& elementCount,
+        size_t& width)
+{
+    ZL_FrameInfo* frameInfo = ZL_FrameInfo_create(frame, length);
+    if (frameInfo == nullptr) {
+        recordError(state, op, static_cast<int>(ZL_ErrorCode_corruption), "invalid frame header");
+        return NumericFrame::Failed;
     }
+    ZL_Report outputs = ZL_FrameInfo_getNumOutputs(frameInfo);
+    ZL_Report type = ZL_FrameInfo_getOutputType(frameInfo, 0);
+    ZL_Report size = ZL_FrameInfo_getDecompressedSize(frameInfo, 0);
+    ZL_Report elements = ZL_FrameInfo_getNumElts(frameInfo, 0);
+    ZL_FrameInfo_free(frameInfo);
+    for (const ZL_Report& report : { outputs, type, size, elements }) {
+        if (ZL_isError(report)) {
+            recordError(state, op, static_cast<int>(ZL_RES_code(report)), nullptr);
+            return NumericFrame::Failed;
+        }
+    }
+    elementCount = ZL_RES_value(elements);
+    size_t byteSize = ZL_RES_value(size);
+    if (width == 0 && elementCount > 0) {
+        width = byteSize / elementCount;
+    }
+    if (ZL_RES_value(outputs) != 1
+            || static_cast<ZL_Type>(ZL_RES_value(type)) != expected
+            || byteSize != elementCount * width) {
+        return NumericFrame::Mismatch;
+    }
+    if (elementCount > static_cast<size_t>(std::numeric_limits<jsize>::max())) {
+        return NumericFrame::TooLarge;
+    }
+    return NumericFrame::Ok;
+}
 
-    ~JNICriticalArray() {
-        if (ptr != nullptr) {
-            env->ReleasePrimitiveArrayCritical(array, ptr, JNI_ABORT);
+NumericFrame inspectNumericFrame(NativeState* state,
+        const void* frame,
+        size_t length,
+        size_t width,
+        const char* op,
+        size_t& elementCount)
+{
+    return inspectFixedWidthFrame(state, frame, length, ZL_Type_numeric, op, elementCount, width);
+}
+
+void throwNumericFrame(JNIEnv* env, NumericFrame status, const char* mismatch)
+{
+    if (status == NumericFrame::Mismatch) {
+        throwNew(env, JniRefs().illegalStateException, mismatch);
+    } else if (status == NumericFrame::TooLarge) {
+        throwNew(env, JniRefs().illegalStateException, "Decompressed array is too large");
+    }
+}
+
+const char* widthMismatch(size_t width)
+{
+    return width == 8 ? "Compressed stream does not hold 8-byte numeric elements"
+                      : "Compressed stream does not hold 4-byte numeric elements";
+}
+
+bool validWidth(JNIEnv* env, jint width)
+{
+    if (width != 4 && width != 8) {
+        throwIllegalArgument(env, "elementWidth must be 4 or 8");
+        return false;
+    }
+    return true;
+}
+
+// Get<T>ArrayRegion for a numeric array known only by its element width; float and double
+// arrays are told apart from int and long arrays by class.
+void getNumericRegion(JNIEnv* env, jarray array, jsize start, jsize count, size_t width, void* dst)
+{
+    auto& refs = JniRefs();
+    if (width == sizeof(jint)) {
+        if (env->IsInstanceOf(array, refs.floatArrayClass)) {
+            env->GetFloatArrayRegion(static_cast<jfloatArray>(array), start, count, static_cast<jfloat*>(dst));
+        } else {
+            env->GetIntArrayRegion(static_cast<jintArray>(array), start, count, static_cast<jint*>(dst));
         }
+    } else if (env->IsInstanceOf(array, refs.doubleArrayClass)) {
+        env->GetDoubleArrayRegion(static_cast<jdoubleArray>(array), start, count, static_cast<jdouble*>(dst));
+    } else {
+        env->GetLongArrayRegion(static_cast<jlongArray>(array), start, count, static_cast<jlong*>(dst));
     }
+}
 
-    void* get() const { return ptr; }
-    void release() {
-        if (ptr != nullptr) {
-            env->ReleasePrimitiveArrayCritical(array, ptr, JNI_ABORT);
-            ptr = nullptr;
+void setNumericRegion(JNIEnv* env, jarray array, jsize start, jsize count, size_t width, const void* src)
+{
+    auto& refs = JniRefs();
+    if (width == sizeof(jint)) {
+        if (env->IsInstanceOf(array, refs.floatArrayClass)) {
+            env->SetFloatArrayRegion(static_cast<jfloatArray>(array), start, count, static_cast<const jfloat*>(src));
+        } else {
+            env->SetIntArrayRegion(static_cast<jintArray>(array), start, count, static_cast<const jint*>(src));
         }
+    } else if (env->IsInstanceOf(array, refs.doubleArrayClass)) {
+        env->SetDoubleArrayRegion(static_cast<jdoubleArray>(array), start, count, static_cast<const jdouble*>(src));
+    } else {
+        env->SetLongArrayRegion(static_cast<jlongArray>(array), start, count, static_cast<const jlong*>(src));
     }
-    operator bool() const { return ptr != nullptr; }
-};
+}
 
-jbyteArray compressNumericCommon(
-        JNIEnv* env,
+// Copies a compressed byte[] range into the input scratch once the pinning policy chose to copy.
+// Returns null after raising OutOfMemoryError.
+const uint8_t* copyFrameIn(JNIEnv* env, NativeState* state, jbyteArray src, jint offset, jint length)
+{
+    uint8_t* bytes = state->inputScratch.ensure(static_cast<size_t>(length));
+    if (bytes == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+        return nullptr;
+    }
+    if (length > 0) {
+        env->GetByteArrayRegion(src, offset, length, reinterpret_cast<jbyte*>(bytes));
+    }
+    return bytes;
+}
+
+// Reads the frame header of a byte[] under a short timed pin. Returns false after raising
+// OutOfMemoryError.
+bool inspectPinnedFrame(JNIEnv* env,
         NativeState* state,
+        jbyteArray src,
+        jsize length,
+        ZL_Type expected,
+        const char* op,
+        size_t& elementCount,
+        size_t& width,
+        NumericFrame& status)
+{
+    JNICriticalArray frame(env, src);
+    if (!frame) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to access compressed payload");
+        return false;
+    }
+    CriticalRegionTimer critical;
+    status = inspectFixedWidthFrame(state, frame.get(), static_cast<size_t>(length), expected, op, elementCount, width);
+    frame.release();
+    critical.stop();
+    return true;
+}
+
+// Returns false only when the typed reference cannot be allocated.
+bool compressNumericRaw(NativeState* state,
         const void* data,
         size_t elementSize,
-        size_t elementCount)
+        size_t elementCount,
+        void* dst,
+        size_t capacity,
+        ZL_Report& report)
 {
-    size_t totalSize = elementSize * elementCount;
-    size_t bound = ZL_compressBound(totalSize);
-    uint8_t* dstPtr = state->outputScratch.ensure(bound);
     ZL_TypedRef* typedRef = ZL_TypedRef_createNumeric(data, elementSize, elementCount);
     if (typedRef == nullptr) {
-        throwNew(env, JniRefs().outOfMemoryError, "Failed to allocate numeric typed reference");
-        return nullptr;
+        return false;
     }
+    report = ZL_CCtx_compressTypedRef(state->cctx, dst, capacity, typedRef);
+    ZL_TypedRef_free(typedRef);
+    return true;
+}
 
-    ZL_Report report = ZL_CCtx_compressTypedRef(state->cctx, dstPtr, bound, typedRef);
+bool decodedAsExpected(const ZL_OutputInfo& info,
+        size_t width,
+        size_t elementCount,
+        ZL_Type expected = ZL_Type_numeric)
+{
+    return info.type == expected && info.fixedWidth == width && info.numElts == elementCount;
+}
+
+// Struct counterpart of compressNumericRaw: `recordCount` records of `recordWidth` bytes.
+bool compressStructRaw(NativeState* state,
+        const void* data,
+        size_t recordWidth,
+        size_t recordCount,
+        void* dst,
+        size_t capacity,
+        ZL_Report& report)
+{
+    ZL_TypedRef* typedRef = ZL_TypedRef_createStruct(data, recordWidth, recordCount);
+    if (typedRef == nullptr) {
+        return false;
+    }
+    report = ZL_CCtx_compressTypedRef(state->cctx, dst, capacity, typedRef);
     ZL_TypedRef_free(typedRef);
+    return true;
+}
+
+// Resolves the direct struct source range shared by both compressStructs natives.
+const uint8_t* structSource(JNIEnv* env, jobject src, jint srcPos, jint srcLen, jint recordWidth)
+{
+    if (recordWidth <= 0) {
+        throwIllegalArgument(env, "recordWidth must be positive");
+        return nullptr;
+    }
+    if (!ensureDirectRange(env, src, srcPos, srcLen, "src")) {
+        return nullptr;
+    }
+    if (srcLen % recordWidth != 0) {
+        throwIllegalArgument(env, "src length must be a multiple of recordWidth");
+        return nullptr;
+    }
+    auto* base = static_cast<const uint8_t*>(env->GetDirectBufferAddress(src));
+    return base == nullptr ? nullptr : base + srcPos;
+}
+
+const char* const STRUCT_MISMATCH = "Compressed stream is not a struct array";
+
+// Compresses the array in place under a critical pin, or from a scratch copy once it reaches the
+// pinning threshold; only the compressed frame is copied back.
+jbyteArray compressNumericCommon(
+        JNIEnv* env,
+        NativeState* state,
+        jarray data,
+        size_t elementSize,
+        const char* op)
+{
+    jsize length = env->GetArrayLength(data);
+    size_t elementCount = static_cast<size_t>(length);
+    size_t byteSize = elementSize * elementCount;
+    size_t bound = ZL_compressBound(byteSize);
+    uint8_t* dstPtr = state->outputScratch.ensure(bound);
+    if (dstPtr == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+        return nullptr;
+    }
+
+    ZL_Report report{};
+    bool allocated;
+    if (byteSize >= pinningThreshold()) {
+        uint8_t* elements = state->inputScratch.ensure(byteSize);
+        if (elements == nullptr) {
+            throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+            return nullptr;
+        }
+        getNumericRegion(env, data, 0, length, elementSize, elements);
+        allocated = compressNumericRaw(state, elements, elementSize, elementCount, dstPtr, bound, report);
+    } else {
+        JNICriticalArray elements(env, data);
+        if (!elements) {
+            throwNew(env, JniRefs().outOfMemoryError, "Unable to access numeric array");
+            return nullptr;
+        }
+        CriticalRegionTimer critical;
+        allocated = compressNumericRaw(state, elements.get(), elementSize, elementCount, dstPtr, bound, report);
+        elements.release();
+        critical.stop();
+    }
 
+    if (!allocated) {
+        throwNew(env, JniRefs().outOfMemoryError, "Failed to allocate numeric typed reference");
+        return nullptr;
+    }
     if (ZL_isError(report)) {
+        recordCompressError(state, op, report);
         return nullptr;
     }
 
@@ -69,6 +323,170 @@ jbyteArray compressNumericCommon(
     return result;
 }
 
+// Sizes the result from the frame header and allocates the Java array first. Small calls decode
+// straight into it while both arrays are pinned; once the frame or the result reaches the
+// pinning threshold the frame is copied in and the elements copied out instead.
+template <typename T>
+typename NumericArrayTraits<T>::ArrayType decompressNumericCommon(
+        JNIEnv* env,
+        jobject obj,
+        jbyteArray src,
+        const char* op)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, op)) {
+        return nullptr;
+    }
+    if (src == nullptr) {
+        throwNew(env, JniRefs().nullPointerException, "compressed");
+        return nullptr;
+    }
+    jsize len = env->GetArrayLength(src);
+    size_t threshold = pinningThreshold();
+    const uint8_t* copied = nullptr;
+    size_t elementCount = 0;
+    size_t width = sizeof(T);
+    NumericFrame status;
+    if (static_cast<size_t>(len) >= threshold) {
+        copied = copyFrameIn(env, state, src, 0, len);
+        if (copied == nullptr) {
+            return nullptr;
+        }
+        status = inspectNumericFrame(state, copied, static_cast<size_t>(len), width, op, elementCount);
+    } else if (!inspectPinnedFrame(env, state, src, len, ZL_Type_numeric, op, elementCount, width, status)) {
+        return nullptr;
+    }
+    if (status != NumericFrame::Ok) {
+        throwNumericFrame(env, status, NumericArrayTraits<T>::mismatch);
+        return nullptr;
+    }
+    auto result = NumericArrayTraits<T>::create(env, static_cast<jsize>(elementCount));
+    if (result == nullptr) {
+        return nullptr;
+    }
+
+    size_t byteSize = elementCount * sizeof(T);
+    ZL_OutputInfo info{};
+    ZL_Report report;
+    bool valid;
+    if (copied != nullptr || byteSize >= threshold) {
+        if (copied == nullptr) {
+            copied = copyFrameIn(env, state, src, 0, len);
+            if (copied == nullptr) {
+                return nullptr;
+            }
+        }
+        uint8_t* elements = state->outputScratch.ensure(byteSize);
+        if (elements == nullptr) {
+            throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+            return nullptr;
+        }
+        report = ZL_DCtx_decompressTyped(state->dctx, &info, elements, byteSize, copied, static_cast<size_t>(len));
+        valid = !ZL_isError(report) && decodedAsExpected(info, sizeof(T), elementCount);
+        if (valid && elementCount > 0) {
+            setNumericRegion(env, result, 0, static_cast<jsize>(elementCount), sizeof(T), elements);
+        }
+    } else {
+        JNICriticalArray frame(env, src);
+        if (!frame) {
+            throwNew(env, JniRefs().outOfMemoryError, "Unable to access compressed payload");
+            return nullptr;
+        }
+        CriticalRegionTimer critical;
+        JNICriticalArray output(env, result);
+        if (!output) {
+            frame.release();
+            critical.stop();
+            throwNew(env, JniRefs().outOfMemoryError, "Unable to access numeric array");
+            return nullptr;
+        }
+        report = ZL_DCtx_decompressTyped(state->dctx,
+                &info,
+                output.get(),
+                byteSize,
+                frame.get(),
+                static_cast<size_t>(len));
+        frame.release();
+        valid = !ZL_isError(report) && decodedAsExpected(info, sizeof(T), elementCount);
+        output.release(valid ? 0 : JNI_ABORT);
+        critical.stop();
+    }
+
+    if (ZL_isError(report)) {
+        recordDecompressError(state, op, report);
+        return nullptr;
+    }
+    if (!valid) {
+        throwNew(env, JniRefs().illegalStateException, NumericArrayTraits<T>::mismatch);
+        return nullptr;
+    }
+    return result;
+}
+
+// Records a too-small destination and returns false when `elementCount` elements do not fit.
+bool fitsDestination(NativeState* state, const char* op, size_t elementCount, size_t dstElements)
+{
+    if (elementCount > dstElements) {
+        recordError(state,
+                op,
+                static_cast<int>(ZL_ErrorCode_dstCapacity_tooSmall),
+                "destination holds fewer elements than the frame");
+        return false;
+    }
+    return true;
+}
+
+// Decodes a frame inspectNumericFrame accepted as `elementCount` elements into `dst`, which
+// holds at least that many. Returns the element count, -1 after recording an OpenZL failure, or
+// -2 when the caller must raise `status`.
+jint decodeNumericFrame(NativeState* state,
+        const void* src,
+        size_t srcLen,
+        void* dst,
+        size_t width,
+        size_t elementCount,
+        const char* op,
+        NumericFrame& status)
+{
+    ZL_OutputInfo info{};
+    ZL_Report report = ZL_DCtx_decompressTyped(state->dctx, &info, dst, elementCount * width, src, srcLen);
+    if (ZL_isError(report)) {
+        recordDecompressError(state, op, report);
+        return -1;
+    }
+    if (!decodedAsExpected(info, width, elementCount)) {
+        status = NumericFrame::Mismatch;
+        return -2;
+    }
+    return static_cast<jint>(elementCount);
+}
+
+// Shared by the byte[] and direct "into" variants once the memory is addressable. Returns the
+// number of decoded elements, -1 after recording an OpenZL failure, or -2 when the caller
+// must raise `status`.
+jint decompressNumericRaw(NativeState* state,
+        const void* src,
+        size_t srcLen,
+        void* dst,
+        size_t width,
+        size_t dstElements,
+        const char* op,
+        NumericFrame& status)
+{
+    size_t elementCount = 0;
+    status = inspectNumericFrame(state, src, srcLen, width, op, elementCount);
+    if (status == NumericFrame::Failed) {
+        return -1;
+    }
+    if (status != NumericFrame::Ok) {
+        return -2;
+    }
+    if (!fitsDestination(state, op, elementCount, dstElements)) {
+        return -1;
+    }
+    return decodeNumericFrame(state, src, srcLen, dst, width, elementCount, op, status);
+}
+
 } // namespace
 
 extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressIntsNative(JNIEnv* env, jobject obj, jintArray data)
@@ -77,20 +495,7 @@ extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor
     if (!ensureState(state, "compressInts")) {
         return nullptr;
     }
-    jsize length = env->GetArrayLength(data);
-    jint* elements = env->GetIntArrayElements(data, nullptr);
-    if (elements == nullptr) {
-        throwNew(env, JniRefs().outOfMemoryError, "Unable to access int array");
-        return nullptr;
-    }
-    jbyteArray result = compressNumericCommon(
-            env,
-            state,
-            elements,
-            sizeof(jint),
-            static_cast<size_t>(length));
-    env->ReleaseIntArrayElements(data, elements, JNI_ABORT);
-    return result;
+    return compressNumericCommon(env, state, data, sizeof(jint), "compressInts");
 }
 
 extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressLongsNative(JNIEnv* env, jobject obj, jlongArray data)
@@ -99,20 +504,7 @@ extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor
     if (!ensureState(state, "compressLongs")) {
         return nullptr;
     }
-    jsize length = env->GetArrayLength(data);
-    jlong* elements = env->GetLongArrayElements(data, nullptr);
-    if (elements == nullptr) {
-        throwNew(env, JniRefs().outOfMemoryError, "Unable to access long array");
-        return nullptr;
-    }
-    jbyteArray result = compressNumericCommon(
-            env,
-            state,
-            elements,
-            sizeof(jlong),
-            static_cast<size_t>(length));
-    env->ReleaseLongArrayElements(data, elements, JNI_ABORT);
-    return result;
+    return compressNumericCommon(env, state, data, sizeof(jlong), "compressLongs");
 }
 
 extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressFloatsNative(JNIEnv* env, jobject obj, jfloatArray data)
@@ -121,20 +513,7 @@ extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor
     if (!ensureState(state, "compressFloats")) {
         return nullptr;
     }
-    jsize length = env->GetArrayLength(data);
-    jfloat* elements = env->GetFloatArrayElements(data, nullptr);
-    if (elements == nullptr) {
-        throwNew(env, JniRefs().outOfMemoryError, "Unable to access float array");
-        return nullptr;
-    }
-    jbyteArray result = compressNumericCommon(
-            env,
-            state,
-            elements,
-            sizeof(jfloat),
-            static_cast<size_t>(length));
-    env->ReleaseFloatArrayElements(data, elements, JNI_ABORT);
-    return result;
+    return compressNumericCommon(env, state, data, sizeof(jfloat), "compressFloats");
 }
 
 extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressDoublesNative(JNIEnv* env, jobject obj, jdoubleArray data)
@@ -143,220 +522,528 @@ extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor
     if (!ensureState(state, "compressDoubles")) {
         return nullptr;
     }
-    jsize length = env->GetArrayLength(data);
-    jdouble* elements = env->GetDoubleArrayElements(data, nullptr);
-    if (elements == nullptr) {
-        throwNew(env, JniRefs().outOfMemoryError, "Unable to access double array");
-        return nullptr;
-    }
-    jbyteArray result = compressNumericCommon(
-            env,
-            state,
-            elements,
-            sizeof(jdouble),
-            static_cast<size_t>(length));
-    env->ReleaseDoubleArrayElements(data, elements, JNI_ABORT);
-    return result;
+    return compressNumericCommon(env, state, data, sizeof(jdouble), "compressDoubles");
 }
 
 extern "C" JNIEXPORT jintArray JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressIntsNative(JNIEnv* env, jobject obj, jbyteArray src)
+{
+    return decompressNumericCommon<jint>(env, obj, src, "decompressInts");
+}
+
+extern "C" JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressLongsNative(JNIEnv* env, jobject obj, jbyteArray src)
+{
+    return decompressNumericCommon<jlong>(env, obj, src, "decompressLongs");
+}
+
+extern "C" JNIEXPORT jfloatArray JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressFloatsNative(JNIEnv* env, jobject obj, jbyteArray src)
+{
+    return decompressNumericCommon<jfloat>(env, obj, src, "decompressFloats");
+}
+
+extern "C" JNIEXPORT jdoubleArray JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressDoublesNative(JNIEnv* env, jobject obj, jbyteArray src)
+{
+    return decompressNumericCommon<jdouble>(env, obj, src, "decompressDoubles");
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compressNumericIntoNative(JNIEnv* env,
+        jobject obj,
+        jarray src,
+        jint elementWidth,
+        jint srcOff,
+        jint srcLen,
+        jbyteArray dst,
+        jint dstOff,
+        jint dstLen)
 {
     auto* state = getState(env, obj);
-    if (!ensureState(state, "decompressInts")) {
-        return nullptr;
+    if (!ensureState(state, "compressNumericInto")) {
+        return -1;
     }
-    jsize len = env->GetArrayLength(src);
-    void* srcPtr = env->GetPrimitiveArrayCritical(src, nullptr);
-    if (srcPtr == nullptr) {
+    if (!validWidth(env, elementWidth)) {
+        return -1;
+    }
+    if (!checkArrayRange(env, src, srcOff, srcLen, "src")) {
+        return -1;
+    }
+    if (!checkArrayRange(env, dst, dstOff, dstLen, "dst")) {
+        return -1;
+    }
+    size_t width = static_cast<size_t>(elementWidth);
+    size_t threshold = pinningThreshold();
+    if (static_cast<size_t>(srcLen) * width >= threshold || static_cast<size_t>(dstLen) >= threshold) {
+        size_t byteSize = static_cast<size_t>(srcLen) * width;
+        uint8_t* elements = state->inputScratch.ensure(byteSize);
+        if (elements == nullptr) {
+            throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+            return -1;
+        }
+        getNumericRegion(env, src, srcOff, srcLen, width, elements);
+        // Capacity beyond the bound is never used, and a smaller one keeps the too-small error.
+        size_t capacity = std::min(static_cast<size_t>(dstLen), ZL_compressBound(byteSize));
+        uint8_t* dstBytes = state->outputScratch.ensure(capacity);
+        if (dstBytes == nullptr) {
+            throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+            return -1;
+        }
+        ZL_Report report{};
+        if (!compressNumericRaw(state, elements, width, static_cast<size_t>(srcLen), dstBytes, capacity, report)) {
+            throwNew(env, JniRefs().outOfMemoryError, "Failed to allocate numeric typed reference");
+            return -1;
+        }
+        if (ZL_isError(report)) {
+            recordCompressError(state, "compressNumericInto", report);
+            return -1;
+        }
+        size_t written = ZL_RES_value(report);
+        env->SetByteArrayRegion(dst, dstOff, static_cast<jsize>(written), reinterpret_cast<const jbyte*>(dstBytes));
+        return static_cast<jint>(written);
+    }
+
+    JNICriticalArray elements(env, src);
+    if (!elements) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to access numeric array");
+        return -1;
+    }
+    CriticalRegionTimer critical;
+    JNICriticalArray output(env, dst);
+    if (!output) {
+        elements.release();
+        critical.stop();
+        throwNew(env, JniRefs().outOfMemoryError, "Failed to access destination array");
+        return -1;
+    }
+    ZL_Report report{};
+    bool allocated = compressNumericRaw(state,
+            static_cast<const uint8_t*>(elements.get()) + static_cast<size_t>(srcOff) * width,
+            width,
+            static_cast<size_t>(srcLen),
+            static_cast<uint8_t*>(output.get()) + dstOff,
+            static_cast<size_t>(dstLen),
+            report);
+    elements.release();
+    bool ok = allocated && !ZL_isError(report);
+    output.release(ok ? 0 : JNI_ABORT);
+    critical.stop();
+
+    if (!allocated) {
+        throwNew(env, JniRefs().outOfMemoryError, "Failed to allocate numeric typed reference");
+        return -1;
+    }
+    if (!ok) {
+        recordCompressError(state, "compressNumericInto", report);
+        return -1;
+    }
+    return static_cast<jint>(ZL_RES_value(report));
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressNumericIntoNative(JNIEnv* env,
+        jobject obj,
+        jbyteArray src,
+        jint srcOff,
+        jint srcLen,
+        jarray dst,
+        jint elementWidth,
+        jint dstOff,
+        jint dstLen)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "decompressNumericInto")) {
+        return -1;
+    }
+    if (!validWidth(env, elementWidth)) {
+        return -1;
+    }
+    if (!checkArrayRange(env, src, srcOff, srcLen, "src")) {
+        return -1;
+    }
+    if (!checkArrayRange(env, dst, dstOff, dstLen, "dst")) {
+        return -1;
+    }
+    size_t width = static_cast<size_t>(elementWidth);
+    size_t threshold = pinningThreshold();
+    if (static_cast<size_t>(srcLen) >= threshold || static_cast<size_t>(dstLen) * width >= threshold) {
+        const uint8_t* frame = copyFrameIn(env, state, src, srcOff, srcLen);
+        if (frame == nullptr) {
+            return -1;
+        }
+        // The header is inspected once, and the declared size checked against the destination
+        // before any scratch is sized from it.
+        size_t elementCount = 0;
+        NumericFrame status = inspectNumericFrame(state,
+                frame,
+                static_cast<size_t>(srcLen),
+                width,
+                "decompressNumericInto",
+                elementCount);
+        if (status == NumericFrame::Failed) {
+            return -1;
+        }
+        if (status != NumericFrame::Ok) {
+            throwNumericFrame(env, status, widthMismatch(width));
+            return -1;
+        }
+        if (!fitsDestination(state, "decompressNumericInto", elementCount, static_cast<size_t>(dstLen))) {
+            return -1;
+        }
+        uint8_t* elements = state->outputScratch.ensure(elementCount * width);
+        if (elements == nullptr) {
+            throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+            return -1;
+        }
+        jint decoded = decodeNumericFrame(state,
+                frame,
+                static_cast<size_t>(srcLen),
+                elements,
+                width,
+                elementCount,
+                "decompressNumericInto",
+                status);
+        if (decoded == -2) {
+            throwNumericFrame(env, status, widthMismatch(width));
+            return -1;
+        }
+        if (decoded > 0) {
+            setNumericRegion(env, dst, dstOff, decoded, width, elements);
+        }
+        return decoded;
+    }
+
+    JNICriticalArray frame(env, src);
+    if (!frame) {
         throwNew(env, JniRefs().outOfMemoryError, "Unable to access compressed payload");
-        return nullptr;
+        return -1;
     }
-    ZL_Report sizeReport = ZL_getDecompressedSize(srcPtr, static_cast<size_t>(len));
-    if (ZL_isError(sizeReport)) {
-        env->ReleasePrimitiveArrayCritical(src, srcPtr, JNI_ABORT);
-        return nullptr;
+    CriticalRegionTimer critical;
+    JNICriticalArray output(env, dst);
+    if (!output) {
+        frame.release();
+        critical.stop();
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to access numeric array");
+        return -1;
     }
-    size_t bufferSize = ZL_RES_value(sizeReport);
-    size_t elementCapacity = bufferSize / sizeof(jint);
-    if (elementCapacity == 0) {
-        elementCapacity = 1;
+    NumericFrame status = NumericFrame::Ok;
+    jint decoded = decompressNumericRaw(state,
+            static_cast<const uint8_t*>(frame.get()) + srcOff,
+            static_cast<size_t>(srcLen),
+            static_cast<uint8_t*>(output.get()) + static_cast<size_t>(dstOff) * width,
+            width,
+            static_cast<size_t>(dstLen),
+            "decompressNumericInto",
+            status);
+    frame.release();
+    output.release(decoded >= 0 ? 0 : JNI_ABORT);
+    critical.stop();
+
+    if (decoded == -2) {
+        throwNumericFrame(env, status, widthMismatch(width));
+        return -1;
     }
-    
-    ZL_OutputInfo info{};
+    return decoded;
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compressNumericDirectNative(JNIEnv* env,
+        jobject obj,
+        jobject src,
+        jint srcPos,
+        jint elementWidth,
+        jint elementCount,
+        jobject dst,
+        jint dstPos,
+        jint dstLen)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "compressNumericDirect")) {
+        return -1;
+    }
+    if (!validWidth(env, elementWidth)) {
+        return -1;
+    }
+    if (elementCount < 0 || elementCount > std::numeric_limits<jint>::max() / elementWidth) {
+        throwIllegalArgument(env, "elementCount out of range");
+        return -1;
+    }
+    if (!ensureDirectRange(env, src, srcPos, elementCount * elementWidth, "src")) {
+        return -1;
+    }
+    if (!ensureDirectRange(env, dst, dstPos, dstLen, "dst")) {
+        return -1;
+    }
+    auto* srcPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(src));
+    auto* dstPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(dst));
+    if (!srcPtr || !dstPtr) {
+        return -1;
+    }
+
     ZL_Report report{};
-    std::vector<jint> buffer;
-    try {
-        buffer.resize(elementCapacity);
-        report = ZL_DCtx_decompressTyped(state->dctx,
-                &info,
-                buffer.data(),
-                buffer.size() * sizeof(jint),
-                srcPtr,
-                static_cast<size_t>(len));
-    } catch (const std::bad_alloc&) {
-        env->ReleasePrimitiveArrayCritical(src, srcPtr, JNI_ABORT);
-        throwNew(env, JniRefs().outOfMemoryError, "Failed to allocate decompression buffer");
-        return nullptr;
+    if (!compressNumericRaw(state,
+                srcPtr + srcPos,
+                static_cast<size_t>(elementWidth),
+                static_cast<size_t>(elementCount),
+                dstPtr + dstPos,
+                static_cast<size_t>(dstLen),
+                report)) {
+        throwNew(env, JniRefs().outOfMemoryError, "Failed to allocate numeric typed reference");
+        return -1;
     }
-    env->ReleasePrimitiveArrayCritical(src, srcPtr, JNI_ABORT);
     if (ZL_isError(report)) {
-        return nullptr;
+        recordCompressError(state, "compressNumericDirect", report);
+        return -1;
     }
-    if (info.type != ZL_Type_numeric || info.fixedWidth != sizeof(jint)) {
-        throwNew(env, JniRefs().illegalStateException, "Compressed stream is not an int array");
-        return nullptr;
+    return static_cast<jint>(ZL_RES_value(report));
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressNumericDirectNative(JNIEnv* env,
+        jobject obj,
+        jobject src,
+        jint srcPos,
+        jint srcLen,
+        jobject dst,
+        jint elementWidth,
+        jint dstPos,
+        jint dstElements)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "decompressNumericDirect")) {
+        return -1;
     }
-    size_t elementCount = info.numElts;
-    if (elementCount > static_cast<size_t>(std::numeric_limits<jsize>::max())) {
-        throwNew(env, JniRefs().illegalStateException, "Decompressed array is too large");
-        return nullptr;
+    if (!validWidth(env, elementWidth)) {
+        return -1;
     }
-    jintArray result = env->NewIntArray(static_cast<jsize>(elementCount));
-    if (result != nullptr && elementCount > 0) {
-        env->SetIntArrayRegion(result,
-                0,
-                static_cast<jsize>(elementCount),
-                buffer.data());
+    if (dstElements < 0 || dstElements > std::numeric_limits<jint>::max() / elementWidth) {
+        throwIllegalArgument(env, "destination element count out of range");
+        return -1;
     }
-    return result;
+    if (!ensureDirectRange(env, src, srcPos, srcLen, "src")) {
+        return -1;
+    }
+    if (!ensureDirectRange(env, dst, dstPos, dstElements * elementWidth, "dst")) {
+        return -1;
+    }
+    auto* srcPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(src));
+    auto* dstPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(dst));
+    if (!srcPtr || !dstPtr) {
+        return -1;
+    }
+
+    size_t width = static_cast<size_t>(elementWidth);
+    NumericFrame status = NumericFrame::Ok;
+    jint decoded = decompressNumericRaw(state,
+            srcPtr + srcPos,
+            static_cast<size_t>(srcLen),
+            dstPtr + dstPos,
+            width,
+            static_cast<size_t>(dstElements),
+            "decompressNumericDirect",
+            status);
+    if (decoded == -2) {
+        throwNumericFrame(env, status, widthMismatch(width));
+        return -1;
+    }
+    return decoded;
 }
 
-extern "C" JNIEXPORT jlongArray JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressLongsNative(JNIEnv* env, jobject obj, jbyteArray src)
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compressNumericBufferNative(JNIEnv* env,
+        jobject obj,
+        jobject src,
+        jint srcPos,
+        jint elementCount,
+        jint elementWidth,
+        jboolean swap,
+        jobject dst,
+        jint dstPos,
+        jint dstLen)
 {
     auto* state = getState(env, obj);
-    if (!ensureState(state, "decompressLongs")) {
-        return nullptr;
+    if (!ensureState(state, "compressNumericBuffer")) {
+        return -1;
     }
-    if (src == nullptr) {
-        throwNew(env, JniRefs().nullPointerException, "compressed");
-        return nullptr;
+    if (!validWidth(env, elementWidth)) {
+        return -1;
     }
-    jsize len = env->GetArrayLength(src);
-    void* srcPtr = env->GetPrimitiveArrayCritical(src, nullptr);
-    if (srcPtr == nullptr) {
-        throwNew(env, JniRefs().outOfMemoryError, "Unable to access compressed payload");
-        return nullptr;
+    // Typed NIO buffers report position and capacity in elements.
+    if (!ensureDirectRange(env, src, srcPos, elementCount, "src")) {
+        return -1;
     }
-    ZL_Report sizeReport = ZL_getDecompressedSize(srcPtr, static_cast<size_t>(len));
-    if (ZL_isError(sizeReport)) {
-        env->ReleasePrimitiveArrayCritical(src, srcPtr, JNI_ABORT);
-        return nullptr;
+    if (!ensureDirectRange(env, dst, dstPos, dstLen, "dst")) {
+        return -1;
     }
-    size_t bufferSize = ZL_RES_value(sizeReport);
-    size_t elementCapacity = bufferSize / sizeof(jlong);
-    if (elementCapacity == 0) {
-        elementCapacity = 1;
+    auto* srcPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(src));
+    auto* dstPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(dst));
+    if (!srcPtr || !dstPtr) {
+        return -1;
+    }
+
+    size_t width = static_cast<size_t>(elementWidth);
+    size_t count = static_cast<size_t>(elementCount);
+    const uint8_t* elements = srcPtr + static_cast<size_t>(srcPos) * width;
+    if (swap == JNI_TRUE) {
+        uint8_t* swapped = state->inputScratch.ensure(count * width);
+        if (swapped == nullptr) {
+            throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+            return -1;
+        }
+        byteSwapElements(swapped, elements, count, width);
+        elements = swapped;
     }
 
-    ZL_OutputInfo info{};
     ZL_Report report{};
-    std::vector<jlong> buffer;
-    try {
-        buffer.resize(elementCapacity);
-        report = ZL_DCtx_decompressTyped(state->dctx,
-                &info,
-                buffer.data(),
-                buffer.size() * sizeof(jlong),
-                srcPtr,
-                static_cast<size_t>(len));
-    } catch (const std::bad_alloc&) {
-        env->ReleasePrimitiveArrayCritical(src, srcPtr, JNI_ABORT);
-        throwNew(env, JniRefs().outOfMemoryError, "Failed to allocate decompression buffer");
-        return nullptr;
+    if (!compressNumericRaw(state, elements, width, count, dstPtr + dstPos, static_cast<size_t>(dstLen), report)) {
+        throwNew(env, JniRefs().outOfMemoryError, "Failed to allocate numeric typed reference");
+        return -1;
     }
-    env->ReleasePrimitiveArrayCritical(src, srcPtr, JNI_ABORT);
     if (ZL_isError(report)) {
-        return nullptr;
+        recordCompressError(state, "compressNumericBuffer", report);
+        return -1;
     }
-    if (info.type != ZL_Type_numeric || info.fixedWidth != sizeof(jlong)) {
-        throwNew(env, JniRefs().illegalStateException, "Compressed stream is not a long array");
-        return nullptr;
+    return static_cast<jint>(ZL_RES_value(report));
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressNumericBufferNative(JNIEnv* env,
+        jobject obj,
+        jobject src,
+        jint srcPos,
+        jint srcLen,
+        jobject dst,
+        jint dstPos,
+        jint dstElements,
+        jint elementWidth,
+        jboolean swap)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "decompressNumericBuffer")) {
+        return -1;
     }
-    size_t elementCount = info.numElts;
-    if (elementCount > static_cast<size_t>(std::numeric_limits<jsize>::max())) {
-        throwNew(env, JniRefs().illegalStateException, "Decompressed array is too large");
-        return nullptr;
+    if (!validWidth(env, elementWidth)) {
+        return -1;
     }
-    jlongArray result = env->NewLongArray(static_cast<jsize>(elementCount));
-    if (result != nullptr && elementCount > 0) {
-        env->SetLongArrayRegion(result,
-                0,
-                static_cast<jsize>(elementCount),
-                buffer.data());
+    if (!ensureDirectRange(env, src, srcPos, srcLen, "src")) {
+        return -1;
     }
-    return result;
+    if (!ensureDirectRange(env, dst, dstPos, dstElements, "dst")) {
+        return -1;
+    }
+    auto* srcPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(src));
+    auto* dstPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(dst));
+    if (!srcPtr || !dstPtr) {
+        return -1;
+    }
+
+    size_t width = static_cast<size_t>(elementWidth);
+    uint8_t* elements = dstPtr + static_cast<size_t>(dstPos) * width;
+    NumericFrame status = NumericFrame::Ok;
+    jint decoded = decompressNumericRaw(state,
+            srcPtr + srcPos,
+            static_cast<size_t>(srcLen),
+            elements,
+            width,
+            static_cast<size_t>(dstElements),
+            "decompressNumericBuffer",
+            status);
+    if (decoded == -2) {
+        throwNumericFrame(env, status, widthMismatch(width));
+        return -1;
+    }
+    if (decoded > 0 && swap == JNI_TRUE) {
+        // Decode in native order, then swap in place; no scratch is needed on this side.
+        byteSwapElements(elements, elements, static_cast<size_t>(decoded), width);
+    }
+    return decoded;
 }
 
-extern "C" JNIEXPORT jfloatArray JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressFloatsNative(JNIEnv* env, jobject obj, jbyteArray src)
+extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressStructsNative(JNIEnv* env,
+        jobject obj,
+        jobject src,
+        jint srcPos,
+        jint srcLen,
+        jint recordWidth)
 {
     auto* state = getState(env, obj);
-    if (!ensureState(state, "decompressFloats")) {
-        return nullptr;
-    }
-    if (src == nullptr) {
-        throwNew(env, JniRefs().nullPointerException, "compressed");
+    if (!ensureState(state, "compressStructs")) {
         return nullptr;
     }
-    jsize len = env->GetArrayLength(src);
-    void* srcPtr = env->GetPrimitiveArrayCritical(src, nullptr);
-    if (srcPtr == nullptr) {
-        throwNew(env, JniRefs().outOfMemoryError, "Unable to access compressed payload");
+    const uint8_t* records = structSource(env, src, srcPos, srcLen, recordWidth);
+    if (records == nullptr) {
         return nullptr;
     }
-    ZL_Report sizeReport = ZL_getDecompressedSize(srcPtr, static_cast<size_t>(len));
-    if (ZL_isError(sizeReport)) {
-        env->ReleasePrimitiveArrayCritical(src, srcPtr, JNI_ABORT);
+    size_t bound = ZL_compressBound(static_cast<size_t>(srcLen));
+    uint8_t* dstPtr = state->outputScratch.ensure(bound);
+    if (dstPtr == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
         return nullptr;
     }
-    size_t bufferSize = ZL_RES_value(sizeReport);
-    size_t elementCapacity = bufferSize / sizeof(jfloat);
-    if (elementCapacity == 0) {
-        elementCapacity = 1;
-    }
-    
-    ZL_OutputInfo info{};
     ZL_Report report{};
-    std::vector<jfloat> buffer;
-    try {
-        buffer.resize(elementCapacity);
-        report = ZL_DCtx_decompressTyped(state->dctx,
-                &info,
-                buffer.data(),
-                buffer.size() * sizeof(jfloat),
-                srcPtr,
-                static_cast<size_t>(len));
-    } catch (const std::bad_alloc&) {
-        env->ReleasePrimitiveArrayCritical(src, srcPtr, JNI_ABORT);
-        throwNew(env, JniRefs().outOfMemoryError, "Failed to allocate decompression buffer");
+    if (!compressStructRaw(state,
+                records,
+                static_cast<size_t>(recordWidth),
+                static_cast<size_t>(srcLen / recordWidth),
+                dstPtr,
+                bound,
+                report)) {
+        throwNew(env, JniRefs().outOfMemoryError, "Failed to allocate struct typed reference");
         return nullptr;
     }
-    env->ReleasePrimitiveArrayCritical(src, srcPtr, JNI_ABORT);
     if (ZL_isError(report)) {
+        recordCompressError(state, "compressStructs", report);
         return nullptr;
     }
-    if (info.type != ZL_Type_numeric || info.fixedWidth != sizeof(jfloat)) {
-        throwNew(env, JniRefs().illegalStateException, "Compressed stream is not a float array");
-        return nullptr;
+    size_t produced = ZL_RES_value(report);
+    state->outputScratch.setSize(produced);
+    jbyteArray result = env->NewByteArray(static_cast<jsize>(produced));
+    if (result != nullptr && produced > 0) {
+        env->SetByteArrayRegion(result, 0, static_cast<jsize>(produced), reinterpret_cast<const jbyte*>(dstPtr));
     }
-    size_t elementCount = info.numElts;
-    if (elementCount > static_cast<size_t>(std::numeric_limits<jsize>::max())) {
-        throwNew(env, JniRefs().illegalStateException, "Decompressed array is too large");
-        return nullptr;
+    return result;
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compressStructsDirectNative(JNIEnv* env,
+        jobject obj,
+        jobject src,
+        jint srcPos,
+        jint srcLen,
+        jint recordWidth,
+        jobject dst,
+        jint dstPos,
+        jint dstLen)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "compressStructsDirect")) {
+        return -1;
     }
-    jfloatArray result = env->NewFloatArray(static_cast<jsize>(elementCount));
-    if (result != nullptr && elementCount > 0) {
-        env->SetFloatArrayRegion(result,
-                0,
-                static_cast<jsize>(elementCount),
-                buffer.data());
+    const uint8_t* records = structSource(env, src, srcPos, srcLen, recordWidth);
+    if (records == nullptr) {
+        return -1;
     }
-    return result;
+    if (!ensureDirectRange(env, dst, dstPos, dstLen, "dst")) {
+        return -1;
+    }
+    auto* dstPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(dst));
+    if (!dstPtr) {
+        return -1;
+    }
+    ZL_Report report{};
+    if (!compressStructRaw(state,
+                records,
+                static_cast<size_t>(recordWidth),
+                static_cast<size_t>(srcLen / recordWidth),
+                dstPtr + dstPos,
+                static_cast<size_t>(dstLen),
+                report)) {
+        throwNew(env, JniRefs().outOfMemoryError, "Failed to allocate struct typed reference");
+        return -1;
+    }
+    if (ZL_isError(report)) {
+        recordCompressError(state, "compressStructsDirect", report);
+        return -1;
+    }
+    return static_cast<jint>(ZL_RES_value(report));
 }
 
-extern "C" JNIEXPORT jdoubleArray JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressDoublesNative(JNIEnv* env, jobject obj, jbyteArray src)
+extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressStructsNative(JNIEnv* env,
+        jobject obj,
+        jbyteArray src)
 {
     auto* state = getState(env, obj);
-    if (!ensureState(state, "decompressDoubles")) {
+    if (!ensureState(state, "decompressStructs")) {
         return nullptr;
     }
     if (src == nullptr) {
@@ -364,57 +1051,162 @@ extern "C" JNIEXPORT jdoubleArray JNICALL Java_io_github_hybledav_OpenZLCompress
         return nullptr;
     }
     jsize len = env->GetArrayLength(src);
-    void* srcPtr = env->GetPrimitiveArrayCritical(src, nullptr);
-    if (srcPtr == nullptr) {
-        throwNew(env, JniRefs().outOfMemoryError, "Unable to access compressed payload");
+    size_t threshold = pinningThreshold();
+    const uint8_t* copied = nullptr;
+    size_t recordCount = 0;
+    size_t recordWidth = 0;
+    NumericFrame status;
+    if (static_cast<size_t>(len) >= threshold) {
+        copied = copyFrameIn(env, state, src, 0, len);
+        if (copied == nullptr) {
+            return nullptr;
+        }
+        status = inspectFixedWidthFrame(state,
+                copied,
+                static_cast<size_t>(len),
+                ZL_Type_struct,
+                "decompressStructs",
+                recordCount,
+                recordWidth);
+    } else if (!inspectPinnedFrame(env, state, src, len, ZL_Type_struct, "decompressStructs", recordCount, recordWidth, status)) {
         return nullptr;
     }
-    ZL_Report sizeReport = ZL_getDecompressedSize(srcPtr, static_cast<size_t>(len));
-    if (ZL_isError(sizeReport)) {
-        env->ReleasePrimitiveArrayCritical(src, srcPtr, JNI_ABORT);
+    if (status == NumericFrame::Ok && recordCount * recordWidth > static_cast<size_t>(std::numeric_limits<jsize>::max())) {
+        status = NumericFrame::TooLarge;
+    }
+    if (status != NumericFrame::Ok) {
+        throwNumericFrame(env, status, STRUCT_MISMATCH);
         return nullptr;
     }
-    size_t bufferSize = ZL_RES_value(sizeReport);
-    size_t elementCapacity = bufferSize / sizeof(jdouble);
-    if (elementCapacity == 0) {
-        elementCapacity = 1;
+    size_t byteSize = recordCount * recordWidth;
+    jbyteArray result = env->NewByteArray(static_cast<jsize>(byteSize));
+    if (result == nullptr || byteSize == 0) {
+        return result;
     }
-    
+
     ZL_OutputInfo info{};
-    ZL_Report report{};
-    std::vector<jdouble> buffer;
-    try {
-        buffer.resize(elementCapacity);
+    ZL_Report report;
+    bool valid;
+    if (copied != nullptr || byteSize >= threshold) {
+        if (copied == nullptr) {
+            copied = copyFrameIn(env, state, src, 0, len);
+            if (copied == nullptr) {
+                return nullptr;
+            }
+        }
+        uint8_t* records = state->outputScratch.ensure(byteSize);
+        if (records == nullptr) {
+            throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate native scratch");
+            return nullptr;
+        }
+        report = ZL_DCtx_decompressTyped(state->dctx, &info, records, byteSize, copied, static_cast<size_t>(len));
+        valid = !ZL_isError(report) && decodedAsExpected(info, recordWidth, recordCount, ZL_Type_struct);
+        if (valid) {
+            env->SetByteArrayRegion(result, 0, static_cast<jsize>(byteSize), reinterpret_cast<const jbyte*>(records));
+        }
+    } else {
+        JNICriticalArray frame(env, src);
+        if (!frame) {
+            throwNew(env, JniRefs().outOfMemoryError, "Unable to access compressed payload");
+            return nullptr;
+        }
+        CriticalRegionTimer critical;
+        JNICriticalArray output(env, result);
+        if (!output) {
+            frame.release();
+            critical.stop();
+            throwNew(env, JniRefs().outOfMemoryError, "Unable to access record array");
+            return nullptr;
+        }
         report = ZL_DCtx_decompressTyped(state->dctx,
                 &info,
-                buffer.data(),
-                buffer.size() * sizeof(jdouble),
-                srcPtr,
+                output.get(),
+                byteSize,
+                frame.get(),
                 static_cast<size_t>(len));
-    } catch (const std::bad_alloc&) {
-        env->ReleasePrimitiveArrayCritical(src, srcPtr, JNI_ABORT);
-        throwNew(env, JniRefs().outOfMemoryError, "Failed to allocate decompression buffer");
-        return nullptr;
+        frame.release();
+        valid = !ZL_isError(report) && decodedAsExpected(info, recordWidth, recordCount, ZL_Type_struct);
+        output.release(valid ? 0 : JNI_ABORT);
+        critical.stop();
     }
-    env->ReleasePrimitiveArrayCritical(src, srcPtr, JNI_ABORT);
+
     if (ZL_isError(report)) {
+        recordDecompressError(state, "decompressStructs", report);
         return nullptr;
     }
-    if (info.type != ZL_Type_numeric || info.fixedWidth != sizeof(jdouble)) {
-        throwNew(env, JniRefs().illegalStateException, "Compressed stream is not a double array");
+    if (!valid) {
+        throwNew(env, JniRefs().illegalStateException, STRUCT_MISMATCH);
         return nullptr;
     }
-    size_t elementCount = info.numElts;
-    if (elementCount > static_cast<size_t>(std::numeric_limits<jsize>::max())) {
-        throwNew(env, JniRefs().illegalStateException, "Decompressed array is too large");
-        return nullptr;
+    return result;
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressStructsDirectNative(JNIEnv* env,
+        jobject obj,
+        jobject src,
+        jint srcPos,
+        jint srcLen,
+        jobject dst,
+        jint dstPos,
+        jint dstLen)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "decompressStructsDirect")) {
+        return -1;
     }
-    jdoubleArray result = env->NewDoubleArray(static_cast<jsize>(elementCount));
-    if (result != nullptr && elementCount > 0) {
-        env->SetDoubleArrayRegion(result,
-                0,
-                static_cast<jsize>(elementCount),
-                buffer.data());
+    if (!ensureDirectRange(env, src, srcPos, srcLen, "src")) {
+        return -1;
     }
-    return result;
+    if (!ensureDirectRange(env, dst, dstPos, dstLen, "dst")) {
+        return -1;
+    }
+    auto* srcPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(src));
+    auto* dstPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(dst));
+    if (!srcPtr || !dstPtr) {
+        return -1;
+    }
+
+    size_t recordCount = 0;
+    size_t recordWidth = 0;
+    NumericFrame status = inspectFixedWidthFrame(state,
+            srcPtr + srcPos,
+            static_cast<size_t>(srcLen),
+            ZL_Type_struct,
+            "decompressStructsDirect",
+            recordCount,
+            recordWidth);
+    if (status == NumericFrame::Failed) {
+        return -1;
+    }
+    if (status != NumericFrame::Ok) {
+        throwNumericFrame(env, status, STRUCT_MISMATCH);
+        return -1;
+    }
+    size_t byteSize = recordCount * recordWidth;
+    if (byteSize == 0) {
+        return 0;
+    }
+    if (byteSize > static_cast<size_t>(dstLen)) {
+        recordError(state,
+                "decompressStructsDirect",
+                static_cast<int>(ZL_ErrorCode_dstCapacity_tooSmall),
+                "destination smaller than the decoded records");
+        return -1;
+    }
+    ZL_OutputInfo info{};
+    ZL_Report report = ZL_DCtx_decompressTyped(state->dctx,
+            &info,
+            dstPtr + dstPos,
+            byteSize,
+            srcPtr + srcPos,
+            static_cast<size_t>(srcLen));
+    if (ZL_isError(report)) {
+        recordDecompressError(state, "decompressStructsDirect", report);
+        return -1;
+    }
+    if (!decodedAsExpected(info, recordWidth, recordCount, ZL_Type_struct)) {
+        throwNew(env, JniRefs().illegalStateException, STRUCT_MISMATCH);
+        return -1;
+    }
+    return static_cast<jint>(byteSize);
 }
@@ -0,0 +1,501 @@
+#include "OpenZLCompressor.h"
+#include "OpenZLNativeSupport.h"
+#include "OpenZLParallel.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+bool checkChunkSize(JNIEnv* env, jint chunkSize)
+{
+    if (chunkSize < static_cast<jint>(kChunkedMinChunkSize)
+            || static_cast<size_t>(chunkSize) > kChunkedMaxChunkSize) {
+        throwIllegalArgument(env, "chunkSize must be between 64 KiB and 1 GiB");
+        return false;
+    }
+    return true;
+}
+
+jlong runChunkedCompress(NativeState* state,
+        const uint8_t* src,
+        size_t srcSize,
+        uint8_t* dst,
+        size_t dstCapacity,
+        jint chunkSize,
+        jint threads)
+{
+    try {
+        return static_cast<jlong>(compressChunkedContainer(
+                state, src, srcSize, dst, dstCapacity, static_cast<size_t>(chunkSize), threads));
+    } catch (const ChunkedError& ex) {
+        recordError(state, "compressParallel", ex.code, ex.what());
+        return -1;
+    } catch (const std::exception& ex) {
+        recordError(state, "compressParallel", ZL_ErrorCode_GENERIC, ex.what());
+        return -1;
+    }
+}
+
+bool readLayout(JNIEnv* env, const uint8_t* src, size_t srcSize, ChunkedLayout& layout)
+{
+    std::string error;
+    if (!parseChunkedContainer(src, srcSize, layout, error)) {
+        throwIllegalArgument(env, error);
+        return false;
+    }
+    return true;
+}
+
+jlong runChunkedDecompress(NativeState* state,
+        const ChunkedLayout& layout,
+        const uint8_t* src,
+        uint8_t* dst,
+        size_t dstCapacity,
+        jint threads,
+        jlong maxInFlightBytes)
+{
+    try {
+        decompressChunkedContainer(state, layout, src, dst, dstCapacity, threads, maxInFlightBytes);
+        return static_cast<jlong>(layout.contentSize);
+    } catch (const ChunkedError& ex) {
+        recordError(state, "decompressParallel", ex.code, ex.what());
+        return -1;
+    } catch (const std::exception& ex) {
+        recordError(state, "decompressParallel", ZL_ErrorCode_GENERIC, ex.what());
+        return -1;
+    }
+}
+
+// Copies the container into the input scratch and validates its entry table. Nothing is sized
+// from the header before this succeeds, and no JNI allocation may follow a critical pin, so the
+// source is copied rather than pinned; below the pinning threshold the copy is small.
+const uint8_t* readArrayContainer(JNIEnv* env,
+        NativeState* state,
+        jbyteArray src,
+        jint srcOff,
+        jint srcLen,
+        ChunkedLayout& layout)
+{
+    uint8_t* srcBytes = state->inputScratch.ensure(static_cast<size_t>(srcLen));
+    if (srcBytes == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate input buffer");
+        return nullptr;
+    }
+    env->GetByteArrayRegion(src, srcOff, srcLen, reinterpret_cast<jbyte*>(srcBytes));
+    if (!readLayout(env, srcBytes, static_cast<size_t>(srcLen), layout)) {
+        return nullptr;
+    }
+    return srcBytes;
+}
+
+// Decodes a validated container into `dst`. Content at or above the pinning threshold goes
+// through the output scratch; smaller content is decoded straight into the pinned array.
+jlong decodeArrayContainer(JNIEnv* env,
+        NativeState* state,
+        const ChunkedLayout& layout,
+        const uint8_t* srcBytes,
+        jbyteArray dst,
+        jint dstOff,
+        jint dstLen,
+        jint threads,
+        jlong maxInFlightBytes)
+{
+    if (layout.contentSize > static_cast<size_t>(dstLen)) {
+        throwIllegalArgument(env, "Destination too small for container content");
+        return -1;
+    }
+    if (layout.contentSize >= pinningThreshold()) {
+        uint8_t* dstBytes = state->outputScratch.ensure(layout.contentSize);
+        if (dstBytes == nullptr) {
+            throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate output buffer");
+            return -1;
+        }
+        jlong written = runChunkedDecompress(state, layout, srcBytes, dstBytes,
+                layout.contentSize, threads, maxInFlightBytes);
+        if (written > 0) {
+            state->outputScratch.setSize(static_cast<size_t>(written));
+            env->SetByteArrayRegion(dst, dstOff, static_cast<jsize>(written), reinterpret_cast<const jbyte*>(dstBytes));
+        }
+        return written;
+    }
+
+    void* dstPtr = env->GetPrimitiveArrayCritical(dst, nullptr);
+    if (dstPtr == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Failed to access destination array");
+        return -1;
+    }
+    CriticalRegionTimer critical;
+    jlong written = runChunkedDecompress(state,
+            layout,
+            srcBytes,
+            static_cast<uint8_t*>(dstPtr) + dstOff,
+            static_cast<size_t>(dstLen),
+            threads,
+            maxInFlightBytes);
+    env->ReleasePrimitiveArrayCritical(dst, dstPtr, written < 0 ? JNI_ABORT : 0);
+    critical.stop();
+    return written;
+}
+
+jlong readContentSize(JNIEnv* env, const uint8_t* src, size_t srcSize)
+{
+    if (srcSize < kChunkedHeaderSize || readLE32(src) != kChunkedMagic) {
+        throwIllegalArgument(env, "Input is not an OpenZL chunked container");
+        return -1;
+    }
+    uint64_t contentSize = readLE64(src + 16);
+    if (contentSize > static_cast<uint64_t>(std::numeric_limits<jlong>::max())) {
+        throwIllegalState(env, "Container content size exceeds jlong capacity");
+        return -1;
+    }
+    return static_cast<jlong>(contentSize);
+}
+
+jlong readArrayContentSize(JNIEnv* env, jbyteArray src, jint srcOff, jint srcLen)
+{
+    if (static_cast<size_t>(srcLen) < kChunkedHeaderSize) {
+        throwIllegalArgument(env, "Input is not an OpenZL chunked container");
+        return -1;
+    }
+    uint8_t header[kChunkedHeaderSize];
+    env->GetByteArrayRegion(src, srcOff, static_cast<jsize>(kChunkedHeaderSize), reinterpret_cast<jbyte*>(header));
+    return readContentSize(env, header, kChunkedHeaderSize);
+}
+
+} // namespace
+
+extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressParallelNative(JNIEnv* env,
+        jobject obj,
+        jbyteArray src,
+        jint srcOff,
+        jint srcLen,
+        jint chunkSize,
+        jint threads)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "compressParallel")) {
+        return nullptr;
+    }
+    if (!checkArrayRange(env, src, srcOff, srcLen, "src") || !checkChunkSize(env, chunkSize)) {
+        return nullptr;
+    }
+
+    size_t bound = chunkedContainerBound(static_cast<size_t>(srcLen), static_cast<size_t>(chunkSize));
+    uint8_t* dstPtr = state->outputScratch.ensure(bound);
+    if (dstPtr == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate output buffer");
+        return nullptr;
+    }
+
+    jlong written;
+    if (static_cast<size_t>(srcLen) >= pinningThreshold()) {
+        // The multithreaded run is far too long to hold a critical region over.
+        uint8_t* srcBytes = state->inputScratch.ensure(static_cast<size_t>(srcLen));
+        if (srcBytes == nullptr) {
+            throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate input buffer");
+            return nullptr;
+        }
+        env->GetByteArrayRegion(src, srcOff, srcLen, reinterpret_cast<jbyte*>(srcBytes));
+        written = runChunkedCompress(state, srcBytes, static_cast<size_t>(srcLen), dstPtr, bound, chunkSize, threads);
+    } else {
+        void* srcPtr = env->GetPrimitiveArrayCritical(src, nullptr);
+        if (srcPtr == nullptr) {
+            throwNew(env, JniRefs().outOfMemoryError, "Failed to access source array");
+            return nullptr;
+        }
+        CriticalRegionTimer critical;
+        written = runChunkedCompress(state,
+                static_cast<const uint8_t*>(srcPtr) + srcOff,
+                static_cast<size_t>(srcLen),
+                dstPtr,
+                bound,
+                chunkSize,
+                threads);
+        env->ReleasePrimitiveArrayCritical(src, srcPtr, JNI_ABORT);
+        critical.stop();
+    }
+    if (written < 0) {
+        return nullptr;
+    }
+    if (written > std::numeric_limits<jsize>::max()) {
+        throwIllegalState(env, "Compressed container exceeds Java array capacity");
+        return nullptr;
+    }
+
+    state->outputScratch.setSize(static_cast<size_t>(written));
+    jbyteArray result = env->NewByteArray(static_cast<jsize>(written));
+    if (result == nullptr) {
+        return nullptr;
+    }
+    env->SetByteArrayRegion(result, 0, static_cast<jsize>(written), reinterpret_cast<const jbyte*>(dstPtr));
+    return result;
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_compressParallelDirect(JNIEnv* env,
+        jobject obj,
+        jobject src,
+        jint srcPos,
+        jint srcLen,
+        jobject dst,
+        jint dstPos,
+        jint dstLen,
+        jint chunkSize,
+        jint threads)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "compressParallel")) {
+        return -1;
+    }
+    if (!ensureDirectRange(env, src, srcPos, srcLen, "src")) {
+        return -1;
+    }
+    if (!ensureDirectRange(env, dst, dstPos, dstLen, "dst")) {
+        return -1;
+    }
+    if (!checkChunkSize(env, chunkSize)) {
+        return -1;
+    }
+
+    auto* srcPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(src));
+    auto* dstPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(dst));
+    if (!srcPtr || !dstPtr) {
+        return -1;
+    }
+
+    jlong written = runChunkedCompress(state,
+            srcPtr + srcPos,
+            static_cast<size_t>(srcLen),
+            dstPtr + dstPos,
+            static_cast<size_t>(dstLen),
+            chunkSize,
+            threads);
+    return static_cast<jint>(written);
+}
+
+extern "C" JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_maxParallelCompressedSizeNative(JNIEnv* env,
+        jclass,
+        jlong inputSize,
+        jint chunkSize)
+{
+    if (inputSize < 0) {
+        throwNew(env, JniRefs().illegalArgumentException, "inputSize must be non-negative");
+        return -1;
+    }
+    if (!checkChunkSize(env, chunkSize)) {
+        return -1;
+    }
+    return static_cast<jlong>(chunkedContainerBound(static_cast<size_t>(inputSize), static_cast<size_t>(chunkSize)));
+}
+
+extern "C" JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_parallelContentSizeNative(JNIEnv* env,
+        jobject,
+        jbyteArray src,
+        jint srcOff,
+        jint srcLen)
+{
+    if (!checkArrayRange(env, src, srcOff, srcLen, "src")) {
+        return -1;
+    }
+    return readArrayContentSize(env, src, srcOff, srcLen);
+}
+
+extern "C" JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_parallelContentSizeDirect(JNIEnv* env,
+        jobject,
+        jobject src,
+        jint srcPos,
+        jint srcLen)
+{
+    if (!ensureDirectRange(env, src, srcPos, srcLen, "src")) {
+        return -1;
+    }
+    auto* srcPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(src));
+    if (!srcPtr) {
+        return -1;
+    }
+    return readContentSize(env, srcPtr + srcPos, static_cast<size_t>(srcLen));
+}
+
+extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressParallelNative(JNIEnv* env,
+        jobject obj,
+        jbyteArray src,
+        jint srcOff,
+        jint srcLen,
+        jint threads,
+        jlong maxInFlightBytes)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "decompressParallel")) {
+        return nullptr;
+    }
+    if (!checkArrayRange(env, src, srcOff, srcLen, "src")) {
+        return nullptr;
+    }
+    ChunkedLayout layout;
+    const uint8_t* srcBytes = readArrayContainer(env, state, src, srcOff, srcLen, layout);
+    if (srcBytes == nullptr) {
+        return nullptr;
+    }
+    if (layout.contentSize > static_cast<size_t>(std::numeric_limits<jsize>::max())) {
+        throwIllegalState(env, "Decompressed content exceeds Java array capacity");
+        return nullptr;
+    }
+
+    jbyteArray result = env->NewByteArray(static_cast<jsize>(layout.contentSize));
+    if (result == nullptr) {
+        return nullptr;
+    }
+    jlong written = decodeArrayContainer(env, state, layout, srcBytes,
+            result, 0, static_cast<jint>(layout.contentSize), threads, maxInFlightBytes);
+    if (written < 0) {
+        env->DeleteLocalRef(result);
+        return nullptr;
+    }
+    return result;
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressParallelIntoNative(JNIEnv* env,
+        jobject obj,
+        jbyteArray src,
+        jint srcOff,
+        jint srcLen,
+        jbyteArray dst,
+        jint dstOff,
+        jint dstLen,
+        jint threads,
+        jlong maxInFlightBytes)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "decompressParallel")) {
+        return -1;
+    }
+    if (!checkArrayRange(env, src, srcOff, srcLen, "src") || !checkArrayRange(env, dst, dstOff, dstLen, "dst")) {
+        return -1;
+    }
+    ChunkedLayout layout;
+    const uint8_t* srcBytes = readArrayContainer(env, state, src, srcOff, srcLen, layout);
+    if (srcBytes == nullptr) {
+        return -1;
+    }
+    return static_cast<jint>(decodeArrayContainer(env, state, layout, srcBytes,
+            dst, dstOff, dstLen, threads, maxInFlightBytes));
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressParallelDirect(JNIEnv* env,
+        jobject obj,
+        jobject src,
+        jint srcPos,
+        jint srcLen,
+        jobject dst,
+        jint dstPos,
+        jint dstLen,
+        jint threads,
+        jlong maxInFlightBytes)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "decompressParallel")) {
+        return -1;
+    }
+    if (!ensureDirectRange(env, src, srcPos, srcLen, "src")) {
+        return -1;
+    }
+    if (!ensureDirectRange(env, dst, dstPos, dstLen, "dst")) {
+        return -1;
+    }
+
+    auto* srcPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(src));
+    auto* dstPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(dst));
+    if (!srcPtr || !dstPtr) {
+        return -1;
+    }
+    ChunkedLayout layout;
+    if (!readLayout(env, srcPtr + srcPos, static_cast<size_t>(srcLen), layout)) {
+        return -1;
+    }
+    if (layout.contentSize > static_cast<size_t>(dstLen)) {
+        throwIllegalArgument(env, "Destination too small for container content");
+        return -1;
+    }
+    return static_cast<jint>(runChunkedDecompress(state, layout, srcPtr + srcPos, dstPtr + dstPos,
+            static_cast<size_t>(dstLen), threads, maxInFlightBytes));
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressRangeDirect(JNIEnv* env,
+        jobject obj,
+        jobject src,
+        jint srcPos,
+        jint srcLen,
+        jlong offset,
+        jint length,
+        jobject dst,
+        jint dstPos,
+        jint dstLen,
+        jint threads)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "decompressRange")) {
+        return -1;
+    }
+    if (!ensureDirectRange(env, src, srcPos, srcLen, "src")) {
+        return -1;
+    }
+    if (!ensureDirectRange(env, dst, dstPos, dstLen, "dst")) {
+        return -1;
+    }
+    if (offset < 0 || length < 0) {
+        throwIllegalArgument(env, "offset and length must be non-negative");
+        return -1;
+    }
+
+    auto* srcPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(src));
+    auto* dstPtr = static_cast<uint8_t*>(env->GetDirectBufferAddress(dst));
+    if (!srcPtr || !dstPtr) {
+        return -1;
+    }
+    std::string error;
+    auto layout = cachedChunkedLayout(srcPtr + srcPos, static_cast<size_t>(srcLen), error);
+    if (!layout) {
+        throwIllegalArgument(env, error);
+        return -1;
+    }
+    return decodeContainerRange(env, state, *layout, srcPtr + srcPos, offset, length, dstPtr + dstPos, dstLen, threads);
+}
+
+jint decodeContainerRange(JNIEnv* env,
+        NativeState* state,
+        const ChunkedLayout& layout,
+        const uint8_t* src,
+        jlong offset,
+        jint length,
+        uint8_t* dst,
+        jint dstLen,
+        jint threads)
+{
+    if (static_cast<uint64_t>(offset) > layout.contentSize) {
+        throwIllegalArgument(env, "offset is past the end of the container content");
+        return -1;
+    }
+    // Ranges running past the end are clipped to the content, like a short read.
+    size_t start = static_cast<size_t>(offset);
+    size_t count = std::min(static_cast<size_t>(length), layout.contentSize - start);
+    if (count > static_cast<size_t>(dstLen)) {
+        throwIllegalArgument(env, "Destination too small for the requested range");
+        return -1;
+    }
+    try {
+        decompressChunkedRange(state, layout, src, start, count, dst, threads);
+    } catch (const ChunkedError& ex) {
+        recordError(state, "decompressRange", ex.code, ex.what());
+        return -1;
+    } catch (const std::exception& ex) {
+        recordError(state, "decompressRange", ZL_ErrorCode_GENERIC, ex.what());
+        return -1;
+    }
+    return static_cast<jint>(count);
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_cachedContainerIndexCountNative(JNIEnv*, jclass)
+{
+    return static_cast<jint>(cachedChunkedLayoutCount());
+}
@@ -0,0 +1,205 @@
+#include "OpenZLCompressor.h"
+#include "OpenZLNativeSupport.h"
+#include "openzl/zl_compress.h"
+#include "openzl/zl_decompress.h"
+#include <algorithm>
+#include <limits>
+#include <new>
+
+namespace {
+
+constexpr size_t kFramePrefixSize = 4;
+
+// Native side of OpenZLOutputStream/OpenZLInputStream. `input` accumulates raw bytes until a
+// chunk is full; `output` holds either the length-prefixed frame being written out or the chunk
+// being read back. Both are sized by the chunk, never by the payload.
+struct StreamBuffer {
+    NativeState::ScratchBuffer input;
+    NativeState::ScratchBuffer output;
+    size_t chunkSize = 0;
+};
+
+StreamBuffer* streamBuffer(JNIEnv* env, jlong handle)
+{
+    if (handle == 0) {
+        throwNew(env, JniRefs().illegalStateException, "Stream already closed");
+        return nullptr;
+    }
+    return reinterpret_cast<StreamBuffer*>(handle);
+}
+
+void writeFramePrefix(uint8_t* dst, size_t frameSize)
+{
+    for (size_t i = 0; i < kFramePrefixSize; ++i) {
+        dst[i] = static_cast<uint8_t>(frameSize >> (8 * i));
+    }
+}
+
+} // namespace
+
+extern "C" JNIEXPORT jlong JNICALL Java_io_github_hybledav_OpenZLCompressor_streamBufferCreateNative(JNIEnv* env,
+        jclass,
+        jint chunkSize)
+{
+    if (chunkSize <= 0) {
+        throwIllegalArgument(env, "chunkSize must be positive");
+        return 0;
+    }
+    auto* buffer = new (std::nothrow) StreamBuffer();
+    if (buffer == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate stream buffer");
+        return 0;
+    }
+    buffer->chunkSize = static_cast<size_t>(chunkSize);
+    return reinterpret_cast<jlong>(buffer);
+}
+
+extern "C" JNIEXPORT void JNICALL Java_io_github_hybledav_OpenZLCompressor_streamBufferDestroyNative(JNIEnv*,
+        jclass,
+        jlong handle)
+{
+    delete reinterpret_cast<StreamBuffer*>(handle);
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_streamAppendNative(JNIEnv* env,
+        jclass,
+        jlong handle,
+        jbyteArray src,
+        jint srcOff,
+        jint srcLen)
+{
+    auto* buffer = streamBuffer(env, handle);
+    if (buffer == nullptr || !checkArrayRange(env, src, srcOff, srcLen, "src")) {
+        return -1;
+    }
+    auto& input = buffer->input;
+    if (input.ensure(buffer->chunkSize) == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate stream chunk");
+        return -1;
+    }
+    size_t take = std::min(static_cast<size_t>(srcLen), buffer->chunkSize - input.size);
+    if (take > 0) {
+        env->GetByteArrayRegion(src, srcOff, static_cast<jsize>(take),
+                reinterpret_cast<jbyte*>(input.ptr() + input.size));
+        input.setSize(input.size + take);
+    }
+    return static_cast<jint>(take);
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_streamCompressNative(JNIEnv* env,
+        jobject obj,
+        jlong handle)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "streamCompress")) {
+        return -1;
+    }
+    auto* buffer = streamBuffer(env, handle);
+    if (buffer == nullptr) {
+        return -1;
+    }
+    auto& input = buffer->input;
+    auto& output = buffer->output;
+    size_t bound = ZL_compressBound(input.size);
+    uint8_t* dst = output.ensure(kFramePrefixSize + bound);
+    if (dst == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate stream frame");
+        return -1;
+    }
+
+    ZL_Report result = ZL_CCtx_compress(state->cctx,
+            dst + kFramePrefixSize,
+            bound,
+            input.ptr(),
+            input.size);
+    if (ZL_isError(result)) {
+        recordCompressError(state, "streamCompress", result);
+        return -1;
+    }
+
+    size_t frameSize = ZL_RES_value(result);
+    if (frameSize > static_cast<size_t>(std::numeric_limits<jint>::max()) - kFramePrefixSize) {
+        throwIllegalState(env, "Stream frame exceeds jint capacity");
+        return -1;
+    }
+    writeFramePrefix(dst, frameSize);
+    output.setSize(kFramePrefixSize + frameSize);
+    input.reset();
+    return static_cast<jint>(output.size);
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_streamDecompressNative(JNIEnv* env,
+        jobject obj,
+        jlong handle,
+        jbyteArray frame,
+        jint frameOff,
+        jint frameLen)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "streamDecompress")) {
+        return -1;
+    }
+    auto* buffer = streamBuffer(env, handle);
+    if (buffer == nullptr || !checkArrayRange(env, frame, frameOff, frameLen, "frame")) {
+        return -1;
+    }
+
+    ByteArrayInput input(env, frame, frameOff, frameLen, state->inputScratch);
+    if (!input) {
+        return -1;
+    }
+    const uint8_t* src = input.data();
+    ZL_Report sizeReport = ZL_getDecompressedSize(src, static_cast<size_t>(frameLen));
+    // A writer never emits a frame larger than its chunk, so the chunk size bounds the buffer.
+    if (ZL_isError(sizeReport) || ZL_RES_value(sizeReport) > buffer->chunkSize) {
+        input.release();
+        recordError(state,
+                "streamDecompress",
+                ZL_isError(sizeReport) ? static_cast<int>(ZL_RES_code(sizeReport)) : ZL_ErrorCode_srcSize_tooLarge,
+                "stream frame decodes to more than the chunk size");
+        return -1;
+    }
+
+    auto& output = buffer->output;
+    size_t outCap = ZL_RES_value(sizeReport);
+    uint8_t* dst = output.ensure(outCap);
+    if (dst == nullptr) {
+        input.release();
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate stream chunk");
+        return -1;
+    }
+    ZL_Report result = ZL_DCtx_decompress(state->dctx, dst, outCap, src, static_cast<size_t>(frameLen));
+    input.release();
+
+    if (ZL_isError(result)) {
+        recordDecompressError(state, "streamDecompress", result);
+        return -1;
+    }
+    output.setSize(ZL_RES_value(result));
+    return static_cast<jint>(output.size);
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_streamReadNative(JNIEnv* env,
+        jclass,
+        jlong handle,
+        jint position,
+        jbyteArray dst,
+        jint dstOff,
+        jint dstLen)
+{
+    auto* buffer = streamBuffer(env, handle);
+    if (buffer == nullptr || !checkArrayRange(env, dst, dstOff, dstLen, "dst")) {
+        return -1;
+    }
+    auto& output = buffer->output;
+    if (position < 0 || static_cast<size_t>(position) > output.size) {
+        throwIllegalArgument(env, "position outside of the buffered chunk");
+        return -1;
+    }
+    size_t count = std::min(static_cast<size_t>(dstLen), output.size - static_cast<size_t>(position));
+    if (count > 0) {
+        env->SetByteArrayRegion(dst, dstOff, static_cast<jsize>(count),
+                reinterpret_cast<const jbyte*>(output.ptr() + position));
+    }
+    return static_cast<jint>(count);
+}
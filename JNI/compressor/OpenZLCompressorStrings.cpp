@@ -0,0 +1,427 @@
+#include "OpenZLCompressor.h"
+#include "OpenZLNativeSupport.h"
+#include "OpenZLUtf8.h"
+#include "openzl/zl_compress.h"
+#include "openzl/zl_data.h"
+#include "openzl/zl_decompress.h"
+#include <limits>
+
+namespace {
+
+// Compresses a string typed ref into the output scratch. Makes no JNI calls, so the content may
+// still be pinned. Returns false only when the output or the typed reference cannot be allocated.
+bool compressStringsRaw(NativeState* state,
+        const void* content,
+        size_t contentSize,
+        const uint32_t* lengths,
+        size_t count,
+        ZL_Report& report)
+{
+    size_t bound = ZL_compressBound(contentSize + count * sizeof(uint32_t));
+    uint8_t* dstPtr = state->outputScratch.ensure(bound);
+    if (dstPtr == nullptr) {
+        return false;
+    }
+    ZL_TypedRef* typedRef = ZL_TypedRef_createString(content, contentSize, lengths, count);
+    if (typedRef == nullptr) {
+        return false;
+    }
+    report = ZL_CCtx_compressTypedRef(state->cctx, dstPtr, bound, typedRef);
+    ZL_TypedRef_free(typedRef);
+    if (!ZL_isError(report)) {
+        state->outputScratch.setSize(ZL_RES_value(report));
+    }
+    return true;
+}
+
+jbyteArray finishCompressStrings(JNIEnv* env, NativeState* state, bool allocated, ZL_Report report)
+{
+    if (!allocated) {
+        throwNew(env, JniRefs().outOfMemoryError, "Failed to allocate string compression buffers");
+        return nullptr;
+    }
+    if (ZL_isError(report)) {
+        recordCompressError(state, "compressStrings", report);
+        return nullptr;
+    }
+    size_t produced = ZL_RES_value(report);
+    jbyteArray result = env->NewByteArray(static_cast<jsize>(produced));
+    if (result != nullptr && produced > 0) {
+        env->SetByteArrayRegion(result,
+                0,
+                static_cast<jsize>(produced),
+                reinterpret_cast<const jbyte*>(state->outputScratch.ptr()));
+    }
+    return result;
+}
+
+// True when `lens` are non-negative and add up to exactly `contentSize`.
+bool lengthsMatch(const jint* lens, size_t count, size_t contentSize)
+{
+    size_t sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (lens[i] < 0 || static_cast<size_t>(lens[i]) > contentSize - sum) {
+            return false;
+        }
+        sum += static_cast<size_t>(lens[i]);
+    }
+    return sum == contentSize;
+}
+
+// Above the pinning threshold the lengths table and the packed content are copied into the
+// input scratch, laid out as compressStringArrayNative gathers them.
+jbyteArray compressStringsCopying(JNIEnv* env,
+        NativeState* state,
+        jbyteArray packed,
+        size_t contentSize,
+        jintArray lengths,
+        size_t count)
+{
+    size_t tableBytes = (count * sizeof(uint32_t) + 7) & ~size_t{ 7 };
+    uint8_t* scratch = state->inputScratch.ensure(tableBytes + contentSize);
+    if (scratch == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate string scratch");
+        return nullptr;
+    }
+    auto* lens = reinterpret_cast<jint*>(scratch);
+    uint8_t* content = scratch + tableBytes;
+    if (count > 0) {
+        env->GetIntArrayRegion(lengths, 0, static_cast<jsize>(count), lens);
+    }
+    if (contentSize > 0) {
+        env->GetByteArrayRegion(packed, 0, static_cast<jsize>(contentSize), reinterpret_cast<jbyte*>(content));
+    }
+    if (!lengthsMatch(lens, count, contentSize)) {
+        throwIllegalArgument(env, "lengths must be non-negative and sum to packed.length");
+        return nullptr;
+    }
+    ZL_Report report{};
+    bool allocated = compressStringsRaw(state,
+            content,
+            contentSize,
+            reinterpret_cast<const uint32_t*>(lens),
+            count,
+            report);
+    return finishCompressStrings(env, state, allocated, report);
+}
+
+// Decodes a string frame into caller-provided content and lengths buffers. Makes no JNI calls.
+// Returns false only when the output buffer cannot be wrapped.
+bool decompressStringsRaw(NativeState* state,
+        const void* frame,
+        size_t frameSize,
+        void* content,
+        size_t contentCapacity,
+        uint32_t* lengths,
+        size_t lengthsCapacity,
+        ZL_Report& report,
+        size_t& produced)
+{
+    ZL_TypedBuffer* output = ZL_TypedBuffer_createWrapString(content, contentCapacity, lengths, lengthsCapacity);
+    if (output == nullptr) {
+        return false;
+    }
+    report = ZL_DCtx_decompressTBuffer(state->dctx, output, frame, frameSize);
+    if (!ZL_isError(report)) {
+        produced = ZL_TypedBuffer_numElts(output);
+    }
+    ZL_TypedBuffer_free(output);
+    return true;
+}
+
+jint finishDecompressStrings(JNIEnv* env, NativeState* state, bool wrapped, ZL_Report report, size_t produced)
+{
+    if (!wrapped) {
+        throwNew(env, JniRefs().outOfMemoryError, "Failed to allocate string output buffer");
+        return -1;
+    }
+    if (ZL_isError(report)) {
+        recordDecompressError(state, "decompressStrings", report);
+        return -1;
+    }
+    return static_cast<jint>(produced);
+}
+
+// Above the pinning threshold the frame is copied into the input scratch and decoded into the
+// output scratch (lengths table first, then content), which is then copied out to the arrays.
+jint decompressStringsCopying(JNIEnv* env,
+        NativeState* state,
+        jbyteArray src,
+        jsize srcLen,
+        jbyteArray content,
+        size_t contentCapacity,
+        jintArray lengths,
+        size_t lengthsCapacity)
+{
+    uint8_t* frame = state->inputScratch.ensure(static_cast<size_t>(srcLen));
+    size_t tableBytes = (lengthsCapacity * sizeof(uint32_t) + 7) & ~size_t{ 7 };
+    uint8_t* output = state->outputScratch.ensure(tableBytes + contentCapacity);
+    if (frame == nullptr || output == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate string scratch");
+        return -1;
+    }
+    if (srcLen > 0) {
+        env->GetByteArrayRegion(src, 0, srcLen, reinterpret_cast<jbyte*>(frame));
+    }
+    auto* lens = reinterpret_cast<uint32_t*>(output);
+    uint8_t* bytes = output + tableBytes;
+    ZL_Report report{};
+    size_t produced = 0;
+    bool wrapped = decompressStringsRaw(state,
+            frame,
+            static_cast<size_t>(srcLen),
+            bytes,
+            contentCapacity,
+            lens,
+            lengthsCapacity,
+            report,
+            produced);
+    if (!wrapped || ZL_isError(report)) {
+        return finishDecompressStrings(env, state, wrapped, report, produced);
+    }
+    size_t contentSize = 0;
+    for (size_t i = 0; i < produced; ++i) {
+        contentSize += lens[i];
+    }
+    if (produced > 0) {
+        env->SetIntArrayRegion(lengths, 0, static_cast<jsize>(produced), reinterpret_cast<const jint*>(lens));
+    }
+    if (contentSize > 0) {
+        env->SetByteArrayRegion(content, 0, static_cast<jsize>(contentSize), reinterpret_cast<const jbyte*>(bytes));
+    }
+    return static_cast<jint>(produced);
+}
+
+} // namespace
+
+extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressStringArrayNative(JNIEnv* env,
+        jobject obj,
+        jobjectArray strings,
+        jlong totalBytes)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "compressStrings")) {
+        return nullptr;
+    }
+    if (strings == nullptr) {
+        throwNew(env, JniRefs().nullPointerException, "strings");
+        return nullptr;
+    }
+    if (totalBytes < 0) {
+        throwIllegalArgument(env, "totalBytes must be non-negative");
+        return nullptr;
+    }
+    // OpenZL needs the content contiguous, so the elements are gathered once into the input
+    // scratch: the lengths table first, keeping it aligned, then the content.
+    size_t count = static_cast<size_t>(env->GetArrayLength(strings));
+    size_t tableBytes = (count * sizeof(uint32_t) + 7) & ~size_t{ 7 };
+    size_t contentSize = static_cast<size_t>(totalBytes);
+    uint8_t* scratch = state->inputScratch.ensure(tableBytes + contentSize);
+    if (scratch == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate string scratch");
+        return nullptr;
+    }
+    auto* lengths = reinterpret_cast<uint32_t*>(scratch);
+    uint8_t* content = scratch + tableBytes;
+
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        auto element = static_cast<jbyteArray>(env->GetObjectArrayElement(strings, static_cast<jsize>(i)));
+        if (element == nullptr) {
+            throwNew(env, JniRefs().nullPointerException, "strings element is null");
+            return nullptr;
+        }
+        jsize length = env->GetArrayLength(element);
+        if (static_cast<size_t>(length) > contentSize - offset) {
+            env->DeleteLocalRef(element);
+            throwIllegalArgument(env, "strings changed while being compressed");
+            return nullptr;
+        }
+        env->GetByteArrayRegion(element, 0, length, reinterpret_cast<jbyte*>(content + offset));
+        env->DeleteLocalRef(element);
+        lengths[i] = static_cast<uint32_t>(length);
+        offset += static_cast<size_t>(length);
+    }
+
+    ZL_Report report{};
+    bool allocated = compressStringsRaw(state, content, offset, lengths, count, report);
+    return finishCompressStrings(env, state, allocated, report);
+}
+
+extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressTextArrayNative(JNIEnv* env,
+        jobject obj,
+        jobjectArray strings,
+        jlong totalChars)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "compressStrings")) {
+        return nullptr;
+    }
+    if (strings == nullptr) {
+        throwNew(env, JniRefs().nullPointerException, "strings");
+        return nullptr;
+    }
+    if (totalChars < 0) {
+        throwIllegalArgument(env, "totalChars must be non-negative");
+        return nullptr;
+    }
+    // Each element is transcoded straight from the String's UTF-16 into the content area, after
+    // the lengths table, so no byte[] is materialised per element.
+    size_t count = static_cast<size_t>(env->GetArrayLength(strings));
+    size_t tableBytes = (count * sizeof(uint32_t) + 7) & ~size_t{ 7 };
+    size_t charBudget = static_cast<size_t>(totalChars);
+    uint8_t* scratch = state->inputScratch.ensure(tableBytes + maxUtf8Length(charBudget));
+    if (scratch == nullptr) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to allocate string scratch");
+        return nullptr;
+    }
+    auto* lengths = reinterpret_cast<uint32_t*>(scratch);
+    uint8_t* content = scratch + tableBytes;
+
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        auto element = static_cast<jstring>(env->GetObjectArrayElement(strings, static_cast<jsize>(i)));
+        if (element == nullptr) {
+            throwNew(env, JniRefs().nullPointerException, "strings element is null");
+            return nullptr;
+        }
+        size_t length = static_cast<size_t>(env->GetStringLength(element));
+        if (length > charBudget) {
+            env->DeleteLocalRef(element);
+            throwIllegalArgument(env, "strings changed while being compressed");
+            return nullptr;
+        }
+        charBudget -= length;
+        const jchar* chars = env->GetStringCritical(element, nullptr);
+        if (chars == nullptr) {
+            env->DeleteLocalRef(element);
+            throwNew(env, JniRefs().outOfMemoryError, "GetStringCritical returned null");
+            return nullptr;
+        }
+        CriticalRegionTimer critical;
+        size_t written = utf16ToUtf8(reinterpret_cast<const uint16_t*>(chars), length, content + offset);
+        env->ReleaseStringCritical(element, chars);
+        critical.stop();
+        env->DeleteLocalRef(element);
+        lengths[i] = static_cast<uint32_t>(written);
+        offset += written;
+    }
+
+    ZL_Report report{};
+    bool allocated = compressStringsRaw(state, content, offset, lengths, count, report);
+    return finishCompressStrings(env, state, allocated, report);
+}
+
+extern "C" JNIEXPORT jbyteArray JNICALL Java_io_github_hybledav_OpenZLCompressor_compressStringsNative(JNIEnv* env,
+        jobject obj,
+        jbyteArray packed,
+        jintArray lengths)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "compressStrings")) {
+        return nullptr;
+    }
+    if (packed == nullptr || lengths == nullptr) {
+        throwNew(env, JniRefs().nullPointerException, packed == nullptr ? "packed" : "lengths");
+        return nullptr;
+    }
+    size_t contentSize = static_cast<size_t>(env->GetArrayLength(packed));
+    size_t count = static_cast<size_t>(env->GetArrayLength(lengths));
+    if (contentSize + count * sizeof(uint32_t) >= pinningThreshold()) {
+        return compressStringsCopying(env, state, packed, contentSize, lengths, count);
+    }
+
+    // jint and uint32_t share a layout, so the caller's lengths are handed to OpenZL as they are.
+    JNICriticalArray content(env, packed);
+    if (!content) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to access packed strings");
+        return nullptr;
+    }
+    CriticalRegionTimer critical;
+    JNICriticalArray table(env, lengths);
+    if (!table) {
+        content.release();
+        critical.stop();
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to access string lengths");
+        return nullptr;
+    }
+    auto* lens = static_cast<const jint*>(table.get());
+    bool consistent = lengthsMatch(lens, count, contentSize);
+    ZL_Report report{};
+    bool allocated = true;
+    if (consistent) {
+        allocated = compressStringsRaw(state,
+                content.get(),
+                contentSize,
+                reinterpret_cast<const uint32_t*>(lens),
+                count,
+                report);
+    }
+    table.release();
+    content.release();
+    critical.stop();
+
+    if (!consistent) {
+        throwIllegalArgument(env, "lengths must be non-negative and sum to packed.length");
+        return nullptr;
+    }
+    return finishCompressStrings(env, state, allocated, report);
+}
+
+extern "C" JNIEXPORT jint JNICALL Java_io_github_hybledav_OpenZLCompressor_decompressStringsNative(JNIEnv* env,
+        jobject obj,
+        jbyteArray src,
+        jbyteArray content,
+        jintArray lengths)
+{
+    auto* state = getState(env, obj);
+    if (!ensureState(state, "decompressStrings")) {
+        return -1;
+    }
+    if (src == nullptr || content == nullptr || lengths == nullptr) {
+        throwNew(env, JniRefs().nullPointerException, "decompressStrings argument is null");
+        return -1;
+    }
+    jsize srcLen = env->GetArrayLength(src);
+    size_t contentCapacity = static_cast<size_t>(env->GetArrayLength(content));
+    size_t lengthsCapacity = static_cast<size_t>(env->GetArrayLength(lengths));
+    if (static_cast<size_t>(srcLen) + contentCapacity + lengthsCapacity * sizeof(uint32_t) >= pinningThreshold()) {
+        return decompressStringsCopying(env, state, src, srcLen, content, contentCapacity, lengths, lengthsCapacity);
+    }
+
+    // The Java arrays were sized from the frame header, so OpenZL decodes straight into them.
+    JNICriticalArray frame(env, src);
+    if (!frame) {
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to access compressed payload");
+        return -1;
+    }
+    CriticalRegionTimer critical;
+    JNICriticalArray contentPin(env, content);
+    JNICriticalArray lengthsPin(env, lengths);
+    if (!contentPin || !lengthsPin) {
+        lengthsPin.release();
+        contentPin.release();
+        frame.release();
+        critical.stop();
+        throwNew(env, JniRefs().outOfMemoryError, "Unable to access string output arrays");
+        return -1;
+    }
+    ZL_Report report{};
+    size_t produced = 0;
+    bool wrapped = decompressStringsRaw(state,
+            frame.get(),
+            static_cast<size_t>(srcLen),
+            contentPin.get(),
+            contentCapacity,
+            static_cast<uint32_t*>(lengthsPin.get()),
+            lengthsCapacity,
+            report,
+            produced);
+    bool ok = wrapped && !ZL_isError(report);
+    lengthsPin.release(ok ? 0 : JNI_ABORT);
+    contentPin.release(ok ? 0 : JNI_ABORT);
+    frame.release();
+    critical.stop();
+
+    return finishDecompressStrings(env, state, wrapped, report, produced);
+}
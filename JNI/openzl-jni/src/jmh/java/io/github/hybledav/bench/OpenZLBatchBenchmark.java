@@ -0,0 +1,132 @@
+package io.github.hybledav.bench;
+
+import io.github.hybledav.OpenZLCompressor;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OperationsPerInvocation;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+
+import java.util.Arrays;
+import java.util.Random;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Per-message cost of the batch entry points against one JNI call per payload. Every
+ * benchmark handles {@link #MESSAGES} payloads per invocation, so the reported score is
+ * the average cost of a single message.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.NANOSECONDS)
+@Fork(value = 1, jvmArgsAppend = {"-Xms1g", "-Xmx1g"})
+public class OpenZLBatchBenchmark {
+
+    static final int MESSAGES = 256;
+
+    @State(Scope.Thread)
+    public static class BatchState {
+
+        @Param({"200", "1024", "4096"})
+        public int messageBytes;
+
+        OpenZLCompressor compressor;
+        byte[] packed;
+        int[] offsets;
+        int[] lengths;
+        byte[] compressed;
+        int[] frameStarts;
+        int[] frameLengths;
+        int[] batchOffsets;
+        byte[] restored;
+        int[] restoredOffsets;
+        byte[] scratch;
+
+        @Setup(Level.Trial)
+        public void setUp() {
+            compressor = new OpenZLCompressor();
+            Random random = new Random(0xBA7C4L);
+            packed = new byte[MESSAGES * messageBytes];
+            for (int i = 0; i < packed.length; ++i) {
+                packed[i] = (byte) ('a' + random.nextInt(8));
+            }
+            offsets = new int[MESSAGES];
+            lengths = new int[MESSAGES];
+            for (int i = 0; i < MESSAGES; ++i) {
+                offsets[i] = i * messageBytes;
+                lengths[i] = messageBytes;
+            }
+            compressed = new byte[(int) OpenZLCompressor.maxCompressedBatchSize(lengths)];
+            batchOffsets = new int[MESSAGES + 1];
+            compressor.compressBatch(packed, offsets, lengths, compressed, 0, batchOffsets);
+            frameStarts = new int[MESSAGES];
+            frameLengths = new int[MESSAGES];
+            for (int i = 0; i < MESSAGES; ++i) {
+                frameStarts[i] = batchOffsets[i];
+                frameLengths[i] = batchOffsets[i + 1] - batchOffsets[i];
+            }
+            restored = new byte[packed.length];
+            restoredOffsets = new int[MESSAGES + 1];
+            scratch = new byte[compressed.length];
+        }
+
+        @TearDown(Level.Trial)
+        public void tearDown() {
+            compressor.close();
+        }
+    }
+
+    @Benchmark
+    @OperationsPerInvocation(MESSAGES)
+    public int compressSingleCalls(BatchState state) {
+        int written = 0;
+        for (int i = 0; i < MESSAGES; ++i) {
+            written += state.compressor.compress(state.packed, state.offsets[i], state.lengths[i],
+                    state.scratch, written, state.scratch.length - written);
+        }
+        return written;
+    }
+
+    @Benchmark
+    @OperationsPerInvocation(MESSAGES)
+    public int compressAllocatingCalls(BatchState state) {
+        int written = 0;
+        for (int i = 0; i < MESSAGES; ++i) {
+            byte[] message = Arrays.copyOfRange(state.packed,
+                    state.offsets[i], state.offsets[i] + state.lengths[i]);
+            written += state.compressor.compress(message).length;
+        }
+        return written;
+    }
+
+    @Benchmark
+    @OperationsPerInvocation(MESSAGES)
+    public int compressBatch(BatchState state) {
+        return state.compressor.compressBatch(state.packed, state.offsets, state.lengths,
+                state.scratch, 0, state.batchOffsets);
+    }
+
+    @Benchmark
+    @OperationsPerInvocation(MESSAGES)
+    public int decompressSingleCalls(BatchState state) {
+        int written = 0;
+        for (int i = 0; i < MESSAGES; ++i) {
+            written += state.compressor.decompress(state.compressed, state.frameStarts[i], state.frameLengths[i],
+                    state.restored, written, state.restored.length - written);
+        }
+        return written;
+    }
+
+    @Benchmark
+    @OperationsPerInvocation(MESSAGES)
+    public int decompressBatch(BatchState state) {
+        return state.compressor.decompressBatch(state.compressed, state.frameStarts, state.frameLengths,
+                state.restored, 0, state.restoredOffsets);
+    }
+}
@@ -0,0 +1,81 @@
+package io.github.hybledav.bench;
+
+import io.github.hybledav.OpenZLCompressor;
+import io.github.hybledav.OpenZLGraph;
+import org.openjdk.jmh.annotations.Benchmark;
+import org.openjdk.jmh.annotations.BenchmarkMode;
+import org.openjdk.jmh.annotations.Fork;
+import org.openjdk.jmh.annotations.Level;
+import org.openjdk.jmh.annotations.Mode;
+import org.openjdk.jmh.annotations.OutputTimeUnit;
+import org.openjdk.jmh.annotations.Param;
+import org.openjdk.jmh.annotations.Scope;
+import org.openjdk.jmh.annotations.Setup;
+import org.openjdk.jmh.annotations.State;
+import org.openjdk.jmh.annotations.TearDown;
+
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+
+/**
+ * Contention on the native state pool: {@link #threads} workers each open a compressor,
+ * compress a short message and close it again, {@link #CYCLES_PER_THREAD} times per
+ * invocation. The score is the wall time of one invocation, so flat scores across thread
+ * counts mean the pool scales.
+ */
+@BenchmarkMode(Mode.AverageTime)
+@OutputTimeUnit(TimeUnit.MICROSECONDS)
+@Fork(value = 1, jvmArgsAppend = {"-Xms512m", "-Xmx512m"})
+@State(Scope.Benchmark)
+public class OpenZLStatePoolBenchmark {
+
+    static final int CYCLES_PER_THREAD = 512;
+
+    @Param({"1", "2", "4", "8", "16", "32", "64"})
+    public int threads;
+
+    @Param({"1", "4"})
+    public int distinctGraphs;
+
+    private ExecutorService executor;
+    private byte[] message;
+
+    @Setup(Level.Trial)
+    public void setUp() {
+        executor = Executors.newFixedThreadPool(threads);
+        message = "state pool benchmark message ".repeat(8).getBytes(StandardCharsets.UTF_8);
+    }
+
+    @TearDown(Level.Trial)
+    public void tearDown() {
+        executor.shutdownNow();
+    }
+
+    @Benchmark
+    public long acquireCompressRecycle() throws Exception {
+        OpenZLGraph[] graphs = {OpenZLGraph.ZSTD, OpenZLGraph.GENERIC, OpenZLGraph.ENTROPY, OpenZLGraph.HUFFMAN};
+        List<Future<Long>> results = new ArrayList<>(threads);
+        for (int t = 0; t < threads; ++t) {
+            OpenZLGraph graph = graphs[t % distinctGraphs];
+            results.add(executor.submit(() -> {
+                long written = 0;
+                for (int i = 0; i < CYCLES_PER_THREAD; ++i) {
+                    try (OpenZLCompressor compressor = new OpenZLCompressor(graph)) {
+                        written += compressor.compress(message).length;
+                    }
+                }
+                return written;
+            }));
+        }
+        long total = 0;
+        for (Future<Long> result : results) {
+            total += result.get();
+        }
+        return total;
+    }
+}
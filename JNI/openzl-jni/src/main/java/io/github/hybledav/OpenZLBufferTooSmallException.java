@@ -0,0 +1,11 @@
+package io.github.hybledav;
+
+/**
+ * Thrown when the destination passed to a compress or decompress call cannot hold the result.
+ */
+public final class OpenZLBufferTooSmallException extends OpenZLException {
+
+    OpenZLBufferTooSmallException(String message, int errorCode) {
+        super(message, errorCode, Kind.DESTINATION_TOO_SMALL);
+    }
+}
@@ -1,7 +1,9 @@
 package io.github.hybledav;
 
+import java.util.List;
 import java.util.Locale;
 import java.util.Objects;
+import java.util.OptionalInt;
 import java.util.OptionalLong;
 
 /**
@@ -19,6 +21,22 @@ public final class OpenZLCompressionInfo {
         STRING,
         UNKNOWN;
 
+        // The ZL_Type code, as expected by the multi-output natives.
+        int nativeCode() {
+            switch (this) {
+                case SERIAL:
+                    return 1;
+                case STRUCT:
+                    return 2;
+                case NUMERIC:
+                    return 4;
+                case STRING:
+                    return 8;
+                default:
+                    return 0;
+            }
+        }
+
         static DataFlavor fromNative(int code) {
             switch (code) {
                 case 1:
@@ -41,6 +59,8 @@ public final class OpenZLCompressionInfo {
     private final DataFlavor flavor;
     private final long elementCount;
     private final int formatVersion;
+    private final int elementWidth;
+    private final List<OpenZLOutputInfo> outputs;
 
     OpenZLCompressionInfo(
             long originalSize,
@@ -49,18 +69,57 @@ public final class OpenZLCompressionInfo {
             DataFlavor flavor,
             long elementCount,
             int formatVersion) {
+        this(originalSize, compressedSize, graph, flavor, elementCount, formatVersion, -1);
+    }
+
+    OpenZLCompressionInfo(
+            long originalSize,
+            long compressedSize,
+            OpenZLGraph graph,
+            DataFlavor flavor,
+            long elementCount,
+            int formatVersion,
+            int elementWidth) {
+        this(originalSize, compressedSize, graph, flavor, elementCount, formatVersion, elementWidth,
+                List.of(new OpenZLOutputInfo(0, flavor, originalSize, elementCount, elementWidth)));
+    }
+
+    OpenZLCompressionInfo(
+            long originalSize,
+            long compressedSize,
+            OpenZLGraph graph,
+            DataFlavor flavor,
+            long elementCount,
+            int formatVersion,
+            int elementWidth,
+            List<OpenZLOutputInfo> outputs) {
         this.originalSize = originalSize;
         this.compressedSize = compressedSize;
         this.graph = Objects.requireNonNull(graph, "graph");
         this.flavor = Objects.requireNonNull(flavor, "flavor");
         this.elementCount = elementCount;
         this.formatVersion = formatVersion;
+        this.elementWidth = elementWidth;
+        this.outputs = List.copyOf(outputs);
     }
 
+    /**
+     * Decompressed size in bytes of the first output. Multi-input frames have one output per
+     * input; {@link #totalSize()} covers all of them.
+     */
     public long originalSize() {
         return originalSize;
     }
 
+    /** Decompressed size in bytes, summed over all outputs. */
+    public long totalSize() {
+        long total = 0;
+        for (OpenZLOutputInfo output : outputs) {
+            total += output.size();
+        }
+        return total;
+    }
+
     public long compressedSize() {
         return compressedSize;
     }
@@ -69,6 +128,10 @@ public final class OpenZLCompressionInfo {
         return graph;
     }
 
+    /**
+     * Type of the first output. Multi-input frames have one output per input; see
+     * {@link #outputs()}.
+     */
     public DataFlavor flavor() {
         return flavor;
     }
@@ -81,6 +144,23 @@ public final class OpenZLCompressionInfo {
         return formatVersion;
     }
 
+    /**
+     * Width in bytes of each element of a {@link DataFlavor#STRUCT} or {@link DataFlavor#NUMERIC}
+     * frame, such as the record width passed to {@link OpenZLCompressor#compressStructs}.
+     */
+    public OptionalInt elementWidth() {
+        return elementWidth > 0 ? OptionalInt.of(elementWidth) : OptionalInt.empty();
+    }
+
+    /** Every output of the frame, in order. */
+    public List<OpenZLOutputInfo> outputs() {
+        return outputs;
+    }
+
+    public int outputCount() {
+        return outputs.size();
+    }
+
     /**
      * Ratio of compressed bytes to original bytes. Zero when the original size is zero.
      */
@@ -92,13 +172,15 @@ public final class OpenZLCompressionInfo {
     public String toString() {
         return String.format(
                 Locale.ROOT,
-                "OpenZLCompressionInfo{original=%d, compressed=%d, ratio=%.2f%%, flavor=%s, graph=%s, elements=%s, version=%d}",
+                "OpenZLCompressionInfo{original=%d, compressed=%d, ratio=%.2f%%, outputs=%d, flavor=%s, graph=%s, elements=%s, width=%s, version=%d}",
                 originalSize,
                 compressedSize,
                 compressionRatio() * 100.0d,
+                outputs.size(),
                 flavor,
                 graph,
                 elementCount >= 0 ? elementCount : "n/a",
+                elementWidth > 0 ? elementWidth : "n/a",
                 formatVersion);
     }
 }
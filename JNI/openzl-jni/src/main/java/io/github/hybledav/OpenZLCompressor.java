@@ -1,17 +1,29 @@
 package io.github.hybledav;
 
+import java.io.IOException;
 import java.lang.ref.Cleaner;
+import java.nio.Buffer;
 import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.DoubleBuffer;
+import java.nio.FloatBuffer;
+import java.nio.IntBuffer;
+import java.nio.LongBuffer;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.ArrayList;
+import java.util.List;
 import java.util.Locale;
 import java.util.Map;
 import java.util.Objects;
+import java.util.TreeMap;
 
 public class OpenZLCompressor implements AutoCloseable {
     private static final class CleanerHolder {
         private static final Cleaner INSTANCE = Cleaner.create();
     }
 
-    private static Cleaner cleaner() {
+    static Cleaner cleaner() {
         return CleanerHolder.INSTANCE;
     }
 
@@ -25,8 +37,13 @@ public class OpenZLCompressor implements AutoCloseable {
     private static final int META_GRAPH_ID = 3;
     private static final int META_ELEMENT_COUNT = 4;
     private static final int META_FORMAT_VERSION = 5;
-    private static final int META_LENGTH = 6;
+    private static final int META_ELEMENT_WIDTH = 6;
+    private static final int META_OUTPUT_COUNT = 7;
+    private static final int META_LENGTH = 8;
+    private static final int META_OUTPUT_FIELDS = 4;
     private static final int CPARAM_COMPRESSION_LEVEL = 2;
+    public static final int DEFAULT_PARALLEL_CHUNK_SIZE = 4 << 20;
+    public static final long DEFAULT_PARALLEL_FILE_THRESHOLD = 64L << 20;
 
     public OpenZLCompressor() {
         this(OpenZLGraph.ZSTD);
@@ -69,8 +86,179 @@ public class OpenZLCompressor implements AutoCloseable {
         }
         return bound;
     }
+    /**
+     * Native scratch bytes currently held by all compressors, stream buffers and pooled states.
+     */
+    public static long retainedScratchBytes() {
+        OpenZLNative.load();
+        return retainedScratchBytesNative();
+    }
+
+    /**
+     * Bounds the scratch memory kept between calls. A compressor's scratch larger than
+     * {@code perStateBytes} is dropped once calls of a normal size resume, on {@link #reset()}
+     * and when the compressor is closed. Idle scratch is released outright while the process
+     * total exceeds {@code totalBytes}, and shrunk to its recent usage once above
+     * {@code shrinkThresholdBytes}. Defaults: 64 MiB, 256 MiB and 1 MiB.
+     */
+    public static void setScratchLimits(long perStateBytes, long totalBytes, long shrinkThresholdBytes) {
+        if (perStateBytes < 0 || totalBytes < 0 || shrinkThresholdBytes < 0) {
+            throw new IllegalArgumentException("Scratch limits must be non-negative");
+        }
+        OpenZLNative.load();
+        setScratchLimitsNative(perStateBytes, totalBytes, shrinkThresholdBytes);
+    }
+
+    /**
+     * Sets how many idle native compressor states are kept for reuse by new instances
+     * (default 64, at most 1024). Lowering it frees the surplus states immediately.
+     */
+    public static void setStatePoolCapacity(int capacity) {
+        if (capacity < 0 || capacity > 1024) {
+            throw new IllegalArgumentException("State pool capacity must be between 0 and 1024");
+        }
+        OpenZLNative.load();
+        setStatePoolCapacityNative(capacity);
+    }
+
+    /**
+     * Number of idle native compressor states currently pooled.
+     */
+    public static int pooledStateCount() {
+        OpenZLNative.load();
+        return pooledStateCountNative();
+    }
+
+    /**
+     * OpenZL error code of the last failed operation on this compressor, or {@code 0} if the
+     * most recent operation did not record one. Failures also surface as {@link OpenZLException}.
+     */
+    public int lastErrorCode() {
+        ensureOpen();
+        return lastErrorCodeNative();
+    }
+
+    /**
+     * Description of the last failed operation, including OpenZL's error context, or
+     * {@code null} if the most recent operation did not record a failure.
+     */
+    public String lastErrorMessage() {
+        ensureOpen();
+        return lastErrorMessageNative();
+    }
+
+    /**
+     * Process-wide number of recorded failures per OpenZL error code, omitting codes that never
+     * occurred. Codes of 127 and above share the last entry.
+     */
+    public static Map<Integer, Long> errorCounts() {
+        OpenZLNative.load();
+        long[] counts = errorCountsNative();
+        Map<Integer, Long> result = new TreeMap<>();
+        for (int code = 0; code < counts.length; ++code) {
+            if (counts[code] != 0) {
+                result.put(code, counts[code]);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * Enables or disables logging of native failures to stderr, limited to a few lines per
+     * second. Off by default unless the {@code OPENZL_JNI_LOG_ERRORS} environment variable is set.
+     */
+    public static void setErrorLogging(boolean enabled) {
+        OpenZLNative.load();
+        setErrorLoggingNative(enabled);
+    }
+
+    /**
+     * Sets the payload size from which {@code byte[]} calls copy through native scratch instead of
+     * pinning the arrays, so large calls do not hold off the garbage collector. {@code 0} always
+     * copies and {@link Long#MAX_VALUE} always pins. Default: 1 MiB.
+     */
+    public static void setPinningThreshold(long bytes) {
+        if (bytes < 0) {
+            throw new IllegalArgumentException("Pinning threshold must be non-negative");
+        }
+        OpenZLNative.load();
+        setPinningThresholdNative(bytes);
+    }
+
+    /**
+     * Process-wide statistics on how long native calls have kept {@code byte[]} arrays pinned.
+     */
+    public static OpenZLCriticalRegionStats criticalRegionStats() {
+        OpenZLNative.load();
+        long[] stats = criticalRegionStatsNative();
+        return new OpenZLCriticalRegionStats(stats[0], stats[1], stats[2]);
+    }
+
+    OpenZLException failure(String message) {
+        return OpenZLException.create(message, lastErrorCodeNative(), lastErrorKindNative(), lastErrorMessageNative());
+    }
+
+    /**
+     * Compresses the UTF-8 encoding of {@code text}. The encoding is done natively from the
+     * string's characters, so the result equals {@code compress(text.toString().getBytes(UTF_8))}
+     * without the intermediate array.
+     */
+    public byte[] compress(CharSequence text) {
+        ensureOpen();
+        Objects.requireNonNull(text, "text");
+        byte[] result = compressStringNative(text.toString());
+        if (result == null) {
+            throw failure("Compression failed");
+        }
+        return result;
+    }
+
+    /**
+     * Decompresses a frame holding UTF-8 text straight into a String. Malformed input is
+     * replaced with U+FFFD, as {@code new String(bytes, UTF_8)} does.
+     */
+    public String decompressToString(byte[] compressed) {
+        ensureOpen();
+        Objects.requireNonNull(compressed, "compressed");
+        String result = decompressToStringNative(compressed);
+        if (result == null) {
+            throw failure("Decompression failed");
+        }
+        return result;
+    }
+
     public native byte[] compress(byte[] input);
     public native byte[] decompress(byte[] input);
+
+    /**
+     * Like {@link #compress(byte[])}, but raises {@link OpenZLException} carrying the recorded
+     * native error instead of returning null, and {@link IllegalStateException} once closed.
+     */
+    public byte[] compressChecked(byte[] input) {
+        ensureOpen();
+        Objects.requireNonNull(input, "input");
+        byte[] result = compress(input);
+        if (result == null) {
+            throw failure("Compression failed");
+        }
+        return result;
+    }
+
+    /**
+     * Like {@link #decompress(byte[])}, but raises {@link OpenZLException} (or
+     * {@link OpenZLCorruptInputException} for malformed frames) instead of returning null, and
+     * {@link IllegalStateException} once closed.
+     */
+    public byte[] decompressChecked(byte[] input) {
+        ensureOpen();
+        Objects.requireNonNull(input, "input");
+        byte[] result = decompress(input);
+        if (result == null) {
+            throw failure("Decompression failed");
+        }
+        return result;
+    }
+
     private static native long maxCompressedSizeNative(int inputSize);
     private native int compressDirect(ByteBuffer src, int srcPos, int srcLen,
                                       ByteBuffer dst, int dstPos, int dstLen);
@@ -79,10 +267,66 @@ public class OpenZLCompressor implements AutoCloseable {
     private native long getDecompressedSizeNative(byte[] input);
     private native long getDecompressedSizeDirect(ByteBuffer src, int srcPos, int srcLen);
     private native void resetNative();
+    private static native long retainedScratchBytesNative();
+    private static native void setScratchLimitsNative(long perStateBytes, long totalBytes, long shrinkThresholdBytes);
+    private static native void setStatePoolCapacityNative(int capacity);
+    private static native int pooledStateCountNative();
+    private native int lastErrorCodeNative();
+    private native int lastErrorKindNative();
+    private native String lastErrorMessageNative();
+    private static native long[] errorCountsNative();
+    private static native void setErrorLoggingNative(boolean enabled);
+    private static native void setPinningThresholdNative(long bytes);
+    private static native long[] criticalRegionStatsNative();
     private native int compressIntoNative(byte[] src, int srcOffset, int srcLength,
                                           byte[] dst, int dstOffset, int dstLength);
     private native int decompressIntoNative(byte[] src, int srcOffset, int srcLength,
                                             byte[] dst, int dstOffset, int dstLength);
+    private native int compressBatchNative(byte[] src, int[] srcOffsets, int[] srcLengths,
+                                           byte[] dst, int dstOffset, int dstLength, int[] dstOffsets);
+    private native int decompressBatchNative(byte[] src, int[] srcOffsets, int[] srcLengths,
+                                             byte[] dst, int dstOffset, int dstLength, int[] dstOffsets);
+    private native int compressBatchDirect(ByteBuffer src, int srcPos, int srcLen,
+                                           int[] srcOffsets, int[] srcLengths,
+                                           ByteBuffer dst, int dstPos, int dstLen, int[] dstOffsets);
+    private native int decompressBatchDirect(ByteBuffer src, int srcPos, int srcLen,
+                                             int[] srcOffsets, int[] srcLengths,
+                                             ByteBuffer dst, int dstPos, int dstLen, int[] dstOffsets);
+    private native byte[] compressParallelNative(byte[] src, int srcOffset, int srcLength,
+                                                 int chunkSize, int threads);
+    private native int compressParallelDirect(ByteBuffer src, int srcPos, int srcLen,
+                                              ByteBuffer dst, int dstPos, int dstLen,
+                                              int chunkSize, int threads);
+    private static native long maxParallelCompressedSizeNative(long inputSize, int chunkSize);
+    private native byte[] decompressParallelNative(byte[] src, int srcOffset, int srcLength,
+                                                   int threads, long maxInFlightBytes);
+    private native int decompressParallelIntoNative(byte[] src, int srcOffset, int srcLength,
+                                                    byte[] dst, int dstOffset, int dstLength,
+                                                    int threads, long maxInFlightBytes);
+    private native int decompressParallelDirect(ByteBuffer src, int srcPos, int srcLen,
+                                                ByteBuffer dst, int dstPos, int dstLen,
+                                                int threads, long maxInFlightBytes);
+    private native long parallelContentSizeNative(byte[] src, int srcOffset, int srcLength);
+    private native long parallelContentSizeDirect(ByteBuffer src, int srcPos, int srcLen);
+    private native int decompressRangeDirect(ByteBuffer src, int srcPos, int srcLen, long offset, int length,
+            ByteBuffer dst, int dstPos, int dstLen, int threads);
+    private native int decompressRangeFileNative(String container, long offset, int length,
+            ByteBuffer dst, int dstPos, int dstLen, int threads);
+    private static native int cachedContainerIndexCountNative();
+    private native long compressFileNative(String in, String out, long parallelThreshold,
+                                           int chunkSize, int threads);
+    private native long decompressFileNative(String in, String out, int threads);
+    private native long compressToNativeNative(byte[] src, int srcOffset, int srcLength);
+    private native long decompressToNativeNative(byte[] src, int srcOffset, int srcLength);
+    static native ByteBuffer nativeBufferViewNative(long handle);
+    static native void nativeBufferReleaseNative(long handle);
+    // Chunk buffers behind OpenZLOutputStream / OpenZLInputStream.
+    static native long streamBufferCreateNative(int chunkSize);
+    static native void streamBufferDestroyNative(long buffer);
+    static native int streamAppendNative(long buffer, byte[] src, int srcOffset, int srcLength);
+    native int streamCompressNative(long buffer);
+    native int streamDecompressNative(long buffer, byte[] frame, int frameOffset, int frameLength);
+    static native int streamReadNative(long buffer, int position, byte[] dst, int dstOffset, int dstLength);
     private native void destroyCompressor();
     private native void configureSddlNative(byte[] compiledDescription);
     private native void configureProfileNative(String profileName, String[] keys, String[] values);
@@ -94,7 +338,7 @@ public class OpenZLCompressor implements AutoCloseable {
         int dstPos = dst.position();
         int written = compressDirect(src, srcPos, src.remaining(), dst, dstPos, dst.remaining());
         if (written < 0) {
-            throw new IllegalStateException("Compression failed");
+            throw failure("Compression failed");
         }
         src.position(src.limit());
         dst.position(dstPos + written);
@@ -119,7 +363,7 @@ public class OpenZLCompressor implements AutoCloseable {
         int dstPos = dst.position();
         int written = decompressDirect(src, srcPos, src.remaining(), dst, dstPos, dst.remaining());
         if (written < 0) {
-            throw new IllegalStateException("Decompression failed");
+            throw failure("Decompression failed");
         }
         src.position(src.limit());
         dst.position(dstPos + written);
@@ -139,7 +383,7 @@ public class OpenZLCompressor implements AutoCloseable {
         return dst;
     }
 
-    private static void requireDirect(ByteBuffer buffer, String name) {
+    private static void requireDirect(Buffer buffer, String name) {
         if (buffer == null) {
             throw new NullPointerException(name + " buffer is null");
         }
@@ -183,6 +427,12 @@ public class OpenZLCompressor implements AutoCloseable {
         configureProfile(profile, Map.of());
     }
 
+    /**
+     * Configures {@code profile} with {@code arguments}. Compiled profiles are cached per
+     * profile and argument map, in any iteration order. Files named by an argument are read
+     * when its configuration is compiled, and compiled again once their size or modification
+     * time changes.
+     */
     public void configureProfile(OpenZLProfile profile, Map<String, String> arguments) {
         ensureOpen();
         Objects.requireNonNull(profile, "profile");
@@ -227,7 +477,7 @@ public class OpenZLCompressor implements AutoCloseable {
         checkRange(output.length, outputOffset, outputLength, "output");
         int written = compressIntoNative(input, inputOffset, inputLength, output, outputOffset, outputLength);
         if (written < 0) {
-            throw new IllegalStateException("Compression failed");
+            throw failure("Compression failed");
         }
         return written;
     }
@@ -245,11 +495,416 @@ public class OpenZLCompressor implements AutoCloseable {
         checkRange(output.length, outputOffset, outputLength, "output");
         int written = decompressIntoNative(input, inputOffset, inputLength, output, outputOffset, outputLength);
         if (written < 0) {
-            throw new IllegalStateException("Decompression failed");
+            throw failure("Decompression failed");
+        }
+        return written;
+    }
+
+    /**
+     * Upper bound for the destination size needed by {@link #compressBatch}.
+     */
+    public static long maxCompressedBatchSize(int[] lengths) {
+        Objects.requireNonNull(lengths, "lengths");
+        long total = 0;
+        for (int length : lengths) {
+            total += maxCompressedSize(length);
+        }
+        return total;
+    }
+
+    /**
+     * Compresses every {@code src[offsets[i], offsets[i] + lengths[i])} slice into its own frame,
+     * packing the frames back to back into {@code dst} starting at {@code dstOffset}. Frame
+     * {@code i} occupies {@code dst[frameOffsets[i], frameOffsets[i + 1])}, so
+     * {@code frameOffsets} must hold at least {@code lengths.length + 1} entries.
+     *
+     * @return total number of bytes written to {@code dst}
+     */
+    public int compressBatch(byte[] src, int[] offsets, int[] lengths,
+            byte[] dst, int dstOffset, int[] frameOffsets) {
+        ensureOpen();
+        Objects.requireNonNull(src, "src");
+        Objects.requireNonNull(dst, "dst");
+        checkBatch(src.length, offsets, lengths, frameOffsets);
+        checkRange(dst.length, dstOffset, dst.length - dstOffset, "dst");
+        int written = compressBatchNative(src, offsets, lengths, dst, dstOffset, dst.length - dstOffset, frameOffsets);
+        if (written < 0) {
+            throw failure("Batch compression failed");
+        }
+        return written;
+    }
+
+    /**
+     * Decompresses the frames described by {@code offsets}/{@code lengths} into {@code dst}.
+     * Output {@code i} occupies {@code dst[frameOffsets[i], frameOffsets[i + 1])}.
+     *
+     * @return total number of bytes written to {@code dst}
+     */
+    public int decompressBatch(byte[] src, int[] offsets, int[] lengths,
+            byte[] dst, int dstOffset, int[] frameOffsets) {
+        ensureOpen();
+        Objects.requireNonNull(src, "src");
+        Objects.requireNonNull(dst, "dst");
+        checkBatch(src.length, offsets, lengths, frameOffsets);
+        checkRange(dst.length, dstOffset, dst.length - dstOffset, "dst");
+        int written = decompressBatchNative(src, offsets, lengths, dst, dstOffset, dst.length - dstOffset, frameOffsets);
+        if (written < 0) {
+            throw failure("Batch decompression failed");
+        }
+        return written;
+    }
+
+    /**
+     * Direct-buffer variant of {@link #compressBatch(byte[], int[], int[], byte[], int, int[])}.
+     * Offsets are relative to {@code src.position()} and frame offsets to the position of
+     * {@code dst} on entry; {@code src} is fully consumed and {@code dst} advances past the frames.
+     */
+    public int compressBatch(ByteBuffer src, int[] offsets, int[] lengths,
+            ByteBuffer dst, int[] frameOffsets) {
+        ensureOpen();
+        requireDirect(src, "src");
+        requireDirect(dst, "dst");
+        checkBatch(src.remaining(), offsets, lengths, frameOffsets);
+        int dstPos = dst.position();
+        int written = compressBatchDirect(src, src.position(), src.remaining(), offsets, lengths,
+                dst, dstPos, dst.remaining(), frameOffsets);
+        if (written < 0) {
+            throw failure("Batch compression failed");
+        }
+        src.position(src.limit());
+        dst.position(dstPos + written);
+        return written;
+    }
+
+    /**
+     * Direct-buffer variant of {@link #decompressBatch(byte[], int[], int[], byte[], int, int[])}.
+     */
+    public int decompressBatch(ByteBuffer src, int[] offsets, int[] lengths,
+            ByteBuffer dst, int[] frameOffsets) {
+        ensureOpen();
+        requireDirect(src, "src");
+        requireDirect(dst, "dst");
+        checkBatch(src.remaining(), offsets, lengths, frameOffsets);
+        int dstPos = dst.position();
+        int written = decompressBatchDirect(src, src.position(), src.remaining(), offsets, lengths,
+                dst, dstPos, dst.remaining(), frameOffsets);
+        if (written < 0) {
+            throw failure("Batch decompression failed");
         }
+        src.position(src.limit());
+        dst.position(dstPos + written);
         return written;
     }
 
+    /**
+     * Upper bound for the output of {@link #compressParallel} on {@code inputSize} bytes.
+     */
+    public static long maxParallelCompressedSize(long inputSize, int chunkSize) {
+        if (inputSize < 0) {
+            throw new IllegalArgumentException("inputSize must be non-negative");
+        }
+        OpenZLNative.load();
+        long bound = maxParallelCompressedSizeNative(inputSize, chunkSize);
+        if (bound < 0) {
+            throw new IllegalStateException("Failed to query compression bound");
+        }
+        return bound;
+    }
+
+    public byte[] compressParallel(byte[] input) {
+        return compressParallel(input, DEFAULT_PARALLEL_CHUNK_SIZE, 0);
+    }
+
+    /**
+     * Splits {@code input} into {@code chunkSize} pieces and compresses them on up to
+     * {@code threads} threads (the caller included; {@code 0} uses every available core).
+     * The result is a chunked container for {@link #decompressParallel(byte[])}, not a single
+     * OpenZL frame. Graph, profile and parameters of this compressor apply to
+     * every chunk.
+     */
+    public byte[] compressParallel(byte[] input, int chunkSize, int threads) {
+        ensureOpen();
+        Objects.requireNonNull(input, "input");
+        if (threads < 0) {
+            throw new IllegalArgumentException("threads must be non-negative");
+        }
+        byte[] result = compressParallelNative(input, 0, input.length, chunkSize, threads);
+        if (result == null) {
+            throw failure("Parallel compression failed");
+        }
+        return result;
+    }
+
+    /**
+     * Direct-buffer variant of {@link #compressParallel(byte[], int, int)}. {@code dst} must have
+     * at least {@link #maxParallelCompressedSize} bytes remaining.
+     */
+    public int compressParallel(ByteBuffer src, ByteBuffer dst, int chunkSize, int threads) {
+        ensureOpen();
+        requireDirect(src, "src");
+        requireDirect(dst, "dst");
+        if (threads < 0) {
+            throw new IllegalArgumentException("threads must be non-negative");
+        }
+        if (dst.remaining() < maxParallelCompressedSize(src.remaining(), chunkSize)) {
+            throw new IllegalArgumentException("dst has insufficient remaining capacity");
+        }
+        int srcPos = src.position();
+        int dstPos = dst.position();
+        int written = compressParallelDirect(src, srcPos, src.remaining(), dst, dstPos, dst.remaining(),
+                chunkSize, threads);
+        if (written < 0) {
+            throw failure("Parallel compression failed");
+        }
+        src.position(src.limit());
+        dst.position(dstPos + written);
+        return written;
+    }
+
+    /**
+     * Returns the decompressed size recorded in a chunked container header.
+     */
+    public long getParallelDecompressedSize(byte[] container) {
+        ensureOpen();
+        Objects.requireNonNull(container, "container");
+        return parallelContentSizeNative(container, 0, container.length);
+    }
+
+    public long getParallelDecompressedSize(ByteBuffer container) {
+        ensureOpen();
+        requireDirect(container, "container");
+        return parallelContentSizeDirect(container, container.position(), container.remaining());
+    }
+
+    public byte[] decompressParallel(byte[] container) {
+        return decompressParallel(container, 0, 0);
+    }
+
+    /**
+     * Restores a container produced by {@link #compressParallel}. Chunks are decoded on up to
+     * {@code threads} threads ({@code 0} uses every available core) straight into the result.
+     * A positive {@code maxInFlightBytes} limits how many decompressed bytes may be produced
+     * concurrently; a single chunk larger than the budget still proceeds on its own.
+     */
+    public byte[] decompressParallel(byte[] container, int threads, long maxInFlightBytes) {
+        ensureOpen();
+        Objects.requireNonNull(container, "container");
+        checkParallelArguments(threads, maxInFlightBytes);
+        byte[] result = decompressParallelNative(container, 0, container.length, threads, maxInFlightBytes);
+        if (result == null) {
+            throw failure("Parallel decompression failed");
+        }
+        return result;
+    }
+
+    public int decompressParallel(byte[] container, byte[] dst, int dstOffset,
+            int threads, long maxInFlightBytes) {
+        ensureOpen();
+        Objects.requireNonNull(container, "container");
+        Objects.requireNonNull(dst, "dst");
+        checkRange(dst.length, dstOffset, dst.length - dstOffset, "dst");
+        checkParallelArguments(threads, maxInFlightBytes);
+        int written = decompressParallelIntoNative(container, 0, container.length,
+                dst, dstOffset, dst.length - dstOffset, threads, maxInFlightBytes);
+        if (written < 0) {
+            throw failure("Parallel decompression failed");
+        }
+        return written;
+    }
+
+    /**
+     * Direct-buffer variant of {@link #decompressParallel(byte[], int, long)}; {@code dst} needs
+     * {@link #getParallelDecompressedSize(ByteBuffer)} bytes remaining.
+     */
+    public int decompressParallel(ByteBuffer src, ByteBuffer dst, int threads, long maxInFlightBytes) {
+        ensureOpen();
+        requireDirect(src, "src");
+        requireDirect(dst, "dst");
+        checkParallelArguments(threads, maxInFlightBytes);
+        int dstPos = dst.position();
+        int written = decompressParallelDirect(src, src.position(), src.remaining(),
+                dst, dstPos, dst.remaining(), threads, maxInFlightBytes);
+        if (written < 0) {
+            throw failure("Parallel decompression failed");
+        }
+        src.position(src.limit());
+        dst.position(dstPos + written);
+        return written;
+    }
+
+    /**
+     * Decompresses content bytes {@code [offset, offset + length)} of a container produced by
+     * {@link #compressParallel} or {@link #compressFile} into {@code dst}, decoding only the
+     * chunks that overlap the range. Returns the number of bytes written, which is less than
+     * {@code length} when the range runs past the end of the content. {@code src} is left
+     * untouched so that it can be read again; the parsed chunk index of recently read
+     * containers is cached by buffer address and reused while the header and chunk table bytes
+     * are unchanged.
+     */
+    public int decompressRange(ByteBuffer src, long offset, int length, ByteBuffer dst) {
+        return decompressRange(src, offset, length, dst, 1);
+    }
+
+    /**
+     * Variant of {@link #decompressRange(ByteBuffer, long, int, ByteBuffer)} that decodes the
+     * overlapping chunks on up to {@code threads} threads ({@code 0} uses every available core).
+     */
+    public int decompressRange(ByteBuffer src, long offset, int length, ByteBuffer dst, int threads) {
+        ensureOpen();
+        requireDirect(src, "src");
+        requireDirect(dst, "dst");
+        if (offset < 0 || length < 0) {
+            throw new IllegalArgumentException("offset and length must be non-negative");
+        }
+        checkParallelArguments(threads, 0);
+        int dstPos = dst.position();
+        int written = decompressRangeDirect(src, src.position(), src.remaining(), offset, length,
+                dst, dstPos, dst.remaining(), threads);
+        if (written < 0) {
+            throw failure("Range decompression failed");
+        }
+        dst.position(dstPos + written);
+        return written;
+    }
+
+    /**
+     * Variant of {@link #decompressRange(ByteBuffer, long, int, ByteBuffer)} that reads the
+     * container from a file through a memory mapping, so containers larger than the 2 GiB a
+     * {@link ByteBuffer} can address are served too. The chunk index is parsed on every call.
+     */
+    public int decompressRange(Path container, long offset, int length, ByteBuffer dst) throws IOException {
+        return decompressRange(container, offset, length, dst, 1);
+    }
+
+    /**
+     * Variant of {@link #decompressRange(Path, long, int, ByteBuffer)} that decodes the
+     * overlapping chunks on up to {@code threads} threads ({@code 0} uses every available core).
+     */
+    public int decompressRange(Path container, long offset, int length, ByteBuffer dst, int threads)
+            throws IOException {
+        ensureOpen();
+        Objects.requireNonNull(container, "container");
+        requireDirect(dst, "dst");
+        if (offset < 0 || length < 0) {
+            throw new IllegalArgumentException("offset and length must be non-negative");
+        }
+        checkParallelArguments(threads, 0);
+        int dstPos = dst.position();
+        int written = decompressRangeFileNative(container.toAbsolutePath().toString(), offset, length,
+                dst, dstPos, dst.remaining(), threads);
+        if (written < 0) {
+            throw failure("Range decompression failed");
+        }
+        dst.position(dstPos + written);
+        return written;
+    }
+
+    /**
+     * Number of container chunk indexes currently cached for
+     * {@link #decompressRange(ByteBuffer, long, int, ByteBuffer)}.
+     */
+    public static int cachedContainerIndexCount() {
+        return cachedContainerIndexCountNative();
+    }
+
+    private static void checkParallelArguments(int threads, long maxInFlightBytes) {
+        if (threads < 0) {
+            throw new IllegalArgumentException("threads must be non-negative");
+        }
+        if (maxInFlightBytes < 0) {
+            throw new IllegalArgumentException("maxInFlightBytes must be non-negative");
+        }
+    }
+
+    public OpenZLNativeBuffer compressToNative(byte[] input) {
+        Objects.requireNonNull(input, "input");
+        return compressToNative(input, 0, input.length);
+    }
+
+    /**
+     * Compresses into a pooled native block instead of a new {@code byte[]}, skipping the copy
+     * from native scratch to the heap. Close the returned buffer once its bytes are consumed.
+     */
+    public OpenZLNativeBuffer compressToNative(byte[] input, int offset, int length) {
+        ensureOpen();
+        Objects.requireNonNull(input, "input");
+        checkRange(input.length, offset, length, "input");
+        long handle = compressToNativeNative(input, offset, length);
+        if (handle == 0) {
+            throw failure("Compression failed");
+        }
+        return new OpenZLNativeBuffer(handle);
+    }
+
+    public OpenZLNativeBuffer decompressToNative(byte[] input) {
+        Objects.requireNonNull(input, "input");
+        return decompressToNative(input, 0, input.length);
+    }
+
+    public OpenZLNativeBuffer decompressToNative(byte[] input, int offset, int length) {
+        ensureOpen();
+        Objects.requireNonNull(input, "input");
+        checkRange(input.length, offset, length, "input");
+        long handle = decompressToNativeNative(input, offset, length);
+        if (handle == 0) {
+            throw failure("Decompression failed");
+        }
+        return new OpenZLNativeBuffer(handle);
+    }
+
+    public long compressFile(Path in, Path out) throws IOException {
+        return compressFile(in, out, DEFAULT_PARALLEL_FILE_THRESHOLD, DEFAULT_PARALLEL_CHUNK_SIZE, 0);
+    }
+
+    /**
+     * Compresses {@code in} into {@code out} (created or truncated) through memory mappings, so
+     * the payload never reaches the Java heap. Files of at least {@code parallelThreshold} bytes
+     * are written as a {@link #compressParallel} container using {@code chunkSize} and
+     * {@code threads}; smaller files become a single frame. A negative threshold disables the
+     * chunked mode. On failure {@code out} is removed.
+     *
+     * @return size of {@code out} in bytes
+     */
+    public long compressFile(Path in, Path out, long parallelThreshold, int chunkSize, int threads)
+            throws IOException {
+        ensureOpen();
+        Objects.requireNonNull(in, "in");
+        Objects.requireNonNull(out, "out");
+        if (threads < 0) {
+            throw new IllegalArgumentException("threads must be non-negative");
+        }
+        requireDistinctFiles(in, out);
+        return compressFileNative(in.toAbsolutePath().toString(), out.toAbsolutePath().toString(),
+                parallelThreshold, chunkSize, threads);
+    }
+
+    public long decompressFile(Path in, Path out) throws IOException {
+        return decompressFile(in, out, 0);
+    }
+
+    /**
+     * Restores a file written by {@link #compressFile}, accepting both single frames and chunked
+     * containers; containers are decoded on up to {@code threads} threads.
+     *
+     * @return size of {@code out} in bytes
+     */
+    public long decompressFile(Path in, Path out, int threads) throws IOException {
+        ensureOpen();
+        Objects.requireNonNull(in, "in");
+        Objects.requireNonNull(out, "out");
+        if (threads < 0) {
+            throw new IllegalArgumentException("threads must be non-negative");
+        }
+        requireDistinctFiles(in, out);
+        return decompressFileNative(in.toAbsolutePath().toString(), out.toAbsolutePath().toString(), threads);
+    }
+
+    private static void requireDistinctFiles(Path in, Path out) throws IOException {
+        if (Files.exists(out) && Files.isSameFile(in, out)) {
+            throw new IllegalArgumentException("in and out must be different files");
+        }
+    }
+
     public byte[] compressInts(int[] data) {
         ensureOpen();
         Objects.requireNonNull(data, "data");
@@ -258,7 +913,7 @@ public class OpenZLCompressor implements AutoCloseable {
         }
         byte[] result = compressIntsNative(data);
         if (result == null) {
-            throw new IllegalStateException("Failed to compress int array");
+            throw failure("Failed to compress int array");
         }
         return result;
     }
@@ -271,7 +926,7 @@ public class OpenZLCompressor implements AutoCloseable {
         }
         byte[] result = compressLongsNative(data);
         if (result == null) {
-            throw new IllegalStateException("Failed to compress long array");
+            throw failure("Failed to compress long array");
         }
         return result;
     }
@@ -284,7 +939,7 @@ public class OpenZLCompressor implements AutoCloseable {
         }
         byte[] result = compressFloatsNative(data);
         if (result == null) {
-            throw new IllegalStateException("Failed to compress float array");
+            throw failure("Failed to compress float array");
         }
         return result;
     }
@@ -297,7 +952,7 @@ public class OpenZLCompressor implements AutoCloseable {
         }
         byte[] result = compressDoublesNative(data);
         if (result == null) {
-            throw new IllegalStateException("Failed to compress double array");
+            throw failure("Failed to compress double array");
         }
         return result;
     }
@@ -310,7 +965,7 @@ public class OpenZLCompressor implements AutoCloseable {
         }
         int[] result = decompressIntsNative(compressed);
         if (result == null) {
-            throw new IllegalStateException("Failed to decompress int array");
+            throw failure("Failed to decompress int array");
         }
         return result;
     }
@@ -323,7 +978,7 @@ public class OpenZLCompressor implements AutoCloseable {
         }
         long[] result = decompressLongsNative(compressed);
         if (result == null) {
-            throw new IllegalStateException("Failed to decompress long array");
+            throw failure("Failed to decompress long array");
         }
         return result;
     }
@@ -336,7 +991,7 @@ public class OpenZLCompressor implements AutoCloseable {
         }
         float[] result = decompressFloatsNative(compressed);
         if (result == null) {
-            throw new IllegalStateException("Failed to decompress float array");
+            throw failure("Failed to decompress float array");
         }
         return result;
     }
@@ -349,11 +1004,534 @@ public class OpenZLCompressor implements AutoCloseable {
         }
         double[] result = decompressDoublesNative(compressed);
         if (result == null) {
-            throw new IllegalStateException("Failed to decompress double array");
+            throw failure("Failed to decompress double array");
         }
         return result;
     }
 
+    /**
+     * Compresses {@code srcLength} elements starting at {@code srcOffset} into {@code dst} at
+     * {@code dstOffset} without allocating, returning the number of bytes written. The long,
+     * float and double overloads behave the same way.
+     */
+    public int compressInts(int[] src, int srcOffset, int srcLength, byte[] dst, int dstOffset) {
+        Objects.requireNonNull(src, "src");
+        return compressNumericInto(src, Integer.BYTES, src.length, srcOffset, srcLength, dst, dstOffset);
+    }
+
+    /**
+     * Decompresses a numeric frame into {@code dst} starting at {@code dstOffset}, returning the
+     * number of elements written. Fails with {@link OpenZLBufferTooSmallException} when the frame
+     * holds more elements than fit after {@code dstOffset}.
+     */
+    public int decompressInts(byte[] src, int srcOffset, int srcLength, int[] dst, int dstOffset) {
+        Objects.requireNonNull(dst, "dst");
+        return decompressNumericInto(src, srcOffset, srcLength, dst, Integer.BYTES, dst.length, dstOffset);
+    }
+
+    /**
+     * Compresses the remaining bytes of {@code src}, read as native-order elements, into
+     * {@code dst}. Both buffers must be direct and their positions are advanced.
+     */
+    public int compressInts(ByteBuffer src, ByteBuffer dst) {
+        return compressNumericDirect(src, Integer.BYTES, dst);
+    }
+
+    /**
+     * Decompresses a numeric frame into {@code dst} as native-order elements, returning the number
+     * of elements written. Both buffers must be direct and their positions are advanced.
+     */
+    public int decompressInts(ByteBuffer src, ByteBuffer dst) {
+        return decompressNumericDirect(src, dst, Integer.BYTES);
+    }
+
+    public int compressLongs(long[] src, int srcOffset, int srcLength, byte[] dst, int dstOffset) {
+        Objects.requireNonNull(src, "src");
+        return compressNumericInto(src, Long.BYTES, src.length, srcOffset, srcLength, dst, dstOffset);
+    }
+
+    public int decompressLongs(byte[] src, int srcOffset, int srcLength, long[] dst, int dstOffset) {
+        Objects.requireNonNull(dst, "dst");
+        return decompressNumericInto(src, srcOffset, srcLength, dst, Long.BYTES, dst.length, dstOffset);
+    }
+
+    public int compressLongs(ByteBuffer src, ByteBuffer dst) {
+        return compressNumericDirect(src, Long.BYTES, dst);
+    }
+
+    public int decompressLongs(ByteBuffer src, ByteBuffer dst) {
+        return decompressNumericDirect(src, dst, Long.BYTES);
+    }
+
+    public int compressFloats(float[] src, int srcOffset, int srcLength, byte[] dst, int dstOffset) {
+        Objects.requireNonNull(src, "src");
+        return compressNumericInto(src, Float.BYTES, src.length, srcOffset, srcLength, dst, dstOffset);
+    }
+
+    public int decompressFloats(byte[] src, int srcOffset, int srcLength, float[] dst, int dstOffset) {
+        Objects.requireNonNull(dst, "dst");
+        return decompressNumericInto(src, srcOffset, srcLength, dst, Float.BYTES, dst.length, dstOffset);
+    }
+
+    public int compressFloats(ByteBuffer src, ByteBuffer dst) {
+        return compressNumericDirect(src, Float.BYTES, dst);
+    }
+
+    public int decompressFloats(ByteBuffer src, ByteBuffer dst) {
+        return decompressNumericDirect(src, dst, Float.BYTES);
+    }
+
+    public int compressDoubles(double[] src, int srcOffset, int srcLength, byte[] dst, int dstOffset) {
+        Objects.requireNonNull(src, "src");
+        return compressNumericInto(src, Double.BYTES, src.length, srcOffset, srcLength, dst, dstOffset);
+    }
+
+    public int decompressDoubles(byte[] src, int srcOffset, int srcLength, double[] dst, int dstOffset) {
+        Objects.requireNonNull(dst, "dst");
+        return decompressNumericInto(src, srcOffset, srcLength, dst, Double.BYTES, dst.length, dstOffset);
+    }
+
+    public int compressDoubles(ByteBuffer src, ByteBuffer dst) {
+        return compressNumericDirect(src, Double.BYTES, dst);
+    }
+
+    public int decompressDoubles(ByteBuffer src, ByteBuffer dst) {
+        return decompressNumericDirect(src, dst, Double.BYTES);
+    }
+
+    /**
+     * Compresses the remaining elements of a direct typed buffer into {@code dst} without a heap
+     * copy. Buffers in non-native byte order are swapped into native scratch first. The long,
+     * float and double overloads behave the same way.
+     */
+    public int compressInts(IntBuffer src, ByteBuffer dst) {
+        requireDirect(src, "src");
+        return compressNumericBuffer(src, Integer.BYTES, src.order() != ByteOrder.nativeOrder(), dst);
+    }
+
+    /**
+     * Decompresses a numeric frame into a direct typed buffer, honouring its byte order, and
+     * returns the number of elements written.
+     */
+    public int decompressInts(ByteBuffer src, IntBuffer dst) {
+        requireDirect(dst, "dst");
+        return decompressNumericBuffer(src, dst, Integer.BYTES, dst.order() != ByteOrder.nativeOrder());
+    }
+
+    public int compressLongs(LongBuffer src, ByteBuffer dst) {
+        requireDirect(src, "src");
+        return compressNumericBuffer(src, Long.BYTES, src.order() != ByteOrder.nativeOrder(), dst);
+    }
+
+    public int decompressLongs(ByteBuffer src, LongBuffer dst) {
+        requireDirect(dst, "dst");
+        return decompressNumericBuffer(src, dst, Long.BYTES, dst.order() != ByteOrder.nativeOrder());
+    }
+
+    public int compressFloats(FloatBuffer src, ByteBuffer dst) {
+        requireDirect(src, "src");
+        return compressNumericBuffer(src, Float.BYTES, src.order() != ByteOrder.nativeOrder(), dst);
+    }
+
+    public int decompressFloats(ByteBuffer src, FloatBuffer dst) {
+        requireDirect(dst, "dst");
+        return decompressNumericBuffer(src, dst, Float.BYTES, dst.order() != ByteOrder.nativeOrder());
+    }
+
+    public int compressDoubles(DoubleBuffer src, ByteBuffer dst) {
+        requireDirect(src, "src");
+        return compressNumericBuffer(src, Double.BYTES, src.order() != ByteOrder.nativeOrder(), dst);
+    }
+
+    public int decompressDoubles(ByteBuffer src, DoubleBuffer dst) {
+        requireDirect(dst, "dst");
+        return decompressNumericBuffer(src, dst, Double.BYTES, dst.order() != ByteOrder.nativeOrder());
+    }
+
+    private int compressNumericBuffer(Buffer src, int width, boolean swap, ByteBuffer dst) {
+        ensureOpen();
+        requireDirect(dst, "dst");
+        if (!src.hasRemaining()) {
+            return 0;
+        }
+        int dstPos = dst.position();
+        int written = compressNumericBufferNative(src, src.position(), src.remaining(), width, swap,
+                dst, dstPos, dst.remaining());
+        if (written < 0) {
+            throw failure("Failed to compress numeric buffer");
+        }
+        src.position(src.limit());
+        dst.position(dstPos + written);
+        return written;
+    }
+
+    private int decompressNumericBuffer(ByteBuffer src, Buffer dst, int width, boolean swap) {
+        ensureOpen();
+        requireDirect(src, "src");
+        if (!src.hasRemaining()) {
+            throw new IllegalArgumentException("compressed must not be empty");
+        }
+        int dstPos = dst.position();
+        int decoded = decompressNumericBufferNative(src, src.position(), src.remaining(),
+                dst, dstPos, dst.remaining(), width, swap);
+        if (decoded < 0) {
+            throw failure("Failed to decompress numeric buffer");
+        }
+        src.position(src.limit());
+        dst.position(dstPos + decoded);
+        return decoded;
+    }
+
+    /**
+     * Compresses the remaining bytes of a direct buffer as fixed-width records of
+     * {@code recordWidth} bytes, letting OpenZL split and specialise the record fields. The
+     * remaining length must be a multiple of {@code recordWidth}; the position is advanced.
+     */
+    public byte[] compressStructs(ByteBuffer src, int recordWidth) {
+        ensureOpen();
+        requireStructSource(src, recordWidth);
+        byte[] result = compressStructsNative(src, src.position(), src.remaining(), recordWidth);
+        if (result == null) {
+            throw failure("Failed to compress records");
+        }
+        src.position(src.limit());
+        return result;
+    }
+
+    /**
+     * Allocation-free form of {@link #compressStructs(ByteBuffer, int)} writing into a direct
+     * {@code dst}; returns the number of bytes written.
+     */
+    public int compressStructs(ByteBuffer src, int recordWidth, ByteBuffer dst) {
+        ensureOpen();
+        requireStructSource(src, recordWidth);
+        requireDirect(dst, "dst");
+        int dstPos = dst.position();
+        int written = compressStructsDirectNative(src, src.position(), src.remaining(), recordWidth,
+                dst, dstPos, dst.remaining());
+        if (written < 0) {
+            throw failure("Failed to compress records");
+        }
+        src.position(src.limit());
+        dst.position(dstPos + written);
+        return written;
+    }
+
+    /**
+     * Decompresses a frame produced by {@link #compressStructs(ByteBuffer, int)} back to its
+     * concatenated records. The record width is available from {@link #inspect(byte[])}.
+     */
+    public byte[] decompressStructs(byte[] compressed) {
+        ensureOpen();
+        Objects.requireNonNull(compressed, "compressed");
+        if (compressed.length == 0) {
+            throw new IllegalArgumentException("compressed must not be empty");
+        }
+        byte[] result = decompressStructsNative(compressed);
+        if (result == null) {
+            throw failure("Failed to decompress records");
+        }
+        return result;
+    }
+
+    /**
+     * Decompresses a struct frame into a direct {@code dst}, returning the number of bytes written.
+     */
+    public int decompressStructs(ByteBuffer src, ByteBuffer dst) {
+        ensureOpen();
+        requireDirect(src, "src");
+        requireDirect(dst, "dst");
+        if (!src.hasRemaining()) {
+            throw new IllegalArgumentException("compressed must not be empty");
+        }
+        int dstPos = dst.position();
+        int written = decompressStructsDirectNative(src, src.position(), src.remaining(), dst, dstPos, dst.remaining());
+        if (written < 0) {
+            throw failure("Failed to decompress records");
+        }
+        src.position(src.limit());
+        dst.position(dstPos + written);
+        return written;
+    }
+
+    /**
+     * Compresses an array of byte strings as an OpenZL string input, keeping the element
+     * boundaries visible to the string graphs. Elements are gathered natively, not concatenated
+     * on the heap.
+     */
+    public byte[] compressStrings(byte[][] strings) {
+        ensureOpen();
+        Objects.requireNonNull(strings, "strings");
+        long total = 0;
+        for (byte[] string : strings) {
+            total += Objects.requireNonNull(string, "strings element").length;
+        }
+        if (total > Integer.MAX_VALUE) {
+            throw new IllegalArgumentException("strings exceed 2 GiB in total");
+        }
+        byte[] result = compressStringArrayNative(strings, total);
+        if (result == null) {
+            throw failure("Failed to compress strings");
+        }
+        return result;
+    }
+
+    /**
+     * Compresses Java strings as an OpenZL string input. Each element is transcoded from
+     * UTF-16 to UTF-8 natively, producing the same frame as {@link #compressStrings(byte[][])}
+     * over {@code getBytes(UTF_8)} without the intermediate arrays.
+     */
+    public byte[] compressStrings(String[] strings) {
+        ensureOpen();
+        Objects.requireNonNull(strings, "strings");
+        long totalChars = 0;
+        for (String string : strings) {
+            totalChars += Objects.requireNonNull(string, "strings element").length();
+        }
+        if (totalChars > Integer.MAX_VALUE / 3) {
+            throw new IllegalArgumentException("strings exceed the maximum encoded size");
+        }
+        byte[] result = compressTextArrayNative(strings, totalChars);
+        if (result == null) {
+            throw failure("Failed to compress strings");
+        }
+        return result;
+    }
+
+    /**
+     * Compresses strings already packed back to back in {@code packed}, with one entry per
+     * element in {@code lengths}. Both arrays are used in place.
+     */
+    public byte[] compressStrings(byte[] packed, int[] lengths) {
+        ensureOpen();
+        Objects.requireNonNull(packed, "packed");
+        Objects.requireNonNull(lengths, "lengths");
+        long total = 0;
+        for (int length : lengths) {
+            if (length < 0) {
+                throw new IllegalArgumentException("lengths must be non-negative");
+            }
+            total += length;
+        }
+        if (total != packed.length) {
+            throw new IllegalArgumentException("lengths must sum to packed.length");
+        }
+        byte[] result = compressStringsNative(packed, lengths);
+        if (result == null) {
+            throw failure("Failed to compress strings");
+        }
+        return result;
+    }
+
+    /**
+     * Decompresses a frame produced by {@link #compressStrings(byte[][])} or
+     * {@link #compressStrings(byte[], int[])}.
+     */
+    public OpenZLStrings decompressStrings(byte[] compressed) {
+        OpenZLCompressionInfo info = inspect(compressed);
+        if (info.flavor() != OpenZLCompressionInfo.DataFlavor.STRING) {
+            throw new IllegalStateException("Compressed stream is not a string array");
+        }
+        long count = info.elementCount().orElseThrow(
+                () -> new IllegalStateException("Frame does not report a string count"));
+        if (info.originalSize() > Integer.MAX_VALUE || count > Integer.MAX_VALUE) {
+            throw new IllegalStateException("Decompressed strings are too large");
+        }
+        byte[] content = new byte[(int) info.originalSize()];
+        int[] lengths = new int[(int) count];
+        int decoded = decompressStringsNative(compressed, content, lengths);
+        if (decoded < 0) {
+            throw failure("Failed to decompress strings");
+        }
+        if (decoded != count) {
+            throw new IllegalStateException("Frame decoded to " + decoded + " strings, expected " + count);
+        }
+        return new OpenZLStrings(content, lengths);
+    }
+
+    /**
+     * Compresses every column of {@code columns} into one frame, one typed OpenZL input per
+     * column, read in place without concatenating them first. Related columns compressed
+     * together share a frame header and let the graph exploit structure across them. The
+     * compressor's graph must accept several inputs, as {@link OpenZLGraph#GENERIC} does.
+     */
+    public byte[] compressMulti(OpenZLMultiInput columns) {
+        ensureOpen();
+        Objects.requireNonNull(columns, "columns");
+        if (columns.size() == 0) {
+            throw new IllegalArgumentException("at least one column is required");
+        }
+        byte[] result = compressMultiNative(columns.data(), columns.types(), columns.widths(),
+                columns.offsets(), columns.sizes(), columns.lengths());
+        if (result == null) {
+            throw failure("Failed to compress columns");
+        }
+        return result;
+    }
+
+    /**
+     * Decompresses a frame produced by {@link #compressMulti(OpenZLMultiInput)}, decoding each
+     * output straight into a Java array sized from the frame header. Single-input frames decode
+     * to one column.
+     */
+    public OpenZLMultiOutput decompressMulti(byte[] compressed) {
+        ensureOpen();
+        Objects.requireNonNull(compressed, "compressed");
+        if (compressed.length == 0) {
+            throw new IllegalArgumentException("compressed must not be empty");
+        }
+        List<OpenZLOutputInfo> outputs;
+        try {
+            outputs = inspect(compressed).outputs();
+        } catch (IllegalStateException e) {
+            throw new OpenZLCorruptInputException("Failed to read frame outputs: " + e.getMessage(), 0);
+        }
+        int count = outputs.size();
+        OpenZLCompressionInfo.DataFlavor[] flavors = new OpenZLCompressionInfo.DataFlavor[count];
+        int[] types = new int[count];
+        int[] widths = new int[count];
+        int[] sizes = new int[count];
+        Object[] columns = new Object[count];
+        int[][] lengths = new int[count][];
+        for (int i = 0; i < count; ++i) {
+            OpenZLOutputInfo output = outputs.get(i);
+            long size = output.size();
+            long elements = output.elementCount().orElse(0);
+            if (size > Integer.MAX_VALUE || elements > Integer.MAX_VALUE) {
+                throw new IllegalStateException("Decompressed column " + i + " is too large");
+            }
+            flavors[i] = output.flavor();
+            types[i] = flavors[i].nativeCode();
+            sizes[i] = (int) size;
+            widths[i] = 1;
+            switch (flavors[i]) {
+                case NUMERIC:
+                case STRUCT:
+                    if (elements > 0) {
+                        widths[i] = (int) (size / elements);
+                        if ((long) widths[i] * elements != size) {
+                            throw new IllegalStateException("Column " + i + " has an inconsistent element width");
+                        }
+                    }
+                    columns[i] = flavors[i] == OpenZLCompressionInfo.DataFlavor.NUMERIC
+                            ? newNumericColumn(widths[i], (int) elements)
+                            : new byte[sizes[i]];
+                    break;
+                case STRING:
+                    columns[i] = new byte[sizes[i]];
+                    lengths[i] = new int[(int) elements];
+                    break;
+                case SERIAL:
+                    columns[i] = new byte[sizes[i]];
+                    break;
+                default:
+                    throw new IllegalStateException("Column " + i + " has an unknown type");
+            }
+        }
+        int decoded = decompressMultiNative(compressed, columns, types, widths, sizes, lengths);
+        if (decoded < 0) {
+            throw failure("Failed to decompress columns");
+        }
+        return new OpenZLMultiOutput(flavors, widths, columns, lengths);
+    }
+
+    private static Object newNumericColumn(int width, int elements) {
+        switch (width) {
+            case 1:
+                return new byte[elements];
+            case 2:
+                return new short[elements];
+            case 4:
+                return new int[elements];
+            case 8:
+                return new long[elements];
+            default:
+                throw new IllegalStateException("Unsupported numeric width " + width);
+        }
+    }
+
+    private static void requireStructSource(ByteBuffer src, int recordWidth) {
+        requireDirect(src, "src");
+        if (recordWidth <= 0) {
+            throw new IllegalArgumentException("recordWidth must be positive");
+        }
+        if (src.remaining() % recordWidth != 0) {
+            throw new IllegalArgumentException("src remaining bytes must be a multiple of recordWidth");
+        }
+    }
+
+    private int compressNumericInto(Object src, int width, int srcArrayLength, int srcOffset, int srcLength,
+            byte[] dst, int dstOffset) {
+        ensureOpen();
+        Objects.requireNonNull(dst, "dst");
+        checkRange(srcArrayLength, srcOffset, srcLength, "src");
+        checkRange(dst.length, dstOffset, dst.length - dstOffset, "dst");
+        if (srcLength == 0) {
+            return 0;
+        }
+        int written = compressNumericIntoNative(src, width, srcOffset, srcLength, dst, dstOffset, dst.length - dstOffset);
+        if (written < 0) {
+            throw failure("Failed to compress numeric array");
+        }
+        return written;
+    }
+
+    private int decompressNumericInto(byte[] src, int srcOffset, int srcLength, Object dst, int width,
+            int dstArrayLength, int dstOffset) {
+        ensureOpen();
+        Objects.requireNonNull(src, "src");
+        checkRange(src.length, srcOffset, srcLength, "src");
+        checkRange(dstArrayLength, dstOffset, dstArrayLength - dstOffset, "dst");
+        if (srcLength == 0) {
+            throw new IllegalArgumentException("compressed must not be empty");
+        }
+        int decoded = decompressNumericIntoNative(src, srcOffset, srcLength, dst, width, dstOffset,
+                dstArrayLength - dstOffset);
+        if (decoded < 0) {
+            throw failure("Failed to decompress numeric array");
+        }
+        return decoded;
+    }
+
+    private int compressNumericDirect(ByteBuffer src, int width, ByteBuffer dst) {
+        ensureOpen();
+        requireDirect(src, "src");
+        requireDirect(dst, "dst");
+        if (src.remaining() % width != 0) {
+            throw new IllegalArgumentException("src remaining bytes must be a multiple of " + width);
+        }
+        if (!src.hasRemaining()) {
+            return 0;
+        }
+        int dstPos = dst.position();
+        int written = compressNumericDirectNative(src, src.position(), width, src.remaining() / width,
+                dst, dstPos, dst.remaining());
+        if (written < 0) {
+            throw failure("Failed to compress numeric buffer");
+        }
+        src.position(src.limit());
+        dst.position(dstPos + written);
+        return written;
+    }
+
+    private int decompressNumericDirect(ByteBuffer src, ByteBuffer dst, int width) {
+        ensureOpen();
+        requireDirect(src, "src");
+        requireDirect(dst, "dst");
+        if (!src.hasRemaining()) {
+            throw new IllegalArgumentException("compressed must not be empty");
+        }
+        int dstPos = dst.position();
+        int decoded = decompressNumericDirectNative(src, src.position(), src.remaining(),
+                dst, width, dstPos, dst.remaining() / width);
+        if (decoded < 0) {
+            throw failure("Failed to decompress numeric buffer");
+        }
+        src.position(src.limit());
+        dst.position(dstPos + decoded * width);
+        return decoded;
+    }
+
     public OpenZLCompressionInfo inspect(byte[] compressed) {
         ensureOpen();
         Objects.requireNonNull(compressed, "compressed");
@@ -381,13 +1559,28 @@ public class OpenZLCompressor implements AutoCloseable {
         OpenZLGraph inferredGraph = OpenZLGraph.fromNativeId((int) meta[META_GRAPH_ID]);
         long elementCount = meta[META_ELEMENT_COUNT];
         int formatVersion = (int) meta[META_FORMAT_VERSION];
+        int outputCount = (int) meta[META_OUTPUT_COUNT];
+        if (meta.length != META_LENGTH + outputCount * META_OUTPUT_FIELDS) {
+            throw new IllegalStateException("Unable to inspect compressed frame outputs");
+        }
+        List<OpenZLOutputInfo> outputs = new ArrayList<>(outputCount);
+        for (int i = 0; i < outputCount; ++i) {
+            int base = META_LENGTH + i * META_OUTPUT_FIELDS;
+            outputs.add(new OpenZLOutputInfo(i,
+                    OpenZLCompressionInfo.DataFlavor.fromNative((int) meta[base]),
+                    meta[base + 1],
+                    meta[base + 2],
+                    (int) meta[base + 3]));
+        }
         return new OpenZLCompressionInfo(
                 meta[META_ORIGINAL_SIZE],
                 meta[META_COMPRESSED_SIZE],
                 inferredGraph,
                 flavor,
                 elementCount,
-                formatVersion);
+                formatVersion,
+                (int) meta[META_ELEMENT_WIDTH],
+                outputs);
     }
 
     private native byte[] compressIntsNative(int[] data);
@@ -398,9 +1591,52 @@ public class OpenZLCompressor implements AutoCloseable {
     private native long[] decompressLongsNative(byte[] data);
     private native float[] decompressFloatsNative(byte[] data);
     private native double[] decompressDoublesNative(byte[] data);
+    private native int compressNumericIntoNative(Object src, int elementWidth, int srcOffset, int srcLength,
+                                                 byte[] dst, int dstOffset, int dstLength);
+    private native int decompressNumericIntoNative(byte[] src, int srcOffset, int srcLength,
+                                                   Object dst, int elementWidth, int dstOffset, int dstLength);
+    private native int compressNumericDirectNative(ByteBuffer src, int srcPos, int elementWidth, int elementCount,
+                                                   ByteBuffer dst, int dstPos, int dstLength);
+    private native int decompressNumericDirectNative(ByteBuffer src, int srcPos, int srcLength,
+                                                     ByteBuffer dst, int elementWidth, int dstPos, int dstElements);
+    private native int compressNumericBufferNative(Buffer src, int srcPos, int elementCount, int elementWidth,
+                                                   boolean swap, ByteBuffer dst, int dstPos, int dstLength);
+    private native int decompressNumericBufferNative(ByteBuffer src, int srcPos, int srcLength, Buffer dst,
+                                                     int dstPos, int dstElements, int elementWidth, boolean swap);
+    private native byte[] compressStructsNative(ByteBuffer src, int srcPos, int srcLength, int recordWidth);
+    private native int compressStructsDirectNative(ByteBuffer src, int srcPos, int srcLength, int recordWidth,
+                                                   ByteBuffer dst, int dstPos, int dstLength);
+    private native byte[] decompressStructsNative(byte[] src);
+    private native int decompressStructsDirectNative(ByteBuffer src, int srcPos, int srcLength,
+                                                     ByteBuffer dst, int dstPos, int dstLength);
+    private native byte[] compressStringArrayNative(byte[][] strings, long totalBytes);
+    private native byte[] compressStringsNative(byte[] packed, int[] lengths);
+    private native int decompressStringsNative(byte[] src, byte[] content, int[] lengths);
+    private native byte[] compressTextArrayNative(String[] strings, long totalChars);
+    private native byte[] compressStringNative(String text);
+    private native String decompressToStringNative(byte[] src);
+    private native byte[] compressMultiNative(Object[] data, int[] types, int[] widths, int[] offsets,
+            int[] sizes, Object[] lengths);
+    private native int decompressMultiNative(byte[] src, Object[] outputs, int[] types, int[] widths,
+            int[] sizes, Object[] lengths);
     private native long[] describeFrameNative(byte[] data);
     private native long[] describeFrameDirectNative(ByteBuffer data, int position, int length);
 
+    private static void checkBatch(int sourceLength, int[] offsets, int[] lengths, int[] frameOffsets) {
+        Objects.requireNonNull(offsets, "offsets");
+        Objects.requireNonNull(lengths, "lengths");
+        Objects.requireNonNull(frameOffsets, "frameOffsets");
+        if (offsets.length != lengths.length) {
+            throw new IllegalArgumentException("offsets and lengths must have the same length");
+        }
+        if (frameOffsets.length < lengths.length + 1) {
+            throw new IllegalArgumentException("frameOffsets must hold lengths.length + 1 entries");
+        }
+        for (int i = 0; i < lengths.length; ++i) {
+            checkRange(sourceLength, offsets[i], lengths[i], "src");
+        }
+    }
+
     private static void checkRange(int arrayLength, int offset, int length, String name) {
         if (offset < 0 || length < 0 || offset > arrayLength - length) {
             throw new IndexOutOfBoundsException(
@@ -441,10 +1677,32 @@ public class OpenZLCompressor implements AutoCloseable {
     private static native byte[][] trainNative(String profileName, byte[][] inputs,
             int maxTimeSecs, int threads, int numSamples, boolean pareto);
 
-    // Helpers for tests: compress using a profile (untrained) and using a serialized (trained) compressor
+    // Helpers for tests: compress using a profile (untrained) and using a serialized (trained) compressor.
+    // compressWithProfileNative reports OpenZL failures as OpenZLException.
     public static native byte[] compressWithProfileNative(String profileName, byte[] input);
     public static native byte[] compressWithSerializedNative(String profileName, byte[] serializedCompressor, byte[] input);
 
+    /**
+     * Deserializes a trained compressor once so that it can be reused across calls and threads
+     * without rebuilding it. Close the result to release the native configuration.
+     */
+    public static OpenZLTrainedCompressor loadCompressor(String profileName, byte[] serialized) {
+        OpenZLNative.load();
+        Objects.requireNonNull(profileName, "profileName");
+        Objects.requireNonNull(serialized, "serialized");
+        return new OpenZLTrainedCompressor(loadCompressorNative(profileName, serialized));
+    }
+
+    static native long loadCompressorNative(String profileName, byte[] serialized);
+    static native void releaseCompressorNative(long handle);
+    private native void attachCompressorNative(long handle);
+
+    void attachCompressor(long handle) {
+        ensureOpen();
+        attachCompressorNative(handle);
+    }
+
+    /** Trains on in-memory samples; a {@code null} sample counts as empty. */
     public static byte[][] train(String profileName, byte[][] inputs, TrainOptions opts) {
         OpenZLNative.load();
         Objects.requireNonNull(profileName, "profileName");
@@ -452,28 +1710,63 @@ public class OpenZLCompressor implements AutoCloseable {
         if (opts == null) {
             opts = new TrainOptions();
         }
-        // Write inputs into a temporary directory and call native directory-based trainer.
-        try {
-            java.nio.file.Path tmp = java.nio.file.Files.createTempDirectory("openzl-train");
-            for (int i = 0; i < inputs.length; ++i) {
-                byte[] b = inputs[i];
-                java.nio.file.Path p = tmp.resolve(Integer.toString(i));
-                java.nio.file.Files.write(p, b == null ? new byte[0] : b);
-            }
-            try {
-                return trainFromDirectory(profileName, tmp.toString(), opts);
-            } finally {
-                // best-effort cleanup
-                for (java.nio.file.Path p : java.nio.file.Files.newDirectoryStream(tmp)) {
-                    try { java.nio.file.Files.deleteIfExists(p); } catch (Exception ignored) {}
-                }
-                try { java.nio.file.Files.deleteIfExists(tmp); } catch (Exception ignored) {}
+        return trainNative(profileName, inputs,
+                opts.maxTimeSecs, opts.threads, opts.numSamples, opts.paretoFrontier);
+    }
+
+    /**
+     * Trains on the remaining bytes of each direct buffer, read in place without copying.
+     * Buffer positions are not changed; keep the contents stable until this returns.
+     */
+    public static byte[][] train(String profileName, ByteBuffer[] samples, TrainOptions opts) {
+        OpenZLNative.load();
+        Objects.requireNonNull(profileName, "profileName");
+        Objects.requireNonNull(samples, "samples");
+        if (opts == null) {
+            opts = new TrainOptions();
+        }
+        int[] positions = new int[samples.length];
+        int[] lengths = new int[samples.length];
+        for (int i = 0; i < samples.length; ++i) {
+            ByteBuffer sample = Objects.requireNonNull(samples[i], "samples element");
+            if (!sample.isDirect()) {
+                throw new IllegalArgumentException("Training samples must be direct ByteBuffers");
             }
-        } catch (java.io.IOException ex) {
-            throw new IllegalStateException("Failed to prepare training inputs", ex);
+            positions[i] = sample.position();
+            lengths[i] = sample.remaining();
         }
+        return trainDirectNative(profileName, samples, positions, lengths,
+                opts.maxTimeSecs, opts.threads, opts.numSamples, opts.paretoFrontier);
     }
 
+    /**
+     * Starts training in the background and returns immediately. The samples are copied before
+     * this returns, so the arrays may be reused. At most two jobs train at once; later jobs wait
+     * their turn in submission order.
+     */
+    public static OpenZLTrainingJob trainAsync(String profileName, byte[][] inputs, TrainOptions opts) {
+        OpenZLNative.load();
+        Objects.requireNonNull(profileName, "profileName");
+        Objects.requireNonNull(inputs, "inputs");
+        if (opts == null) {
+            opts = new TrainOptions();
+        }
+        long handle = createTrainingJobNative(profileName, inputs,
+                opts.maxTimeSecs, opts.threads, opts.numSamples, opts.paretoFrontier);
+        return OpenZLTrainingJob.start(handle);
+    }
+
+    private static native long createTrainingJobNative(String profileName, byte[][] inputs,
+            int maxTimeSecs, int threads, int numSamples, boolean pareto);
+    static native void runTrainingJobNative(long handle);
+    static native long[] trainingProgressNative(long handle);
+    static native void cancelTrainingNative(long handle);
+    static native byte[][] trainingResultNative(long handle);
+    static native void releaseTrainingJobNative(long handle);
+
+    private static native byte[][] trainDirectNative(String profileName, ByteBuffer[] samples,
+            int[] positions, int[] lengths, int maxTimeSecs, int threads, int numSamples, boolean pareto);
+
     private static native byte[][] trainFromDirectoryNative(String profileName, String dirPath,
             int maxTimeSecs, int threads, int numSamples, boolean pareto);
 
@@ -0,0 +1,11 @@
+package io.github.hybledav;
+
+/**
+ * Thrown when compressed input is truncated, corrupted or not an OpenZL frame.
+ */
+public final class OpenZLCorruptInputException extends OpenZLException {
+
+    OpenZLCorruptInputException(String message, int errorCode) {
+        super(message, errorCode, Kind.CORRUPT_INPUT);
+    }
+}
@@ -0,0 +1,39 @@
+package io.github.hybledav;
+
+/**
+ * Process-wide totals for the time native calls spent holding {@code byte[]} arrays pinned
+ * with {@code GetPrimitiveArrayCritical}. Obtained from {@link OpenZLCompressor#criticalRegionStats()}.
+ */
+public final class OpenZLCriticalRegionStats {
+    private final long count;
+    private final long totalNanos;
+    private final long maxNanos;
+
+    OpenZLCriticalRegionStats(long count, long totalNanos, long maxNanos) {
+        this.count = count;
+        this.totalNanos = totalNanos;
+        this.maxNanos = maxNanos;
+    }
+
+    /** Number of critical regions entered. */
+    public long count() {
+        return count;
+    }
+
+    /** Combined time spent inside critical regions, in nanoseconds. */
+    public long totalNanos() {
+        return totalNanos;
+    }
+
+    /** Longest single critical region, in nanoseconds. */
+    public long maxNanos() {
+        return maxNanos;
+    }
+
+    @Override
+    public String toString() {
+        return "OpenZLCriticalRegionStats{count=" + count
+                + ", totalNanos=" + totalNanos
+                + ", maxNanos=" + maxNanos + '}';
+    }
+}
@@ -0,0 +1,48 @@
+package io.github.hybledav;
+
+/**
+ * Failure reported by the OpenZL library. {@link #errorCode()} is the raw OpenZL error code
+ * ({@code 0} when the native layer did not record one) and {@link #kind()} its coarse
+ * classification; the more specific subclasses cover the kinds callers usually handle.
+ */
+public class OpenZLException extends IllegalStateException {
+
+    public enum Kind {
+        GENERIC,
+        CORRUPT_INPUT,
+        DESTINATION_TOO_SMALL,
+        ALLOCATION
+    }
+
+    private final int errorCode;
+    private final Kind kind;
+
+    OpenZLException(String message, int errorCode, Kind kind) {
+        super(message);
+        this.errorCode = errorCode;
+        this.kind = kind;
+    }
+
+    public int errorCode() {
+        return errorCode;
+    }
+
+    public Kind kind() {
+        return kind;
+    }
+
+    // nativeKind follows NativeErrorKind in OpenZLNativeSupport.h, where 0 means no error.
+    static OpenZLException create(String message, int errorCode, int nativeKind, String detail) {
+        String fullMessage = detail == null ? message : message + ": " + detail;
+        switch (nativeKind) {
+            case 2:
+                return new OpenZLCorruptInputException(fullMessage, errorCode);
+            case 3:
+                return new OpenZLBufferTooSmallException(fullMessage, errorCode);
+            case 4:
+                return new OpenZLException(fullMessage, errorCode, Kind.ALLOCATION);
+            default:
+                return new OpenZLException(fullMessage, errorCode, Kind.GENERIC);
+        }
+    }
+}
@@ -0,0 +1,186 @@
+package io.github.hybledav;
+
+import java.io.EOFException;
+import java.io.IOException;
+import java.io.InputStream;
+import java.lang.ref.Cleaner;
+import java.util.Objects;
+
+/**
+ * {@link InputStream} that reads the length-prefixed frame sequence produced by
+ * {@link OpenZLOutputStream}. One frame is decoded at a time into an off-heap chunk buffer,
+ * so memory use follows the chunk size recorded in the stream header rather than the payload.
+ */
+public final class OpenZLInputStream extends InputStream {
+    private final InputStream in;
+    private final OpenZLCompressor compressor;
+    private final boolean ownsCompressor;
+    private final int maxChunkSize;
+    private final byte[] prefix = new byte[4];
+    private final byte[] single = new byte[1];
+    private byte[] frame = new byte[0];
+    // Created once the header has been read, since the chunk size comes from the stream.
+    private Cleaner.Cleanable cleanable;
+    private long buffer;
+    private int maxFrameSize;
+    private int chunkLength;
+    private int chunkPosition;
+    private boolean eof;
+    private boolean closed;
+
+    /** Reads streams written with any chunk size up to {@link OpenZLOutputStream#MAX_CHUNK_SIZE}. */
+    public OpenZLInputStream(InputStream in) {
+        this(in, new OpenZLCompressor(), true, OpenZLOutputStream.MAX_CHUNK_SIZE);
+    }
+
+    /**
+     * Decodes with {@code compressor}, which is not closed with the stream and must not be used
+     * concurrently while the stream is open. Accepts chunk sizes up to
+     * {@link OpenZLOutputStream#MAX_CHUNK_SIZE}.
+     */
+    public OpenZLInputStream(InputStream in, OpenZLCompressor compressor) {
+        this(in, Objects.requireNonNull(compressor, "compressor"), false, OpenZLOutputStream.MAX_CHUNK_SIZE);
+    }
+
+    /**
+     * Rejects streams whose header declares a chunk size above {@code maxChunkSize}, and frames
+     * that could not have been produced with the declared chunk size, before anything is
+     * allocated for them. Memory then stays bounded by {@code maxChunkSize} on untrusted input.
+     */
+    public OpenZLInputStream(InputStream in, OpenZLCompressor compressor, int maxChunkSize) {
+        this(in, Objects.requireNonNull(compressor, "compressor"), false, maxChunkSize);
+    }
+
+    private OpenZLInputStream(InputStream in, OpenZLCompressor compressor, boolean ownsCompressor, int maxChunkSize) {
+        this.in = Objects.requireNonNull(in, "in");
+        if (maxChunkSize <= 0) {
+            throw new IllegalArgumentException("maxChunkSize must be positive");
+        }
+        this.compressor = compressor;
+        this.ownsCompressor = ownsCompressor;
+        this.maxChunkSize = maxChunkSize;
+    }
+
+    @Override
+    public int read() throws IOException {
+        int n = read(single, 0, 1);
+        return n < 0 ? -1 : (single[0] & 0xFF);
+    }
+
+    @Override
+    public int read(byte[] b, int off, int len) throws IOException {
+        Objects.checkFromIndexSize(off, len, Objects.requireNonNull(b, "b").length);
+        ensureOpen();
+        if (len == 0) {
+            return 0;
+        }
+        while (chunkPosition == chunkLength) {
+            if (eof || !nextChunk()) {
+                return -1;
+            }
+        }
+        int copied = OpenZLCompressor.streamReadNative(buffer, chunkPosition, b, off, len);
+        chunkPosition += copied;
+        return copied;
+    }
+
+    @Override
+    public int available() throws IOException {
+        ensureOpen();
+        return chunkLength - chunkPosition;
+    }
+
+    @Override
+    public void close() throws IOException {
+        if (closed) {
+            return;
+        }
+        closed = true;
+        try {
+            in.close();
+        } finally {
+            if (cleanable != null) {
+                cleanable.clean();
+            }
+            if (ownsCompressor) {
+                compressor.close();
+            }
+        }
+    }
+
+    private boolean nextChunk() throws IOException {
+        int first = in.read();
+        if (first < 0) {
+            eof = true;
+            return false;
+        }
+        if (cleanable == null) {
+            readHeader(first);
+            return true;
+        }
+        prefix[0] = (byte) first;
+        readFully(prefix, 1, 3);
+        int frameSize = (prefix[0] & 0xFF) | (prefix[1] & 0xFF) << 8 | (prefix[2] & 0xFF) << 16 | (prefix[3] & 0xFF) << 24;
+        if (frameSize <= 0 || frameSize > maxFrameSize) {
+            throw new IOException("Corrupt OpenZL stream: invalid frame length " + Integer.toUnsignedString(frameSize));
+        }
+        if (frame.length < frameSize) {
+            frame = new byte[frameSize];
+        }
+        readFully(frame, 0, frameSize);
+        int decoded = compressor.streamDecompressNative(buffer, frame, 0, frameSize);
+        if (decoded < 0) {
+            throw new IOException("Decompression failed", compressor.failure("Stream decompression failed"));
+        }
+        chunkLength = decoded;
+        chunkPosition = 0;
+        return true;
+    }
+
+    // An empty stream has no header, so the first byte has already been read by nextChunk().
+    private void readHeader(int first) throws IOException {
+        byte[] header = new byte[OpenZLOutputStream.HEADER_SIZE];
+        header[0] = (byte) first;
+        readFully(header, 1, header.length - 1);
+        for (int i = 0; i < OpenZLOutputStream.MAGIC.length; ++i) {
+            if (header[i] != OpenZLOutputStream.MAGIC[i]) {
+                throw new IOException("Not an OpenZL stream");
+            }
+        }
+        int version = header[OpenZLOutputStream.MAGIC.length] & 0xFF;
+        if (version != OpenZLOutputStream.VERSION) {
+            throw new IOException("Unsupported OpenZL stream version " + version);
+        }
+        int at = OpenZLOutputStream.MAGIC.length + 1;
+        int chunkSize = (header[at] & 0xFF) | (header[at + 1] & 0xFF) << 8 | (header[at + 2] & 0xFF) << 16
+                | (header[at + 3] & 0xFF) << 24;
+        if (chunkSize <= 0 || chunkSize > maxChunkSize) {
+            throw new IOException("OpenZL stream chunk size " + Integer.toUnsignedString(chunkSize)
+                    + " exceeds the limit of " + maxChunkSize);
+        }
+        maxFrameSize = (int) Math.min(Integer.MAX_VALUE, OpenZLCompressor.maxCompressedSize(chunkSize));
+        long handle = OpenZLCompressor.streamBufferCreateNative(chunkSize);
+        if (handle == 0) {
+            throw new IllegalStateException("Unable to allocate stream buffer");
+        }
+        buffer = handle;
+        cleanable = OpenZLCompressor.cleaner().register(this, () -> OpenZLCompressor.streamBufferDestroyNative(handle));
+    }
+
+    private void readFully(byte[] b, int off, int len) throws IOException {
+        while (len > 0) {
+            int n = in.read(b, off, len);
+            if (n < 0) {
+                throw new EOFException("Truncated OpenZL stream");
+            }
+            off += n;
+            len -= n;
+        }
+    }
+
+    private void ensureOpen() throws IOException {
+        if (closed) {
+            throw new IOException("Stream closed");
+        }
+    }
+}
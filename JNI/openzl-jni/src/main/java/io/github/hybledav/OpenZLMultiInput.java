@@ -0,0 +1,182 @@
+package io.github.hybledav;
+
+import java.nio.ByteBuffer;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.List;
+import java.util.Objects;
+
+/**
+ * Typed columns to compress together into a single frame with
+ * {@link OpenZLCompressor#compressMulti(OpenZLMultiInput)}. Columns are referenced, not copied:
+ * arrays are pinned and direct buffers read in place during the call, so they must not change
+ * until it returns. Direct buffers contribute their remaining bytes as of {@code add*}; their
+ * positions are left untouched.
+ */
+public final class OpenZLMultiInput {
+    static final int SERIAL = 1;
+    static final int STRUCT = 2;
+    static final int NUMERIC = 4;
+    static final int STRING = 8;
+
+    private final List<Object> data = new ArrayList<>();
+    private final List<int[]> lengths = new ArrayList<>();
+    private int[] types = new int[8];
+    private int[] widths = new int[8];
+    private int[] offsets = new int[8];
+    private int[] sizes = new int[8];
+
+    public OpenZLMultiInput addInts(int[] values) {
+        Objects.requireNonNull(values, "values");
+        return add(values, NUMERIC, Integer.BYTES, 0, checkedBytes(values.length, Integer.BYTES), null);
+    }
+
+    public OpenZLMultiInput addLongs(long[] values) {
+        Objects.requireNonNull(values, "values");
+        return add(values, NUMERIC, Long.BYTES, 0, checkedBytes(values.length, Long.BYTES), null);
+    }
+
+    public OpenZLMultiInput addFloats(float[] values) {
+        Objects.requireNonNull(values, "values");
+        return add(values, NUMERIC, Float.BYTES, 0, checkedBytes(values.length, Float.BYTES), null);
+    }
+
+    public OpenZLMultiInput addDoubles(double[] values) {
+        Objects.requireNonNull(values, "values");
+        return add(values, NUMERIC, Double.BYTES, 0, checkedBytes(values.length, Double.BYTES), null);
+    }
+
+    /**
+     * Adds the remaining bytes of a direct buffer as numbers of {@code elementWidth} bytes
+     * (1, 2, 4 or 8) in native byte order.
+     */
+    public OpenZLMultiInput addNumeric(ByteBuffer values, int elementWidth) {
+        if (elementWidth != 1 && elementWidth != 2 && elementWidth != 4 && elementWidth != 8) {
+            throw new IllegalArgumentException("elementWidth must be 1, 2, 4 or 8");
+        }
+        return addDirect(values, NUMERIC, elementWidth);
+    }
+
+    /** Adds {@code records} as fixed-width records of {@code recordWidth} bytes. */
+    public OpenZLMultiInput addStructs(byte[] records, int recordWidth) {
+        Objects.requireNonNull(records, "records");
+        checkRecords(records.length, recordWidth);
+        return add(records, STRUCT, recordWidth, 0, records.length, null);
+    }
+
+    /** Adds the remaining bytes of a direct buffer as records of {@code recordWidth} bytes. */
+    public OpenZLMultiInput addStructs(ByteBuffer records, int recordWidth) {
+        requireDirect(records, "records");
+        checkRecords(records.remaining(), recordWidth);
+        return addDirect(records, STRUCT, recordWidth);
+    }
+
+    /**
+     * Adds a string column packed back to back in {@code packed}, with one entry per element
+     * in {@code lengths}.
+     */
+    public OpenZLMultiInput addStrings(byte[] packed, int[] lengths) {
+        Objects.requireNonNull(packed, "packed");
+        Objects.requireNonNull(lengths, "lengths");
+        long total = 0;
+        for (int length : lengths) {
+            if (length < 0) {
+                throw new IllegalArgumentException("lengths must be non-negative");
+            }
+            total += length;
+        }
+        if (total != packed.length) {
+            throw new IllegalArgumentException("lengths must sum to packed.length");
+        }
+        return add(packed, STRING, 1, 0, packed.length, lengths);
+    }
+
+    /** Adds untyped bytes. */
+    public OpenZLMultiInput addSerial(byte[] bytes) {
+        Objects.requireNonNull(bytes, "bytes");
+        return add(bytes, SERIAL, 1, 0, bytes.length, null);
+    }
+
+    /** Adds the remaining bytes of a direct buffer as untyped bytes. */
+    public OpenZLMultiInput addSerial(ByteBuffer bytes) {
+        return addDirect(bytes, SERIAL, 1);
+    }
+
+    public int size() {
+        return data.size();
+    }
+
+    Object[] data() {
+        return data.toArray();
+    }
+
+    int[] types() {
+        return Arrays.copyOf(types, size());
+    }
+
+    int[] widths() {
+        return Arrays.copyOf(widths, size());
+    }
+
+    int[] offsets() {
+        return Arrays.copyOf(offsets, size());
+    }
+
+    int[] sizes() {
+        return Arrays.copyOf(sizes, size());
+    }
+
+    Object[] lengths() {
+        return lengths.toArray();
+    }
+
+    private OpenZLMultiInput addDirect(ByteBuffer buffer, int type, int width) {
+        requireDirect(buffer, "buffer");
+        if (buffer.remaining() % width != 0) {
+            throw new IllegalArgumentException("remaining bytes must be a multiple of the element width");
+        }
+        return add(buffer, type, width, buffer.position(), buffer.remaining(), null);
+    }
+
+    private OpenZLMultiInput add(Object column, int type, int width, int offset, int byteSize, int[] stringLengths) {
+        int index = data.size();
+        if (index == types.length) {
+            int grown = index * 2;
+            types = Arrays.copyOf(types, grown);
+            widths = Arrays.copyOf(widths, grown);
+            offsets = Arrays.copyOf(offsets, grown);
+            sizes = Arrays.copyOf(sizes, grown);
+        }
+        data.add(column);
+        lengths.add(stringLengths);
+        types[index] = type;
+        widths[index] = width;
+        offsets[index] = offset;
+        sizes[index] = byteSize;
+        return this;
+    }
+
+    private static int checkedBytes(int count, int width) {
+        long bytes = (long) count * width;
+        if (bytes > Integer.MAX_VALUE) {
+            throw new IllegalArgumentException("column exceeds 2 GiB");
+        }
+        return (int) bytes;
+    }
+
+    private static void checkRecords(int byteSize, int recordWidth) {
+        if (recordWidth <= 0) {
+            throw new IllegalArgumentException("recordWidth must be positive");
+        }
+        if (byteSize % recordWidth != 0) {
+            throw new IllegalArgumentException("record bytes must be a multiple of recordWidth");
+        }
+    }
+
+    private static void requireDirect(ByteBuffer buffer, String name) {
+        Objects.requireNonNull(buffer, name);
+        if (!buffer.isDirect()) {
+            throw new IllegalArgumentException(name + " must be a direct ByteBuffer");
+        }
+    }
+}
@@ -0,0 +1,113 @@
+package io.github.hybledav;
+
+import java.lang.reflect.Array;
+import java.util.Locale;
+import java.util.Objects;
+
+/**
+ * The typed columns decoded from a multi-input frame by
+ * {@link OpenZLCompressor#decompressMulti(byte[])}, in the order they were added. Numeric
+ * columns are decoded into an array of their element width ({@code byte[]}, {@code short[]},
+ * {@code int[]} or {@code long[]}); the frame does not record whether 4- and 8-byte numbers
+ * were integers or floating point, so {@link #floats(int)} and {@link #doubles(int)} reinterpret
+ * the bits.
+ */
+public final class OpenZLMultiOutput {
+    private final OpenZLCompressionInfo.DataFlavor[] flavors;
+    private final int[] widths;
+    private final Object[] columns;
+    private final int[][] lengths;
+
+    OpenZLMultiOutput(OpenZLCompressionInfo.DataFlavor[] flavors, int[] widths, Object[] columns, int[][] lengths) {
+        this.flavors = flavors;
+        this.widths = widths;
+        this.columns = columns;
+        this.lengths = lengths;
+    }
+
+    public int size() {
+        return columns.length;
+    }
+
+    public OpenZLCompressionInfo.DataFlavor flavor(int index) {
+        Objects.checkIndex(index, columns.length);
+        return flavors[index];
+    }
+
+    /** Element width in bytes of a numeric or struct column; 1 for serial and string columns. */
+    public int elementWidth(int index) {
+        Objects.checkIndex(index, columns.length);
+        return widths[index];
+    }
+
+    /** A numeric column of 4-byte elements; not copied. */
+    public int[] ints(int index) {
+        return (int[]) numeric(index, Integer.BYTES);
+    }
+
+    /** A numeric column of 8-byte elements; not copied. */
+    public long[] longs(int index) {
+        return (long[]) numeric(index, Long.BYTES);
+    }
+
+    /** A numeric column of 2-byte elements; not copied. */
+    public short[] shorts(int index) {
+        return (short[]) numeric(index, Short.BYTES);
+    }
+
+    /** A numeric column of 4-byte elements converted with {@link Float#intBitsToFloat(int)}. */
+    public float[] floats(int index) {
+        int[] bits = ints(index);
+        float[] values = new float[bits.length];
+        for (int i = 0; i < bits.length; ++i) {
+            values[i] = Float.intBitsToFloat(bits[i]);
+        }
+        return values;
+    }
+
+    /** A numeric column of 8-byte elements converted with {@link Double#longBitsToDouble(long)}. */
+    public double[] doubles(int index) {
+        long[] bits = longs(index);
+        double[] values = new double[bits.length];
+        for (int i = 0; i < bits.length; ++i) {
+            values[i] = Double.longBitsToDouble(bits[i]);
+        }
+        return values;
+    }
+
+    /** A serial, struct or 1-byte numeric column; not copied. */
+    public byte[] bytes(int index) {
+        Objects.checkIndex(index, columns.length);
+        if (!(columns[index] instanceof byte[]) || flavors[index] == OpenZLCompressionInfo.DataFlavor.STRING) {
+            throw new IllegalStateException("Column " + index + " is " + describe(index));
+        }
+        return (byte[]) columns[index];
+    }
+
+    public OpenZLStrings strings(int index) {
+        Objects.checkIndex(index, columns.length);
+        if (flavors[index] != OpenZLCompressionInfo.DataFlavor.STRING) {
+            throw new IllegalStateException("Column " + index + " is " + describe(index));
+        }
+        return new OpenZLStrings((byte[]) columns[index], lengths[index]);
+    }
+
+    private Object numeric(int index, int width) {
+        Objects.checkIndex(index, columns.length);
+        // An empty column carries no width, so it reads as empty at any width.
+        if (flavors[index] == OpenZLCompressionInfo.DataFlavor.NUMERIC && Array.getLength(columns[index]) == 0) {
+            return Array.newInstance(width == Short.BYTES ? short.class : width == Integer.BYTES ? int.class : long.class, 0);
+        }
+        if (flavors[index] != OpenZLCompressionInfo.DataFlavor.NUMERIC || widths[index] != width) {
+            throw new IllegalStateException("Column " + index + " is " + describe(index)
+                    + ", not " + width + "-byte numeric");
+        }
+        return columns[index];
+    }
+
+    private String describe(int index) {
+        return flavors[index] == OpenZLCompressionInfo.DataFlavor.NUMERIC
+                ? widths[index] + "-byte numeric"
+                : flavors[index].name().toLowerCase(Locale.ROOT);
+    }
+}
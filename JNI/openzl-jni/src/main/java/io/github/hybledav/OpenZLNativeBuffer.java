@@ -0,0 +1,65 @@
+package io.github.hybledav;
+
+import java.lang.ref.Cleaner;
+import java.nio.ByteBuffer;
+
+/**
+ * Result of {@link OpenZLCompressor#compressToNative} / {@link OpenZLCompressor#decompressToNative}
+ * that stays in native memory. {@link #buffer()} exposes the bytes as a direct {@link ByteBuffer}
+ * without copying them onto the Java heap, which suits callers that hand the result straight to
+ * a channel.
+ * <p>
+ * Call {@link #close()} once the bytes are consumed so the block returns to the native pool
+ * immediately. Otherwise it is reclaimed after the view and every slice of it become
+ * unreachable. The view must not be used after {@code close()}.
+ */
+public final class OpenZLNativeBuffer implements AutoCloseable {
+    private final ByteBuffer view;
+    private final Cleaner.Cleanable cleanable;
+    private final int size;
+    private volatile boolean released;
+
+    OpenZLNativeBuffer(long handle) {
+        this.view = OpenZLCompressor.nativeBufferViewNative(handle);
+        this.size = view.capacity();
+        // Registered on the view so slices handed to other code keep the block alive.
+        this.cleanable = OpenZLCompressor.cleaner().register(view, new Release(handle));
+    }
+
+    /**
+     * Returns a new view over the result with position {@code 0} and limit {@link #size()}.
+     */
+    public ByteBuffer buffer() {
+        if (released) {
+            throw new IllegalStateException("Native buffer already released");
+        }
+        return view.duplicate().clear();
+    }
+
+    public int size() {
+        return size;
+    }
+
+    public boolean isReleased() {
+        return released;
+    }
+
+    @Override
+    public void close() {
+        released = true;
+        cleanable.clean();
+    }
+
+    private static final class Release implements Runnable {
+        private final long handle;
+
+        private Release(long handle) {
+            this.handle = handle;
+        }
+
+        @Override
+        public void run() {
+            OpenZLCompressor.nativeBufferReleaseNative(handle);
+        }
+    }
+}
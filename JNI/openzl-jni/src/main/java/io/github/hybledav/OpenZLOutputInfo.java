@@ -0,0 +1,60 @@
+package io.github.hybledav;
+
+import java.util.Locale;
+import java.util.Objects;
+import java.util.OptionalInt;
+import java.util.OptionalLong;
+
+/**
+ * Header information for one output of a frame, as listed by
+ * {@link OpenZLCompressionInfo#outputs()}. Multi-input frames have one output per column.
+ */
+public final class OpenZLOutputInfo {
+    private final int index;
+    private final OpenZLCompressionInfo.DataFlavor flavor;
+    private final long size;
+    private final long elementCount;
+    private final int elementWidth;
+
+    OpenZLOutputInfo(int index, OpenZLCompressionInfo.DataFlavor flavor, long size, long elementCount, int elementWidth) {
+        this.index = index;
+        this.flavor = Objects.requireNonNull(flavor, "flavor");
+        this.size = size;
+        this.elementCount = elementCount;
+        this.elementWidth = elementWidth;
+    }
+
+    public int index() {
+        return index;
+    }
+
+    public OpenZLCompressionInfo.DataFlavor flavor() {
+        return flavor;
+    }
+
+    /** Decompressed size in bytes; for string outputs, the size of the packed content. */
+    public long size() {
+        return size;
+    }
+
+    public OptionalLong elementCount() {
+        return elementCount >= 0 ? OptionalLong.of(elementCount) : OptionalLong.empty();
+    }
+
+    /** Width in bytes of each element of a struct or numeric output. */
+    public OptionalInt elementWidth() {
+        return elementWidth > 0 ? OptionalInt.of(elementWidth) : OptionalInt.empty();
+    }
+
+    @Override
+    public String toString() {
+        return String.format(
+                Locale.ROOT,
+                "OpenZLOutputInfo{index=%d, flavor=%s, size=%d, elements=%s, width=%s}",
+                index,
+                flavor,
+                size,
+                elementCount >= 0 ? elementCount : "n/a",
+                elementWidth > 0 ? elementWidth : "n/a");
+    }
+}
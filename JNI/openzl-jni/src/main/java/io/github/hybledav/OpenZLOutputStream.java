@@ -0,0 +1,151 @@
+package io.github.hybledav;
+
+import java.io.IOException;
+import java.io.OutputStream;
+import java.lang.ref.Cleaner;
+import java.util.Arrays;
+import java.util.Objects;
+
+/**
+ * {@link OutputStream} that compresses everything written to it as a sequence of independent
+ * OpenZL frames, each preceded by its compressed length as a little-endian {@code int}. The
+ * frames follow a short header recording the chunk size, which readers use to bound their
+ * buffers; a stream nothing was written to stays empty.
+ * <p>
+ * Written bytes are accumulated off-heap until {@code chunkSize} bytes are buffered, then that
+ * chunk is compressed and forwarded to the wrapped stream. Memory use is proportional to the
+ * chunk size rather than the payload. Read the result back with {@link OpenZLInputStream}.
+ */
+public final class OpenZLOutputStream extends OutputStream {
+    public static final int DEFAULT_CHUNK_SIZE = 1 << 20;
+    /** Largest accepted chunk size, and the largest one {@link OpenZLInputStream} reads by default. */
+    public static final int MAX_CHUNK_SIZE = 64 << 20;
+
+    // Header: magic, format version, then the chunk size as a little-endian int.
+    static final byte[] MAGIC = {'O', 'Z', 'L', 'S'};
+    static final int VERSION = 1;
+    static final int HEADER_SIZE = MAGIC.length + 1 + 4;
+    private static final int TRANSFER_SIZE = 64 * 1024;
+
+    private final OutputStream out;
+    private final OpenZLCompressor compressor;
+    private final boolean ownsCompressor;
+    private final int chunkSize;
+    private final Cleaner.Cleanable cleanable;
+    private final long buffer;
+    private final byte[] transfer = new byte[TRANSFER_SIZE];
+    private final byte[] single = new byte[1];
+    private int pending;
+    private boolean headerWritten;
+    private boolean closed;
+
+    public OpenZLOutputStream(OutputStream out) {
+        this(out, new OpenZLCompressor(), true, DEFAULT_CHUNK_SIZE);
+    }
+
+    /**
+     * Uses {@code compressor}'s graph, profile and parameters for every chunk. The compressor is
+     * not closed with the stream and must not be used concurrently while the stream is open.
+     */
+    public OpenZLOutputStream(OutputStream out, OpenZLCompressor compressor, int chunkSize) {
+        this(out, Objects.requireNonNull(compressor, "compressor"), false, chunkSize);
+    }
+
+    private OpenZLOutputStream(OutputStream out, OpenZLCompressor compressor, boolean ownsCompressor,
+            int chunkSize) {
+        this.out = Objects.requireNonNull(out, "out");
+        if (chunkSize <= 0 || chunkSize > MAX_CHUNK_SIZE) {
+            throw new IllegalArgumentException("chunkSize must be between 1 and " + MAX_CHUNK_SIZE);
+        }
+        this.compressor = compressor;
+        this.ownsCompressor = ownsCompressor;
+        this.chunkSize = chunkSize;
+        long handle = OpenZLCompressor.streamBufferCreateNative(chunkSize);
+        if (handle == 0) {
+            throw new IllegalStateException("Unable to allocate stream buffer");
+        }
+        this.buffer = handle;
+        this.cleanable = OpenZLCompressor.cleaner().register(this, () -> OpenZLCompressor.streamBufferDestroyNative(handle));
+    }
+
+    @Override
+    public void write(int b) throws IOException {
+        single[0] = (byte) b;
+        write(single, 0, 1);
+    }
+
+    @Override
+    public void write(byte[] b, int off, int len) throws IOException {
+        Objects.checkFromIndexSize(off, len, Objects.requireNonNull(b, "b").length);
+        ensureOpen();
+        while (len > 0) {
+            int consumed = OpenZLCompressor.streamAppendNative(buffer, b, off, len);
+            pending += consumed;
+            off += consumed;
+            len -= consumed;
+            if (pending == chunkSize) {
+                emitChunk();
+            }
+        }
+    }
+
+    /**
+     * Compresses any partially filled chunk and flushes the wrapped stream. Frequent flushes
+     * produce smaller frames and a lower compression ratio.
+     */
+    @Override
+    public void flush() throws IOException {
+        ensureOpen();
+        if (pending > 0) {
+            emitChunk();
+        }
+        out.flush();
+    }
+
+    @Override
+    public void close() throws IOException {
+        if (closed) {
+            return;
+        }
+        try {
+            if (pending > 0) {
+                emitChunk();
+            }
+            out.close();
+        } finally {
+            closed = true;
+            cleanable.clean();
+            if (ownsCompressor) {
+                compressor.close();
+            }
+        }
+    }
+
+    private void emitChunk() throws IOException {
+        int frameSize = compressor.streamCompressNative(buffer);
+        if (frameSize < 0) {
+            throw new IOException("Compression failed", compressor.failure("Stream compression failed"));
+        }
+        pending = 0;
+        if (!headerWritten) {
+            byte[] header = Arrays.copyOf(MAGIC, HEADER_SIZE);
+            header[MAGIC.length] = (byte) VERSION;
+            for (int i = 0; i < 4; ++i) {
+                header[MAGIC.length + 1 + i] = (byte) (chunkSize >>> (8 * i));
+            }
+            out.write(header);
+            headerWritten = true;
+        }
+        for (int position = 0; position < frameSize; ) {
+            int copied = OpenZLCompressor.streamReadNative(buffer, position, transfer, 0, transfer.length);
+            out.write(transfer, 0, copied);
+            position += copied;
+        }
+    }
+
+    private void ensureOpen() throws IOException {
+        if (closed) {
+            throw new IOException("Stream closed");
+        }
+    }
+}
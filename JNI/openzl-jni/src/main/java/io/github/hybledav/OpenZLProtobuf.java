@@ -326,6 +326,49 @@ public final class OpenZLProtobuf {
                 descriptor.getFullName());
     }
 
+    /**
+     * Starts {@link #train(byte[][], Protocol, TrainOptions, String)} in the background and
+     * returns immediately. The samples are parsed before this returns, so the arrays may be
+     * reused. The job shares the running limit of {@link OpenZLCompressor#trainAsync}; it reports
+     * no compression ratio.
+     */
+    public static OpenZLTrainingJob trainAsync(byte[][] samples,
+            Protocol inputProtocol,
+            TrainOptions options,
+            String messageType) {
+        Objects.requireNonNull(samples, "samples");
+        Objects.requireNonNull(inputProtocol, "inputProtocol");
+        Objects.requireNonNull(messageType, "messageType");
+        for (int i = 0; i < samples.length; ++i) {
+            if (samples[i] == null) {
+                throw new NullPointerException("samples[" + i + "]");
+            }
+        }
+
+        TrainOptions opts = options == null ? new TrainOptions() : options;
+        OpenZLNative.load();
+        long handle = createTrainingJobNative(samples,
+                inputProtocol.id(),
+                opts.maxTimeSecs,
+                opts.threads,
+                opts.numSamples,
+                opts.paretoFrontier,
+                messageType);
+        return OpenZLTrainingJob.start(handle);
+    }
+
+    public static OpenZLTrainingJob trainAsync(byte[][] samples,
+            Protocol inputProtocol,
+            TrainOptions options,
+            Descriptors.Descriptor descriptor) {
+        Objects.requireNonNull(descriptor, "descriptor");
+        registerSchema(descriptor.getFile());
+        return trainAsync(samples,
+                inputProtocol,
+                options,
+                descriptor.getFullName());
+    }
+
     /**
      * Returns a JSON representation of the native compressor graph used for the
      * provided protobuf message type.
@@ -550,6 +593,19 @@ public final class OpenZLProtobuf {
                 values[4]);
     }
 
+    /**
+     * Reports the background worker that trains compressors from samples collected by
+     * {@code convert}. Converts keep using the current compressor until a run finishes.
+     */
+    public static AutoTrainingStatus autoTrainingStatus() {
+        OpenZLNative.load();
+        long[] values = autoTrainingStatusNative();
+        if (values == null || values.length < 4) {
+            throw new IllegalStateException("Native auto-training status failed");
+        }
+        return new AutoTrainingStatus(values[0], values[1] != 0L, values[2], values[3]);
+    }
+
     public static long[] structuredProfileValues() {
         OpenZLNative.load();
         long[] values = structuredProfileNative();
@@ -610,6 +666,43 @@ public final class OpenZLProtobuf {
         }
     }
 
+    public static final class AutoTrainingStatus {
+        private final long queued;
+        private final boolean running;
+        private final long completed;
+        private final long lastDurationNanos;
+
+        public AutoTrainingStatus(long queued, boolean running, long completed, long lastDurationNanos) {
+            this.queued = queued;
+            this.running = running;
+            this.completed = completed;
+            this.lastDurationNanos = lastDurationNanos;
+        }
+
+        /** Training runs waiting for the worker, not counting the one in progress. */
+        public long queued() {
+            return queued;
+        }
+
+        public boolean running() {
+            return running;
+        }
+
+        /** Queued plus in-progress runs. */
+        public long queueDepth() {
+            return queued + (running ? 1 : 0);
+        }
+
+        public long completed() {
+            return completed;
+        }
+
+        /** Duration of the most recent finished run; zero before the first one. */
+        public long lastDurationNanos() {
+            return lastDurationNanos;
+        }
+    }
+
     public static final class StructuredProfileSnapshot {
         private final boolean enabled;
         private final long pinNanos;
@@ -705,6 +798,7 @@ public final class OpenZLProtobuf {
 
     private static native long[] directIntoProfileNative();
     private static native long[] structuredProfileNative();
+    private static native long[] autoTrainingStatusNative();
 
     private static native byte[][] trainNative(byte[][] samples,
             int inputProtocol,
@@ -714,6 +808,14 @@ public final class OpenZLProtobuf {
             boolean pareto,
             String messageType);
 
+    private static native long createTrainingJobNative(byte[][] samples,
+            int inputProtocol,
+            int maxTimeSecs,
+            int threads,
+            int numSamples,
+            boolean pareto,
+            String messageType);
+
     private static native void configureTrainingNative(String messageType, int minSamples);
 
     private static native void registerSchemaNative(byte[] descriptorSet);
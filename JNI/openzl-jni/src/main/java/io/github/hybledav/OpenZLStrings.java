@@ -0,0 +1,68 @@
+package io.github.hybledav;
+
+import java.nio.charset.StandardCharsets;
+import java.util.Arrays;
+import java.util.Objects;
+
+/**
+ * A decoded string array in packed form: every element's bytes back to back in
+ * {@link #content()}, with the element sizes in {@link #lengths()}. Produced by
+ * {@link OpenZLCompressor#decompressStrings(byte[])}.
+ */
+public final class OpenZLStrings {
+    private final byte[] content;
+    private final int[] lengths;
+    private final int[] offsets;
+
+    OpenZLStrings(byte[] content, int[] lengths) {
+        this.content = Objects.requireNonNull(content, "content");
+        this.lengths = Objects.requireNonNull(lengths, "lengths");
+        this.offsets = new int[lengths.length];
+        int offset = 0;
+        for (int i = 0; i < lengths.length; ++i) {
+            offsets[i] = offset;
+            offset += lengths[i];
+        }
+    }
+
+    public int count() {
+        return lengths.length;
+    }
+
+    /** Packed element bytes; not copied, so changes are visible to this instance. */
+    public byte[] content() {
+        return content;
+    }
+
+    /** Element sizes in bytes; not copied. */
+    public int[] lengths() {
+        return lengths;
+    }
+
+    /** Start of element {@code index} within {@link #content()}. */
+    public int offset(int index) {
+        Objects.checkIndex(index, lengths.length);
+        return offsets[index];
+    }
+
+    /** Copy of element {@code index}. */
+    public byte[] get(int index) {
+        Objects.checkIndex(index, lengths.length);
+        return Arrays.copyOfRange(content, offsets[index], offsets[index] + lengths[index]);
+    }
+
+    /** Element {@code index} decoded as UTF-8. */
+    public String getString(int index) {
+        Objects.checkIndex(index, lengths.length);
+        return new String(content, offsets[index], lengths[index], StandardCharsets.UTF_8);
+    }
+
+    /** Copies every element into its own array. */
+    public byte[][] toArray() {
+        byte[][] result = new byte[lengths.length][];
+        for (int i = 0; i < result.length; ++i) {
+            result[i] = get(i);
+        }
+        return result;
+    }
+}
@@ -0,0 +1,131 @@
+package io.github.hybledav;
+
+import java.lang.ref.Cleaner;
+import java.nio.ByteBuffer;
+import java.util.Objects;
+import java.util.concurrent.ConcurrentLinkedQueue;
+
+/**
+ * A trained compressor deserialized once by {@link OpenZLCompressor#loadCompressor(String, byte[])}.
+ * Calls borrow a native context already bound to the trained configuration from an internal
+ * pool, so one instance can be shared between threads.
+ */
+public final class OpenZLTrainedCompressor implements AutoCloseable {
+    private final ConcurrentLinkedQueue<OpenZLCompressor> idle = new ConcurrentLinkedQueue<>();
+    private final HandleReleaser releaser;
+    private final Cleaner.Cleanable cleanable;
+    private volatile boolean closed;
+
+    OpenZLTrainedCompressor(long handle) {
+        releaser = new HandleReleaser(handle);
+        cleanable = OpenZLCompressor.cleaner().register(this, releaser);
+    }
+
+    public byte[] compress(byte[] input) {
+        Objects.requireNonNull(input, "input");
+        OpenZLCompressor compressor = borrow();
+        try {
+            return compressor.compressChecked(input);
+        } finally {
+            giveBack(compressor);
+        }
+    }
+
+    public int compress(byte[] input, int inputOffset, int inputLength,
+            byte[] output, int outputOffset, int outputLength) {
+        OpenZLCompressor compressor = borrow();
+        try {
+            return compressor.compress(input, inputOffset, inputLength, output, outputOffset, outputLength);
+        } finally {
+            giveBack(compressor);
+        }
+    }
+
+    public int compress(ByteBuffer src, ByteBuffer dst) {
+        OpenZLCompressor compressor = borrow();
+        try {
+            return compressor.compress(src, dst);
+        } finally {
+            giveBack(compressor);
+        }
+    }
+
+    public byte[] decompress(byte[] input) {
+        Objects.requireNonNull(input, "input");
+        OpenZLCompressor compressor = borrow();
+        try {
+            return compressor.decompressChecked(input);
+        } finally {
+            giveBack(compressor);
+        }
+    }
+
+    /** Number of idle native contexts kept for reuse. */
+    public int pooledContexts() {
+        return idle.size();
+    }
+
+    @Override
+    public void close() {
+        synchronized (this) {
+            if (closed) {
+                return;
+            }
+            closed = true;
+            OpenZLCompressor compressor;
+            while ((compressor = idle.poll()) != null) {
+                compressor.close();
+            }
+        }
+        // Borrowed contexts keep their own reference to the configuration, so calls in flight
+        // finish normally and close their context when they hand it back.
+        cleanable.clean();
+    }
+
+    private OpenZLCompressor borrow() {
+        if (closed) {
+            throw new IllegalStateException("Trained compressor already closed");
+        }
+        OpenZLCompressor compressor = idle.poll();
+        if (compressor != null) {
+            return compressor;
+        }
+        synchronized (this) {
+            if (closed) {
+                throw new IllegalStateException("Trained compressor already closed");
+            }
+            compressor = new OpenZLCompressor();
+            try {
+                compressor.attachCompressor(releaser.handle);
+            } catch (RuntimeException ex) {
+                compressor.close();
+                throw ex;
+            }
+            return compressor;
+        }
+    }
+
+    private void giveBack(OpenZLCompressor compressor) {
+        idle.offer(compressor);
+        if (closed && idle.remove(compressor)) {
+            compressor.close();
+        }
+    }
+
+    private static final class HandleReleaser implements Runnable {
+        private long handle;
+
+        private HandleReleaser(long handle) {
+            this.handle = handle;
+        }
+
+        @Override
+        public synchronized void run() {
+            if (handle == 0) {
+                return;
+            }
+            OpenZLCompressor.releaseCompressorNative(handle);
+            handle = 0;
+        }
+    }
+}
@@ -0,0 +1,150 @@
+package io.github.hybledav;
+
+import java.time.Duration;
+import java.util.OptionalDouble;
+import java.util.concurrent.CancellationException;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
+/**
+ * A training run started by {@link OpenZLCompressor#trainAsync(String, byte[][], TrainOptions)} or
+ * {@link OpenZLProtobuf#trainAsync(byte[][], OpenZLProtobuf.Protocol, TrainOptions, String)}.
+ * The result completes with the serialized candidates once the native trainer returns.
+ *
+ * <p>Cancellation completes the result with a {@link CancellationException} at once. A job still
+ * waiting for a turn never starts. A running trainer stops at the next candidate compressor it
+ * builds on the job's own thread; candidates built on its worker threads ({@code threads > 1})
+ * are no longer measured, and the run ends at its time budget at the latest. Whatever it found
+ * is discarded.
+ */
+public final class OpenZLTrainingJob {
+    private static final int STATUS = 0;
+    private static final int CANDIDATES = 1;
+    private static final int ELAPSED_NANOS = 2;
+    private static final int BEST_RATIO_BITS = 3;
+    static final long RUNNING = 0;
+    static final long CANCELLED = 3;
+
+    // Each job already trains on opts.threads threads, so only a couple run side by side.
+    private static final int MAX_RUNNING_JOBS = 2;
+    private static final ExecutorService RUNNER = Executors.newFixedThreadPool(MAX_RUNNING_JOBS, task -> {
+        Thread thread = new Thread(task, "openzl-training");
+        thread.setDaemon(true);
+        return thread;
+    });
+
+    private final CompletableFuture<byte[][]> result = new CompletableFuture<>();
+    private final CompletableFuture<Void> stopped = new CompletableFuture<>();
+    private final long handle;
+    private boolean released;
+    private long[] lastProgress = {RUNNING, 0, 0, Double.doubleToRawLongBits(Double.NaN)};
+
+    private OpenZLTrainingJob(long handle) {
+        this.handle = handle;
+        result.whenComplete((value, error) -> {
+            if (error instanceof CancellationException) {
+                requestCancel();
+            }
+        });
+    }
+
+    static OpenZLTrainingJob start(long handle) {
+        OpenZLTrainingJob job = new OpenZLTrainingJob(handle);
+        RUNNER.execute(job::run);
+        return job;
+    }
+
+    /** The serialized candidates, as returned by the matching blocking {@code train} call. */
+    public CompletableFuture<byte[][]> result() {
+        return result;
+    }
+
+    /** Number of candidate compressors the trainer has built and evaluated so far. */
+    public long candidatesEvaluated() {
+        return progress()[CANDIDATES];
+    }
+
+    /**
+     * Best compression ratio among the candidates measured so far. One candidate in sixteen is
+     * measured, on up to 64 KiB of the samples; empty until the first one has been, and always
+     * empty for protobuf jobs, whose candidates take structured inputs.
+     */
+    public OptionalDouble bestRatio() {
+        double ratio = Double.longBitsToDouble(progress()[BEST_RATIO_BITS]);
+        return Double.isNaN(ratio) ? OptionalDouble.empty() : OptionalDouble.of(ratio);
+    }
+
+    /** Time since the job was submitted, frozen once the native run returns. */
+    public Duration elapsed() {
+        return Duration.ofNanos(progress()[ELAPSED_NANOS]);
+    }
+
+    public boolean isDone() {
+        return result.isDone();
+    }
+
+    public boolean cancel() {
+        return result.cancel(false);
+    }
+
+    // Completes once the native run has returned and released its memory, which after a
+    // cancellation can be later than the result.
+    CompletableFuture<Void> stopped() {
+        return stopped;
+    }
+
+    long status() {
+        return progress()[STATUS];
+    }
+
+    private synchronized long[] progress() {
+        if (!released) {
+            lastProgress = OpenZLCompressor.trainingProgressNative(handle);
+        }
+        return lastProgress;
+    }
+
+    private synchronized void requestCancel() {
+        if (!released) {
+            OpenZLCompressor.cancelTrainingNative(handle);
+        }
+    }
+
+    private void run() {
+        try {
+            OpenZLCompressor.runTrainingJobNative(handle);
+        } finally {
+            finish();
+        }
+    }
+
+    private void finish() {
+        byte[][] trained = null;
+        RuntimeException failure = null;
+        boolean cancelled;
+        synchronized (this) {
+            try {
+                lastProgress = OpenZLCompressor.trainingProgressNative(handle);
+                cancelled = lastProgress[STATUS] == CANCELLED;
+                if (!cancelled) {
+                    trained = OpenZLCompressor.trainingResultNative(handle);
+                }
+            } catch (RuntimeException ex) {
+                cancelled = false;
+                failure = ex;
+            } finally {
+                released = true;
+                OpenZLCompressor.releaseTrainingJobNative(handle);
+            }
+        }
+        if (cancelled) {
+            result.cancel(false);
+        } else if (failure != null) {
+            result.completeExceptionally(failure);
+        } else {
+            result.complete(trained);
+        }
+        stopped.complete(null);
+    }
+}
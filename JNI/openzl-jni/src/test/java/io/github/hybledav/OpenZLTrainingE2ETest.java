@@ -7,6 +7,7 @@ import org.junit.jupiter.api.Test;
 
 import java.util.ArrayList;
 import java.util.List;
+import java.util.concurrent.TimeUnit;
 
 import static org.junit.jupiter.api.Assertions.assertFalse;
 import static org.junit.jupiter.api.Assertions.assertTrue;
@@ -62,6 +63,34 @@ class OpenZLTrainingE2ETest {
         assertTrue(bestSize < baseline.length, "trained compressor should reduce payload size");
     }
 
+    @Test
+    void asyncTrainingYieldsUsableCompressors() throws Exception {
+        Descriptors.Descriptor descriptor = telemetryDescriptor();
+        Descriptors.FieldDescriptor sensorId = descriptor.findFieldByName("sensor_id");
+        Descriptors.FieldDescriptor readings = descriptor.findFieldByName("reading");
+
+        byte[][] samples = new byte[12][];
+        for (int i = 0; i < samples.length; i++) {
+            samples[i] = sample(descriptor, sensorId, readings, i).toByteArray();
+        }
+        TrainOptions opts = new TrainOptions();
+        opts.maxTimeSecs = 1;
+        OpenZLTrainingJob job = OpenZLProtobuf.trainAsync(samples, OpenZLProtobuf.Protocol.PROTO, opts, descriptor);
+        byte[][] trained = job.result().get(120, TimeUnit.SECONDS);
+
+        assertTrue(trained.length > 0);
+        assertTrue(job.candidatesEvaluated() > 0);
+        assertFalse(job.bestRatio().isPresent());
+        DynamicMessage validationMessage = sample(descriptor, sensorId, readings, 99);
+        byte[] encoded = OpenZLProtobuf.convert(
+                validationMessage.toByteArray(),
+                OpenZLProtobuf.Protocol.PROTO,
+                OpenZLProtobuf.Protocol.ZL,
+                trained[0],
+                descriptor);
+        assertTrue(encoded.length > 0);
+    }
+
     private static Descriptors.Descriptor telemetryDescriptor() throws Descriptors.DescriptorValidationException {
         DescriptorProtos.DescriptorProto telemetry = DescriptorProtos.DescriptorProto.newBuilder()
                 .setName("Telemetry")
@@ -0,0 +1,140 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import org.junit.jupiter.api.Test;
+
+class TestCompressionPresets {
+
+    private static final int CPARAM_COMPRESSION_LEVEL = 2;
+
+    private static byte[] payload() {
+        return "preset payload, preset payload, preset payload ".repeat(200).getBytes(StandardCharsets.UTF_8);
+    }
+
+    @Test
+    void compressorsWithSameConfigurationProduceSameFrames() {
+        byte[] input = payload();
+        try (OpenZLCompressor first = new OpenZLCompressor(OpenZLGraph.GENERIC);
+             OpenZLCompressor second = new OpenZLCompressor(OpenZLGraph.GENERIC)) {
+            first.setCompressionLevel(OpenZLCompressionLevel.LEVEL_3);
+            second.setCompressionLevel(OpenZLCompressionLevel.LEVEL_3);
+            assertArrayEquals(first.compress(input), second.compress(input));
+        }
+    }
+
+    @Test
+    void parametersDoNotLeakIntoOtherCompressors() {
+        try (OpenZLCompressor tuned = new OpenZLCompressor();
+             OpenZLCompressor plain = new OpenZLCompressor()) {
+            int defaultLevel = plain.getParameter(CPARAM_COMPRESSION_LEVEL);
+            tuned.setCompressionLevel(OpenZLCompressionLevel.LEVEL_1);
+            assertEquals(OpenZLCompressionLevel.LEVEL_1, tuned.getCompressionLevel());
+            assertEquals(defaultLevel, plain.getParameter(CPARAM_COMPRESSION_LEVEL));
+        }
+    }
+
+    @Test
+    void repeatedParameterChangesMatchDirectConfiguration() {
+        byte[] input = payload();
+        try (OpenZLCompressor toggled = new OpenZLCompressor(OpenZLGraph.GENERIC);
+             OpenZLCompressor direct = new OpenZLCompressor(OpenZLGraph.GENERIC)) {
+            for (int i = 0; i < 1000; ++i) {
+                toggled.setCompressionLevel(i % 2 == 0 ? OpenZLCompressionLevel.LEVEL_1 : OpenZLCompressionLevel.LEVEL_3);
+            }
+            direct.setCompressionLevel(OpenZLCompressionLevel.LEVEL_3);
+            assertEquals(direct.serialize(), toggled.serialize());
+            assertArrayEquals(direct.compress(input), toggled.compress(input));
+        }
+    }
+
+    @Test
+    void recycledStateDropsProfileConfiguration() {
+        byte[] input = payload();
+        byte[] expected;
+        try (OpenZLCompressor reference = new OpenZLCompressor()) {
+            expected = reference.compress(input);
+        }
+        for (int i = 0; i < 8; ++i) {
+            try (OpenZLCompressor profiled = new OpenZLCompressor()) {
+                profiled.configureProfile(OpenZLProfile.SERIAL, Map.of());
+                assertArrayEquals(input, profiled.decompress(profiled.compress(input)));
+            }
+        }
+        try (OpenZLCompressor reused = new OpenZLCompressor()) {
+            assertArrayEquals(expected, reused.compress(input));
+        }
+    }
+
+    @Test
+    void profileHelperReusesCompressorAcrossCallsAndThreads() throws Exception {
+        byte[] csv = "id,name\n1,alpha\n2,beta\n3,gamma\n".repeat(100).getBytes(StandardCharsets.UTF_8);
+        byte[] serial = payload();
+        byte[] expectedCsv = OpenZLCompressor.compressWithProfileNative("csv", csv);
+        byte[] expectedSerial = OpenZLCompressor.compressWithProfileNative("serial", serial);
+
+        ExecutorService pool = Executors.newFixedThreadPool(4);
+        try {
+            List<Future<?>> futures = new ArrayList<>();
+            for (int t = 0; t < 4; ++t) {
+                futures.add(pool.submit(() -> {
+                    // Alternating profiles moves pooled states between cached presets.
+                    for (int i = 0; i < 25; ++i) {
+                        assertArrayEquals(expectedCsv, OpenZLCompressor.compressWithProfileNative("csv", csv));
+                        assertArrayEquals(expectedSerial, OpenZLCompressor.compressWithProfileNative("serial", serial));
+                    }
+                    return null;
+                }));
+            }
+            for (Future<?> future : futures) {
+                future.get();
+            }
+        } finally {
+            pool.shutdownNow();
+        }
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            assertArrayEquals(csv, compressor.decompress(expectedCsv));
+        }
+        assertThrows(IllegalArgumentException.class,
+                () -> OpenZLCompressor.compressWithProfileNative("no-such-profile", csv));
+    }
+
+    @Test
+    void profileArgumentsShareOnePresetWhateverTheirOrder() {
+        byte[] input = payload();
+        Map<String, String> forward = new LinkedHashMap<>();
+        forward.put("alpha", "1");
+        forward.put("beta", "x;y=z");
+        Map<String, String> backward = new LinkedHashMap<>();
+        backward.put("beta", "x;y=z");
+        backward.put("alpha", "1");
+        try (OpenZLCompressor first = new OpenZLCompressor();
+             OpenZLCompressor second = new OpenZLCompressor()) {
+            for (int i = 0; i < 4; ++i) {
+                first.configureProfile(OpenZLProfile.SERIAL, forward);
+                second.configureProfile(OpenZLProfile.SERIAL, backward);
+            }
+            assertEquals(first.serialize(), second.serialize());
+            assertArrayEquals(first.compress(input), second.compress(input));
+        }
+    }
+
+    @Test
+    void configuredProfileMatchesAcrossCompressors() {
+        byte[] input = payload();
+        try (OpenZLCompressor first = new OpenZLCompressor();
+             OpenZLCompressor second = new OpenZLCompressor()) {
+            first.configureProfile(OpenZLProfile.SERIAL);
+            second.configureProfile(OpenZLProfile.SERIAL);
+            assertArrayEquals(first.compress(input), second.compress(input));
+        }
+    }
+}
@@ -0,0 +1,128 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.Arrays;
+import org.junit.jupiter.api.Test;
+
+class TestCompressorBatch {
+
+    private static final String[] MESSAGES = {
+            "alpha-alpha-alpha-alpha",
+            "",
+            "bravo bravo bravo bravo bravo bravo bravo bravo",
+            "c",
+            "delta delta delta delta delta delta delta delta delta delta delta delta",
+    };
+
+    private static byte[] pack(int[] offsets, int[] lengths) {
+        int total = 0;
+        for (int i = 0; i < MESSAGES.length; ++i) {
+            lengths[i] = MESSAGES[i].getBytes(StandardCharsets.UTF_8).length;
+            offsets[i] = total;
+            total += lengths[i];
+        }
+        byte[] packed = new byte[total];
+        for (int i = 0; i < MESSAGES.length; ++i) {
+            byte[] bytes = MESSAGES[i].getBytes(StandardCharsets.UTF_8);
+            System.arraycopy(bytes, 0, packed, offsets[i], bytes.length);
+        }
+        return packed;
+    }
+
+    @Test
+    void batchRoundTripMatchesSingleCalls() {
+        int[] offsets = new int[MESSAGES.length];
+        int[] lengths = new int[MESSAGES.length];
+        byte[] packed = pack(offsets, lengths);
+
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            int dstOffset = 3;
+            byte[] compressed = new byte[dstOffset + (int) OpenZLCompressor.maxCompressedBatchSize(lengths)];
+            int[] frameOffsets = new int[MESSAGES.length + 1];
+            int written = compressor.compressBatch(packed, offsets, lengths, compressed, dstOffset, frameOffsets);
+            assertEquals(dstOffset, frameOffsets[0]);
+            assertEquals(dstOffset + written, frameOffsets[MESSAGES.length]);
+
+            int[] frameStarts = Arrays.copyOf(frameOffsets, MESSAGES.length);
+            int[] frameLengths = new int[MESSAGES.length];
+            for (int i = 0; i < MESSAGES.length; ++i) {
+                frameLengths[i] = frameOffsets[i + 1] - frameOffsets[i];
+                byte[] frame = Arrays.copyOfRange(compressed, frameOffsets[i], frameOffsets[i + 1]);
+                byte[] single = compressor.decompress(frame);
+                assertArrayEquals(MESSAGES[i].getBytes(StandardCharsets.UTF_8), single);
+            }
+
+            byte[] restored = new byte[packed.length];
+            int[] restoredOffsets = new int[MESSAGES.length + 1];
+            int restoredBytes = compressor.decompressBatch(compressed, frameStarts, frameLengths,
+                    restored, 0, restoredOffsets);
+            assertEquals(packed.length, restoredBytes);
+            assertArrayEquals(packed, restored);
+            assertArrayEquals(offsets, Arrays.copyOf(restoredOffsets, MESSAGES.length));
+        }
+    }
+
+    @Test
+    void directBatchRoundTrip() {
+        int[] offsets = new int[MESSAGES.length];
+        int[] lengths = new int[MESSAGES.length];
+        byte[] packed = pack(offsets, lengths);
+
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            ByteBuffer src = ByteBuffer.allocateDirect(packed.length + 2);
+            src.position(2);
+            src.put(packed).flip().position(2);
+            ByteBuffer compressed = ByteBuffer.allocateDirect((int) OpenZLCompressor.maxCompressedBatchSize(lengths));
+            int[] frameOffsets = new int[MESSAGES.length + 1];
+            int written = compressor.compressBatch(src, offsets, lengths, compressed, frameOffsets);
+            assertEquals(written, compressed.position());
+            assertEquals(written, frameOffsets[MESSAGES.length]);
+            assertEquals(src.limit(), src.position());
+
+            compressed.flip();
+            int[] frameLengths = new int[MESSAGES.length];
+            for (int i = 0; i < MESSAGES.length; ++i) {
+                frameLengths[i] = frameOffsets[i + 1] - frameOffsets[i];
+            }
+            ByteBuffer restored = ByteBuffer.allocateDirect(packed.length);
+            int[] restoredOffsets = new int[MESSAGES.length + 1];
+            int restoredBytes = compressor.decompressBatch(compressed, Arrays.copyOf(frameOffsets, MESSAGES.length),
+                    frameLengths, restored, restoredOffsets);
+            assertEquals(packed.length, restoredBytes);
+
+            restored.flip();
+            byte[] copy = new byte[restored.remaining()];
+            restored.get(copy);
+            assertArrayEquals(packed, copy);
+        }
+    }
+
+    @Test
+    void batchRejectsInconsistentTables() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            byte[] src = new byte[16];
+            byte[] dst = new byte[1024];
+            assertThrows(IllegalArgumentException.class, () ->
+                    compressor.compressBatch(src, new int[] {0, 4}, new int[] {4}, dst, 0, new int[3]));
+            assertThrows(IllegalArgumentException.class, () ->
+                    compressor.compressBatch(src, new int[] {0}, new int[] {4}, dst, 0, new int[1]));
+            assertThrows(IndexOutOfBoundsException.class, () ->
+                    compressor.compressBatch(src, new int[] {12}, new int[] {8}, dst, 0, new int[2]));
+        }
+    }
+
+    @Test
+    void batchFailsWhenDestinationTooSmall() {
+        int[] offsets = new int[MESSAGES.length];
+        int[] lengths = new int[MESSAGES.length];
+        byte[] packed = pack(offsets, lengths);
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            byte[] dst = new byte[4];
+            assertThrows(IllegalStateException.class, () ->
+                    compressor.compressBatch(packed, offsets, lengths, dst, 0, new int[MESSAGES.length + 1]));
+        }
+    }
+}
@@ -0,0 +1,105 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+import static org.junit.jupiter.api.Assumptions.assumeTrue;
+
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Random;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+class TestCompressorFiles {
+
+    private static final int CHUNK = 64 * 1024;
+
+    @TempDir
+    Path dir;
+
+    private static byte[] sample(int size) {
+        byte[] data = new byte[size];
+        Random random = new Random(11);
+        for (int i = 0; i < size; ++i) {
+            data[i] = (byte) ((i >> 4) + random.nextInt(2));
+        }
+        return data;
+    }
+
+    @Test
+    void singleFrameFileRoundTrip() throws IOException {
+        byte[] input = sample(200_000);
+        Path in = Files.write(dir.resolve("in.bin"), input);
+        Path packed = dir.resolve("in.ozl");
+        Path restored = dir.resolve("restored.bin");
+
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            long written = compressor.compressFile(in, packed);
+            assertEquals(Files.size(packed), written);
+            byte[] frame = Files.readAllBytes(packed);
+            assertArrayEquals(input, compressor.decompress(frame));
+
+            assertEquals(input.length, compressor.decompressFile(packed, restored));
+            assertArrayEquals(input, Files.readAllBytes(restored));
+        }
+    }
+
+    @Test
+    void chunkedFileRoundTrip() throws IOException {
+        byte[] input = sample(6 * CHUNK + 321);
+        Path in = Files.write(dir.resolve("in.bin"), input);
+        Path packed = dir.resolve("in.ozlp");
+        Path restored = dir.resolve("restored.bin");
+
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            long written = compressor.compressFile(in, packed, 0, CHUNK, 4);
+            byte[] container = Files.readAllBytes(packed);
+            assertEquals(container.length, written);
+            assertArrayEquals(input, compressor.decompressParallel(container));
+
+            assertEquals(input.length, compressor.decompressFile(packed, restored, 3));
+            assertArrayEquals(input, Files.readAllBytes(restored));
+        }
+    }
+
+    @Test
+    void pathsWithSupplementaryCharactersRoundTrip() throws IOException {
+        // Java encodes file names with sun.jnu.encoding; the native side always uses UTF-8.
+        assumeTrue("UTF-8".equalsIgnoreCase(System.getProperty("sun.jnu.encoding")));
+        byte[] input = sample(10_000);
+        Path in = Files.write(dir.resolve("in-\uD83D\uDE00-\u00e9.bin"), input);
+        Path packed = dir.resolve("packed-\uD83D\uDE00.ozl");
+        Path restored = dir.resolve("restored-\uD83D\uDE00.bin");
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            long written = compressor.compressFile(in, packed);
+            assertEquals(Files.size(packed), written);
+            assertEquals(input.length, compressor.decompressFile(packed, restored));
+            assertArrayEquals(input, Files.readAllBytes(restored));
+        }
+    }
+
+    @Test
+    void emptyFileRoundTrip() throws IOException {
+        Path in = Files.write(dir.resolve("empty.bin"), new byte[0]);
+        Path packed = dir.resolve("empty.ozl");
+        Path restored = dir.resolve("empty.out");
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            assertTrue(compressor.compressFile(in, packed) > 0);
+            assertEquals(0, compressor.decompressFile(packed, restored));
+            assertEquals(0, Files.size(restored));
+        }
+    }
+
+    @Test
+    void failuresSurfaceAsIOExceptionAndLeaveNoOutput() throws IOException {
+        Path garbage = Files.write(dir.resolve("garbage.bin"), new byte[] {1, 2, 3, 4, 5, 6, 7, 8});
+        Path out = dir.resolve("out.bin");
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            assertThrows(IOException.class, () -> compressor.compressFile(dir.resolve("missing"), out));
+            assertThrows(IOException.class, () -> compressor.decompressFile(garbage, out));
+            assertFalse(Files.exists(out));
+            assertThrows(IllegalArgumentException.class, () -> compressor.compressFile(garbage, garbage));
+            assertThrows(IllegalArgumentException.class, () -> compressor.compressFile(garbage, out, 0, 1024, 1));
+        }
+    }
+}
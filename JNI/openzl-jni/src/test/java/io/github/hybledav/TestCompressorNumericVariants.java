@@ -107,4 +107,34 @@ class TestCompressorNumericVariants {
             assertEquals(infoDoubles.originalSize(), compressor.getDecompressedSize(compressedDoubles));
         }
     }
+
+    @Test
+    void decodeRejectsFramesOfAnotherWidthOrType() {
+        long[] longs = new long[512];
+        for (int i = 0; i < longs.length; ++i) {
+            longs[i] = i * 31L;
+        }
+        try (OpenZLCompressor compressor = new OpenZLCompressor(OpenZLGraph.NUMERIC)) {
+            byte[] compressedLongs = compressor.compressLongs(longs);
+            assertThrows(IllegalStateException.class, () -> compressor.decompressInts(compressedLongs));
+            assertThrows(IllegalStateException.class, () -> compressor.decompressFloats(compressedLongs));
+            assertArrayEquals(longs, compressor.decompressLongs(compressedLongs));
+
+            byte[] serial = compressor.compress(new byte[4096]);
+            assertThrows(IllegalStateException.class, () -> compressor.decompressDoubles(serial));
+        }
+    }
+
+    @Test
+    void largeArraysDecodeInPlace() {
+        int[] ints = new int[1 << 22];
+        for (int i = 0; i < ints.length; ++i) {
+            ints[i] = i ^ (i >>> 3);
+        }
+        long pinnedBefore = OpenZLCompressor.criticalRegionStats().count();
+        try (OpenZLCompressor compressor = new OpenZLCompressor(OpenZLGraph.NUMERIC)) {
+            assertArrayEquals(ints, compressor.decompressInts(compressor.compressInts(ints)));
+        }
+        assertTrue(OpenZLCompressor.criticalRegionStats().count() >= pinnedBefore + 2);
+    }
 }
@@ -0,0 +1,164 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.Arrays;
+import java.util.Random;
+import org.junit.jupiter.api.Test;
+
+class TestCompressorParallel {
+
+    private static final int CHUNK = 64 * 1024;
+
+    private static byte[] sample(int size) {
+        byte[] data = new byte[size];
+        Random random = new Random(42);
+        for (int i = 0; i < size; ++i) {
+            data[i] = (byte) ((i % 251) ^ (random.nextInt(4)));
+        }
+        return data;
+    }
+
+    private static byte[] unpackChunks(OpenZLCompressor compressor, byte[] container) {
+        ByteBuffer view = ByteBuffer.wrap(container).order(ByteOrder.LITTLE_ENDIAN);
+        assertEquals(0x504C5A4F, view.getInt(0));
+        int chunkCount = view.getInt(12);
+        long contentSize = view.getLong(16);
+        byte[] restored = new byte[(int) contentSize];
+        int frameOffset = 24 + chunkCount * 8;
+        int restoredOffset = 0;
+        for (int i = 0; i < chunkCount; ++i) {
+            int compressedSize = view.getInt(24 + i * 8);
+            int rawSize = view.getInt(24 + i * 8 + 4);
+            byte[] chunk = compressor.decompress(Arrays.copyOfRange(container, frameOffset, frameOffset + compressedSize));
+            assertEquals(rawSize, chunk.length);
+            System.arraycopy(chunk, 0, restored, restoredOffset, chunk.length);
+            frameOffset += compressedSize;
+            restoredOffset += rawSize;
+        }
+        assertEquals(container.length, frameOffset);
+        return restored;
+    }
+
+    @Test
+    void chunksDecompressIndividually() {
+        byte[] input = sample(5 * CHUNK + 123);
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            byte[] container = compressor.compressParallel(input, CHUNK, 4);
+            assertTrue(container.length <= OpenZLCompressor.maxParallelCompressedSize(input.length, CHUNK));
+            assertArrayEquals(input, unpackChunks(compressor, container));
+        }
+    }
+
+    @Test
+    void outputDoesNotDependOnThreadCount() {
+        byte[] input = sample(7 * CHUNK);
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            byte[] single = compressor.compressParallel(input, CHUNK, 1);
+            byte[] multi = compressor.compressParallel(input, CHUNK, 8);
+            byte[] auto = compressor.compressParallel(input, CHUNK, 0);
+            assertArrayEquals(single, multi);
+            assertArrayEquals(single, auto);
+        }
+    }
+
+    @Test
+    void directBufferVariantMatchesArrayOutput() {
+        byte[] input = sample(3 * CHUNK + 7);
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            byte[] expected = compressor.compressParallel(input, CHUNK, 2);
+
+            ByteBuffer src = ByteBuffer.allocateDirect(input.length);
+            src.put(input).flip();
+            ByteBuffer dst = ByteBuffer.allocateDirect((int) OpenZLCompressor.maxParallelCompressedSize(input.length, CHUNK));
+            int written = compressor.compressParallel(src, dst, CHUNK, 3);
+            assertEquals(expected.length, written);
+            assertEquals(written, dst.position());
+            assertFalse(src.hasRemaining());
+
+            byte[] copy = new byte[written];
+            dst.flip();
+            dst.get(copy);
+            assertArrayEquals(expected, copy);
+        }
+    }
+
+    @Test
+    void parallelRoundTripIntoArrays() {
+        byte[] input = sample(9 * CHUNK + 5);
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            byte[] container = compressor.compressParallel(input, CHUNK, 4);
+            assertEquals(input.length, compressor.getParallelDecompressedSize(container));
+            assertArrayEquals(input, compressor.decompressParallel(container));
+            assertArrayEquals(input, compressor.decompressParallel(container, 3, 2L * CHUNK));
+
+            byte[] dst = new byte[input.length + 11];
+            int written = compressor.decompressParallel(container, dst, 11, 2, 1);
+            assertEquals(input.length, written);
+            assertArrayEquals(input, Arrays.copyOfRange(dst, 11, dst.length));
+        }
+    }
+
+    @Test
+    void parallelRoundTripDirect() {
+        byte[] input = sample(4 * CHUNK + 99);
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            ByteBuffer src = ByteBuffer.allocateDirect(input.length);
+            src.put(input).flip();
+            ByteBuffer container = ByteBuffer.allocateDirect((int) OpenZLCompressor.maxParallelCompressedSize(input.length, CHUNK));
+            compressor.compressParallel(src, container, CHUNK, 0);
+            container.flip();
+
+            assertEquals(input.length, compressor.getParallelDecompressedSize(container));
+            ByteBuffer restored = ByteBuffer.allocateDirect(input.length);
+            int written = compressor.decompressParallel(container, restored, 4, CHUNK);
+            assertEquals(input.length, written);
+            assertFalse(container.hasRemaining());
+
+            restored.flip();
+            byte[] copy = new byte[restored.remaining()];
+            restored.get(copy);
+            assertArrayEquals(input, copy);
+        }
+    }
+
+    @Test
+    void decompressRejectsCorruptContainers() {
+        byte[] input = sample(2 * CHUNK);
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            byte[] container = compressor.compressParallel(input, CHUNK, 2);
+            assertThrows(IllegalArgumentException.class, () -> compressor.decompressParallel(compressor.compress(input)));
+            assertThrows(IllegalArgumentException.class,
+                    () -> compressor.decompressParallel(Arrays.copyOf(container, container.length - 1)));
+            assertThrows(IllegalArgumentException.class,
+                    () -> compressor.decompressParallel(container, new byte[16], 0, 2, 0));
+
+            byte[] damaged = container.clone();
+            damaged[40] ^= 0x5A;
+            assertThrows(IllegalStateException.class, () -> compressor.decompressParallel(damaged));
+        }
+    }
+
+    @Test
+    void emptyInputProducesHeaderOnly() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            byte[] container = compressor.compressParallel(new byte[0], CHUNK, 4);
+            assertEquals(24, container.length);
+            assertEquals(0, unpackChunks(compressor, container).length);
+        }
+    }
+
+    @Test
+    void rejectsInvalidArguments() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            byte[] input = sample(1024);
+            assertThrows(IllegalArgumentException.class, () -> compressor.compressParallel(input, 1024, 2));
+            assertThrows(IllegalArgumentException.class, () -> compressor.compressParallel(input, CHUNK, -1));
+            ByteBuffer src = ByteBuffer.allocateDirect(input.length);
+            ByteBuffer small = ByteBuffer.allocateDirect(16);
+            assertThrows(IllegalArgumentException.class, () -> compressor.compressParallel(src, small, CHUNK, 2));
+        }
+    }
+}
@@ -0,0 +1,173 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.EOFException;
+import java.io.IOException;
+import java.util.Arrays;
+import java.util.Random;
+import org.junit.jupiter.api.Test;
+
+class TestCompressorStreams {
+
+    private static byte[] sample(int size) {
+        byte[] data = new byte[size];
+        Random random = new Random(7);
+        for (int i = 0; i < size; ++i) {
+            data[i] = (byte) ('a' + (i / 13 + random.nextInt(3)) % 26);
+        }
+        return data;
+    }
+
+    private static byte[] readAll(OpenZLInputStream in) throws IOException {
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        byte[] buf = new byte[777];
+        int n;
+        while ((n = in.read(buf, 0, buf.length)) >= 0) {
+            out.write(buf, 0, n);
+        }
+        return out.toByteArray();
+    }
+
+    @Test
+    void roundTripAcrossManyChunks() throws IOException {
+        byte[] input = sample(300_000);
+        ByteArrayOutputStream sink = new ByteArrayOutputStream();
+        try (OpenZLCompressor compressor = new OpenZLCompressor();
+             OpenZLOutputStream out = new OpenZLOutputStream(sink, compressor, 32 * 1024)) {
+            int offset = 0;
+            int step = 1;
+            while (offset < input.length) {
+                int len = Math.min(step, input.length - offset);
+                out.write(input, offset, len);
+                offset += len;
+                step = step * 3 % 50_000 + 1;
+            }
+        }
+        assertTrue(sink.size() < input.length);
+
+        try (OpenZLInputStream in = new OpenZLInputStream(new ByteArrayInputStream(sink.toByteArray()))) {
+            assertArrayEquals(input, readAll(in));
+            assertEquals(-1, in.read());
+        }
+    }
+
+    @Test
+    void singleByteWritesAndReads() throws IOException {
+        byte[] input = sample(5_000);
+        ByteArrayOutputStream sink = new ByteArrayOutputStream();
+        try (OpenZLOutputStream out = new OpenZLOutputStream(sink)) {
+            for (byte b : input) {
+                out.write(b);
+            }
+        }
+        try (OpenZLInputStream in = new OpenZLInputStream(new ByteArrayInputStream(sink.toByteArray()))) {
+            byte[] restored = new byte[input.length];
+            for (int i = 0; i < restored.length; ++i) {
+                int b = in.read();
+                assertNotEquals(-1, b);
+                restored[i] = (byte) b;
+            }
+            assertEquals(-1, in.read());
+            assertArrayEquals(input, restored);
+        }
+    }
+
+    @Test
+    void flushEmitsReadableFrame() throws IOException {
+        byte[] input = sample(1_000);
+        ByteArrayOutputStream sink = new ByteArrayOutputStream();
+        OpenZLOutputStream out = new OpenZLOutputStream(sink);
+        out.write(input);
+        assertEquals(0, sink.size());
+        out.flush();
+        assertTrue(sink.size() > 4);
+
+        try (OpenZLInputStream in = new OpenZLInputStream(new ByteArrayInputStream(sink.toByteArray()))) {
+            assertArrayEquals(input, readAll(in));
+        }
+        out.close();
+        assertThrows(IOException.class, () -> out.write(1));
+    }
+
+    @Test
+    void emptyStreamRoundTrips() throws IOException {
+        ByteArrayOutputStream sink = new ByteArrayOutputStream();
+        new OpenZLOutputStream(sink).close();
+        assertEquals(0, sink.size());
+        try (OpenZLInputStream in = new OpenZLInputStream(new ByteArrayInputStream(new byte[0]))) {
+            assertEquals(-1, in.read());
+        }
+    }
+
+    @Test
+    void truncatedStreamFails() throws IOException {
+        ByteArrayOutputStream sink = new ByteArrayOutputStream();
+        try (OpenZLOutputStream out = new OpenZLOutputStream(sink)) {
+            out.write(sample(10_000));
+        }
+        byte[] truncated = Arrays.copyOf(sink.toByteArray(), sink.size() - 3);
+        try (OpenZLInputStream in = new OpenZLInputStream(new ByteArrayInputStream(truncated))) {
+            assertThrows(EOFException.class, () -> readAll(in));
+        }
+    }
+
+    private static byte[] header(int chunkSize) {
+        return new byte[] { 'O', 'Z', 'L', 'S', 1,
+                (byte) chunkSize, (byte) (chunkSize >>> 8), (byte) (chunkSize >>> 16), (byte) (chunkSize >>> 24) };
+    }
+
+    @Test
+    void oversizedFrameLengthIsRejected() throws IOException {
+        byte[] hostile = Arrays.copyOf(header(1024), 16);
+        System.arraycopy(new byte[] { (byte) 0xFF, (byte) 0xFF, (byte) 0xFF, 0x7F, 1, 2, 3 }, 0, hostile, 9, 7);
+        try (OpenZLInputStream in = new OpenZLInputStream(new ByteArrayInputStream(hostile))) {
+            IOException ex = assertThrows(IOException.class, () -> in.read());
+            assertFalse(ex instanceof EOFException);
+        }
+    }
+
+    @Test
+    void framesLargerThanReaderChunkSizeAreRejected() throws IOException {
+        ByteArrayOutputStream sink = new ByteArrayOutputStream();
+        try (OpenZLCompressor compressor = new OpenZLCompressor();
+             OpenZLOutputStream out = new OpenZLOutputStream(sink, compressor, 64 * 1024)) {
+            out.write(sample(64 * 1024));
+        }
+        try (OpenZLCompressor compressor = new OpenZLCompressor();
+             OpenZLInputStream in = new OpenZLInputStream(new ByteArrayInputStream(sink.toByteArray()), compressor, 1024)) {
+            assertThrows(IOException.class, () -> readAll(in));
+        }
+    }
+
+    @Test
+    void defaultReaderFollowsWriterChunkSize() throws IOException {
+        byte[] input = sample(12 << 20);
+        ByteArrayOutputStream sink = new ByteArrayOutputStream();
+        try (OpenZLCompressor compressor = new OpenZLCompressor();
+             OpenZLOutputStream out = new OpenZLOutputStream(sink, compressor, 8 << 20)) {
+            out.write(input);
+        }
+        try (OpenZLInputStream in = new OpenZLInputStream(new ByteArrayInputStream(sink.toByteArray()))) {
+            assertArrayEquals(input, readAll(in));
+        }
+    }
+
+    @Test
+    void invalidHeadersAreRejected() throws IOException {
+        byte[] badMagic = header(1024);
+        badMagic[0] = 'X';
+        byte[] tooLarge = header(OpenZLOutputStream.MAX_CHUNK_SIZE + 1);
+        for (byte[] hostile : new byte[][] { badMagic, tooLarge, Arrays.copyOf(header(1024), 5) }) {
+            try (OpenZLInputStream in = new OpenZLInputStream(new ByteArrayInputStream(hostile))) {
+                assertThrows(IOException.class, () -> in.read());
+            }
+        }
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            assertThrows(IllegalArgumentException.class, () -> new OpenZLOutputStream(new ByteArrayOutputStream(),
+                    compressor, OpenZLOutputStream.MAX_CHUNK_SIZE + 1));
+        }
+    }
+}
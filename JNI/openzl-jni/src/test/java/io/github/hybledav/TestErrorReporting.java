@@ -0,0 +1,111 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.Map;
+import org.junit.jupiter.api.Test;
+
+class TestErrorReporting {
+
+    private static ByteBuffer direct(byte[] bytes) {
+        ByteBuffer buffer = ByteBuffer.allocateDirect(bytes.length);
+        buffer.put(bytes).flip();
+        return buffer;
+    }
+
+    private static byte[] garbage() {
+        byte[] bytes = new byte[64];
+        for (int i = 0; i < bytes.length; ++i) {
+            bytes[i] = (byte) (i * 37 + 11);
+        }
+        return bytes;
+    }
+
+    @Test
+    void malformedFrameRaisesTypedException() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            OpenZLException ex = assertThrows(OpenZLException.class,
+                    () -> compressor.decompress(direct(garbage()), ByteBuffer.allocateDirect(1024)));
+            assertNotEquals(0, ex.errorCode());
+            assertEquals(ex.errorCode(), compressor.lastErrorCode());
+            assertTrue(compressor.lastErrorMessage().startsWith("decompressDirect failed"));
+            assertTrue(ex.getMessage().startsWith("Decompression failed"));
+        }
+    }
+
+    @Test
+    void checkedByteArrayDecompressRaisesTypedException() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            assertNull(compressor.decompress(garbage()));
+            OpenZLException ex = assertThrows(OpenZLException.class, () -> compressor.decompressChecked(garbage()));
+            assertNotEquals(0, ex.errorCode());
+            assertTrue(compressor.lastErrorMessage().startsWith("decompress failed"));
+        }
+    }
+
+    @Test
+    void checkedByteArrayCallsRejectAClosedCompressor() {
+        OpenZLCompressor compressor = new OpenZLCompressor();
+        compressor.close();
+        assertThrows(IllegalStateException.class, () -> compressor.compressChecked(new byte[] {1, 2, 3}));
+        assertThrows(IllegalStateException.class, () -> compressor.decompressChecked(new byte[] {1, 2, 3}));
+    }
+
+    @Test
+    void successfulCallClearsLastError() {
+        byte[] input = "error reporting payload ".repeat(20).getBytes(StandardCharsets.UTF_8);
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            assertThrows(OpenZLException.class,
+                    () -> compressor.decompress(direct(garbage()), ByteBuffer.allocateDirect(1024)));
+            assertNotEquals(0, compressor.lastErrorCode());
+
+            ByteBuffer dst = ByteBuffer.allocateDirect((int) compressor.maxCompressedSize(input.length));
+            compressor.compress(direct(input), dst);
+            assertEquals(0, compressor.lastErrorCode());
+            assertNull(compressor.lastErrorMessage());
+        }
+    }
+
+    @Test
+    void undersizedDestinationIsReported() {
+        byte[] input = "destination too small ".repeat(200).getBytes(StandardCharsets.UTF_8);
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            ByteBuffer compressed = ByteBuffer.allocateDirect((int) compressor.maxCompressedSize(input.length));
+            compressor.compress(direct(input), compressed);
+            compressed.flip();
+            OpenZLException ex = assertThrows(OpenZLException.class,
+                    () -> compressor.decompress(compressed, ByteBuffer.allocateDirect(16)));
+            assertNotEquals(0, ex.errorCode());
+        }
+    }
+
+    @Test
+    void failuresAreCountedPerCode() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            OpenZLException first = assertThrows(OpenZLException.class,
+                    () -> compressor.decompress(direct(garbage()), ByteBuffer.allocateDirect(1024)));
+            long before = OpenZLCompressor.errorCounts().getOrDefault(Math.min(first.errorCode(), 127), 0L);
+            for (int i = 0; i < 5; ++i) {
+                assertThrows(OpenZLException.class,
+                        () -> compressor.decompress(direct(garbage()), ByteBuffer.allocateDirect(1024)));
+            }
+            Map<Integer, Long> after = OpenZLCompressor.errorCounts();
+            assertTrue(after.get(Math.min(first.errorCode(), 127)) >= before + 5);
+        }
+    }
+
+    @Test
+    void loggingCanBeToggled() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            OpenZLCompressor.setErrorLogging(true);
+            for (int i = 0; i < 50; ++i) {
+                assertThrows(OpenZLException.class,
+                        () -> compressor.decompress(direct(garbage()), ByteBuffer.allocateDirect(1024)));
+            }
+        } finally {
+            OpenZLCompressor.setErrorLogging(false);
+        }
+    }
+}
@@ -0,0 +1,94 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.io.ByteArrayOutputStream;
+import java.nio.charset.StandardCharsets;
+import java.util.List;
+import java.util.OptionalInt;
+import java.util.OptionalLong;
+import org.junit.jupiter.api.Test;
+
+class TestFrameOutputs {
+
+    private static final int ROWS = 1_500;
+
+    private final int[] ids = new int[ROWS];
+    private final double[] scores = new double[ROWS];
+    private final int[] tagLengths = new int[ROWS];
+    private final byte[] tags;
+    private final byte[] records = new byte[ROWS * 12];
+
+    TestFrameOutputs() {
+        ByteArrayOutputStream packed = new ByteArrayOutputStream();
+        for (int i = 0; i < ROWS; ++i) {
+            ids[i] = 1_000 + i;
+            scores[i] = (i % 50) / 4.0;
+            byte[] tag = ("tag-" + (i % 9)).getBytes(StandardCharsets.UTF_8);
+            packed.writeBytes(tag);
+            tagLengths[i] = tag.length;
+            records[i * 12 + 3] = (byte) (i % 7);
+        }
+        tags = packed.toByteArray();
+    }
+
+    private byte[] frame(OpenZLCompressor compressor) {
+        return compressor.compressMulti(new OpenZLMultiInput()
+                .addInts(ids)
+                .addDoubles(scores)
+                .addStrings(tags, tagLengths)
+                .addStructs(records, 12));
+    }
+
+    @Test
+    void inspectListsEveryOutput() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor(OpenZLGraph.GENERIC)) {
+            OpenZLCompressionInfo info = compressor.inspect(frame(compressor));
+            List<OpenZLOutputInfo> outputs = info.outputs();
+            assertEquals(4, info.outputCount());
+
+            assertEquals(OpenZLCompressionInfo.DataFlavor.NUMERIC, outputs.get(0).flavor());
+            assertEquals(OptionalInt.of(4), outputs.get(0).elementWidth());
+            assertEquals(OptionalLong.of(ROWS), outputs.get(0).elementCount());
+            assertEquals(OptionalInt.of(8), outputs.get(1).elementWidth());
+            assertEquals(OpenZLCompressionInfo.DataFlavor.STRING, outputs.get(2).flavor());
+            assertEquals(tags.length, outputs.get(2).size());
+            assertEquals(OptionalInt.empty(), outputs.get(2).elementWidth());
+            assertEquals(OpenZLCompressionInfo.DataFlavor.STRUCT, outputs.get(3).flavor());
+            assertEquals(OptionalInt.of(12), outputs.get(3).elementWidth());
+
+            long total = ROWS * 4L + ROWS * 8L + tags.length + records.length;
+            assertEquals(total, info.totalSize());
+            assertEquals(ROWS * 4L, info.originalSize());
+            assertEquals(info.flavor(), outputs.get(0).flavor());
+        }
+    }
+
+    @Test
+    void singleOutputFrameListsOneOutput() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            OpenZLCompressionInfo info = compressor.inspect(compressor.compressInts(ids));
+            assertEquals(1, info.outputCount());
+            assertEquals(info.originalSize(), info.outputs().get(0).size());
+            assertEquals(info.originalSize(), info.totalSize());
+        }
+    }
+
+    @Test
+    void decompressMultiFollowsInspectedOutputs() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor(OpenZLGraph.GENERIC)) {
+            byte[] compressed = frame(compressor);
+            OpenZLMultiOutput columns = compressor.decompressMulti(compressed);
+            List<OpenZLOutputInfo> outputs = compressor.inspect(compressed).outputs();
+            assertEquals(outputs.size(), columns.size());
+            for (int i = 0; i < outputs.size(); ++i) {
+                assertEquals(outputs.get(i).flavor(), columns.flavor(i));
+            }
+            assertArrayEquals(ids, columns.ints(0));
+            assertArrayEquals(scores, columns.doubles(1));
+            assertArrayEquals(tags, columns.strings(2).content());
+            assertArrayEquals(tagLengths, columns.strings(2).lengths());
+            assertArrayEquals(records, columns.bytes(3));
+        }
+    }
+}
@@ -0,0 +1,124 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.io.ByteArrayOutputStream;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.StandardCharsets;
+import org.junit.jupiter.api.Test;
+
+class TestMultiInput {
+
+    private static final int ROWS = 2_000;
+
+    @Test
+    void mixedColumnsRoundTrip() {
+        int[] ids = new int[ROWS];
+        long[] timestamps = new long[ROWS];
+        double[] prices = new double[ROWS];
+        ByteArrayOutputStream names = new ByteArrayOutputStream();
+        int[] nameLengths = new int[ROWS];
+        byte[] records = new byte[ROWS * 6];
+        for (int i = 0; i < ROWS; ++i) {
+            ids[i] = i * 3;
+            timestamps[i] = 1_700_000_000_000L + i * 250L;
+            prices[i] = 10.0 + (i % 17) * 0.25;
+            byte[] name = ("user-" + (i % 40)).getBytes(StandardCharsets.UTF_8);
+            names.writeBytes(name);
+            nameLengths[i] = name.length;
+            records[i * 6] = (byte) i;
+            records[i * 6 + 5] = (byte) (i % 3);
+        }
+        byte[] header = "columnar batch v1".getBytes(StandardCharsets.UTF_8);
+
+        OpenZLMultiInput batch = new OpenZLMultiInput()
+                .addInts(ids)
+                .addLongs(timestamps)
+                .addDoubles(prices)
+                .addStrings(names.toByteArray(), nameLengths)
+                .addStructs(records, 6)
+                .addSerial(header);
+        assertEquals(6, batch.size());
+
+        try (OpenZLCompressor compressor = new OpenZLCompressor(OpenZLGraph.GENERIC)) {
+            byte[] compressed = compressor.compressMulti(batch);
+            OpenZLMultiOutput columns = compressor.decompressMulti(compressed);
+
+            assertEquals(6, columns.size());
+            assertEquals(OpenZLCompressionInfo.DataFlavor.NUMERIC, columns.flavor(0));
+            assertArrayEquals(ids, columns.ints(0));
+            assertArrayEquals(timestamps, columns.longs(1));
+            assertArrayEquals(prices, columns.doubles(2));
+            assertEquals(OpenZLCompressionInfo.DataFlavor.STRING, columns.flavor(3));
+            assertArrayEquals(names.toByteArray(), columns.strings(3).content());
+            assertArrayEquals(nameLengths, columns.strings(3).lengths());
+            assertEquals(OpenZLCompressionInfo.DataFlavor.STRUCT, columns.flavor(4));
+            assertEquals(6, columns.elementWidth(4));
+            assertArrayEquals(records, columns.bytes(4));
+            assertArrayEquals(header, columns.bytes(5));
+        }
+    }
+
+    @Test
+    void directBuffersAreReadInPlace() {
+        ByteBuffer values = ByteBuffer.allocateDirect(8 + ROWS * Float.BYTES).order(ByteOrder.nativeOrder());
+        values.position(8);
+        for (int i = 0; i < ROWS; ++i) {
+            values.putFloat(i * 0.5f);
+        }
+        values.position(8);
+        ByteBuffer records = ByteBuffer.allocateDirect(ROWS * 4);
+        for (int i = 0; i < ROWS; ++i) {
+            records.putInt(i % 100);
+        }
+        records.flip();
+
+        try (OpenZLCompressor compressor = new OpenZLCompressor(OpenZLGraph.GENERIC)) {
+            byte[] compressed = compressor.compressMulti(new OpenZLMultiInput()
+                    .addNumeric(values, Float.BYTES)
+                    .addStructs(records, 4));
+            assertEquals(8, values.position());
+            assertEquals(0, records.position());
+
+            OpenZLMultiOutput columns = compressor.decompressMulti(compressed);
+            float[] floats = columns.floats(0);
+            assertEquals(ROWS, floats.length);
+            for (int i = 0; i < ROWS; ++i) {
+                assertEquals(i * 0.5f, floats[i]);
+            }
+            byte[] expected = new byte[ROWS * 4];
+            records.duplicate().get(expected);
+            assertArrayEquals(expected, columns.bytes(1));
+        }
+    }
+
+    @Test
+    void singleInputFrameDecodesToOneColumn() {
+        int[] data = new int[ROWS];
+        for (int i = 0; i < ROWS; ++i) {
+            data[i] = i % 11;
+        }
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            OpenZLMultiOutput columns = compressor.decompressMulti(compressor.compressInts(data));
+            assertEquals(1, columns.size());
+            assertArrayEquals(data, columns.ints(0));
+            assertThrows(IllegalStateException.class, () -> columns.longs(0));
+            assertThrows(IllegalStateException.class, () -> columns.strings(0));
+        }
+    }
+
+    @Test
+    void invalidColumnsAreRejected() {
+        OpenZLMultiInput batch = new OpenZLMultiInput();
+        assertThrows(IllegalArgumentException.class, () -> batch.addStructs(new byte[10], 4));
+        assertThrows(IllegalArgumentException.class, () -> batch.addStrings(new byte[4], new int[] {1, 2}));
+        assertThrows(IllegalArgumentException.class, () -> batch.addSerial(ByteBuffer.allocate(4)));
+        assertThrows(IllegalArgumentException.class, () -> batch.addNumeric(ByteBuffer.allocateDirect(12), 3));
+        assertThrows(NullPointerException.class, () -> batch.addInts(null));
+        try (OpenZLCompressor compressor = new OpenZLCompressor(OpenZLGraph.GENERIC)) {
+            assertThrows(IllegalArgumentException.class, () -> compressor.compressMulti(batch));
+            assertThrows(OpenZLException.class, () -> compressor.decompressMulti(new byte[] {1, 2, 3, 4}));
+        }
+    }
+}
@@ -0,0 +1,79 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import org.junit.jupiter.api.Test;
+
+class TestNativeBuffer {
+
+    private static byte[] payload(int repeats) {
+        return "native-buffer payload ".repeat(repeats).getBytes(StandardCharsets.UTF_8);
+    }
+
+    private static byte[] bytesOf(ByteBuffer buffer) {
+        byte[] copy = new byte[buffer.remaining()];
+        buffer.get(copy);
+        return copy;
+    }
+
+    @Test
+    void compressToNativeMatchesHeapResult() {
+        byte[] input = payload(500);
+        try (OpenZLCompressor compressor = new OpenZLCompressor();
+             OpenZLNativeBuffer compressed = compressor.compressToNative(input)) {
+            ByteBuffer view = compressed.buffer();
+            assertTrue(view.isDirect());
+            assertEquals(compressed.size(), view.remaining());
+            assertArrayEquals(compressor.compress(input), bytesOf(view));
+        }
+    }
+
+    @Test
+    void decompressToNativeRoundTrip() {
+        byte[] input = payload(2_000);
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            byte[] compressed = compressor.compress(input);
+            byte[] framed = new byte[compressed.length + 5];
+            System.arraycopy(compressed, 0, framed, 5, compressed.length);
+            try (OpenZLNativeBuffer restored = compressor.decompressToNative(framed, 5, compressed.length)) {
+                assertEquals(input.length, restored.size());
+                assertArrayEquals(input, bytesOf(restored.buffer()));
+            }
+        }
+    }
+
+    @Test
+    void releasedBufferRejectsAccess() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            OpenZLNativeBuffer buffer = compressor.compressToNative(payload(10));
+            buffer.close();
+            assertTrue(buffer.isReleased());
+            assertThrows(IllegalStateException.class, buffer::buffer);
+            buffer.close();
+        }
+    }
+
+    @Test
+    void blocksAreReusedAcrossManyCalls() {
+        byte[] input = payload(100);
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            for (int i = 0; i < 1_000; ++i) {
+                try (OpenZLNativeBuffer compressed = compressor.compressToNative(input);
+                     OpenZLNativeBuffer restored = compressor.decompressToNative(bytesOf(compressed.buffer()))) {
+                    assertEquals(input.length, restored.size());
+                }
+            }
+        }
+    }
+
+    @Test
+    void rejectsInvalidRanges() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            byte[] input = payload(1);
+            assertThrows(IndexOutOfBoundsException.class, () -> compressor.compressToNative(input, 4, input.length));
+            assertThrows(IllegalStateException.class, () -> compressor.decompressToNative(new byte[] {1, 2, 3}));
+        }
+    }
+}
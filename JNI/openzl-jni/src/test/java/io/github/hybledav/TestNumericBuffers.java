@@ -0,0 +1,110 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.DoubleBuffer;
+import java.nio.IntBuffer;
+import java.nio.LongBuffer;
+import org.junit.jupiter.api.Test;
+
+class TestNumericBuffers {
+
+    private static final ByteOrder FOREIGN =
+            ByteOrder.nativeOrder() == ByteOrder.BIG_ENDIAN ? ByteOrder.LITTLE_ENDIAN : ByteOrder.BIG_ENDIAN;
+
+    private static long[] sequence(int count) {
+        long[] values = new long[count];
+        for (int i = 0; i < count; ++i) {
+            values[i] = 0x0102030405060708L * i + (i >>> 2);
+        }
+        return values;
+    }
+
+    private static LongBuffer longs(long[] values, ByteOrder order) {
+        LongBuffer buffer = ByteBuffer.allocateDirect(values.length * Long.BYTES).order(order).asLongBuffer();
+        buffer.put(values).flip();
+        return buffer;
+    }
+
+    @Test
+    void byteOrderDoesNotChangeTheFrame() {
+        long[] values = sequence(5003);
+        try (OpenZLCompressor compressor = new OpenZLCompressor(OpenZLGraph.NUMERIC)) {
+            byte[] expected = compressor.compressLongs(values);
+            for (ByteOrder order : new ByteOrder[] {ByteOrder.nativeOrder(), FOREIGN}) {
+                LongBuffer src = longs(values, order);
+                ByteBuffer frame = ByteBuffer.allocateDirect(expected.length + 64);
+                int written = compressor.compressLongs(src, frame);
+                assertFalse(src.hasRemaining());
+                assertEquals(expected.length, written);
+                byte[] actual = new byte[written];
+                frame.flip();
+                frame.get(actual);
+                assertArrayEquals(expected, actual);
+            }
+        }
+    }
+
+    @Test
+    void decodeHonoursDestinationOrder() {
+        long[] values = sequence(777);
+        try (OpenZLCompressor compressor = new OpenZLCompressor(OpenZLGraph.NUMERIC)) {
+            byte[] frame = compressor.compressLongs(values);
+            for (ByteOrder order : new ByteOrder[] {ByteOrder.nativeOrder(), FOREIGN}) {
+                ByteBuffer src = ByteBuffer.allocateDirect(frame.length);
+                src.put(frame).flip();
+                LongBuffer dst = ByteBuffer.allocateDirect((values.length + 3) * Long.BYTES).order(order).asLongBuffer();
+                dst.position(3);
+                assertEquals(values.length, compressor.decompressLongs(src, dst));
+                assertEquals(values.length + 3, dst.position());
+                for (int i = 0; i < values.length; ++i) {
+                    assertEquals(values[i], dst.get(i + 3));
+                }
+            }
+        }
+    }
+
+    @Test
+    void intAndDoubleBuffersRoundTrip() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor(OpenZLGraph.NUMERIC)) {
+            IntBuffer ints = ByteBuffer.allocateDirect(4000 * Integer.BYTES).order(FOREIGN).asIntBuffer();
+            for (int i = 0; i < 4000; ++i) {
+                ints.put(i * 3 - 7);
+            }
+            ints.flip().position(100);
+            ByteBuffer frame = ByteBuffer.allocateDirect(32 * 1024);
+            compressor.compressInts(ints, frame);
+            frame.flip();
+            IntBuffer restored = ByteBuffer.allocateDirect(3900 * Integer.BYTES).order(FOREIGN).asIntBuffer();
+            assertEquals(3900, compressor.decompressInts(frame, restored));
+            for (int i = 0; i < 3900; ++i) {
+                assertEquals((i + 100) * 3 - 7, restored.get(i));
+            }
+
+            DoubleBuffer doubles = ByteBuffer.allocateDirect(513 * Double.BYTES)
+                    .order(ByteOrder.nativeOrder()).asDoubleBuffer();
+            for (int i = 0; i < 513; ++i) {
+                doubles.put(Math.sqrt(i));
+            }
+            doubles.flip();
+            frame.clear();
+            compressor.compressDoubles(doubles, frame);
+            frame.flip();
+            DoubleBuffer decoded = ByteBuffer.allocateDirect(513 * Double.BYTES).order(FOREIGN).asDoubleBuffer();
+            compressor.decompressDoubles(frame, decoded);
+            for (int i = 0; i < 513; ++i) {
+                assertEquals(Math.sqrt(i), decoded.get(i), 0.0d);
+            }
+        }
+    }
+
+    @Test
+    void heapTypedBuffersAreRejected() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor(OpenZLGraph.NUMERIC)) {
+            assertThrows(IllegalArgumentException.class,
+                    () -> compressor.compressLongs(LongBuffer.wrap(new long[8]), ByteBuffer.allocateDirect(256)));
+        }
+    }
+}
@@ -0,0 +1,123 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.Arrays;
+import java.util.Random;
+import org.junit.jupiter.api.Test;
+
+class TestNumericInto {
+
+    @Test
+    void arrayVariantsRoundTripWithOffsets() {
+        Random random = new Random(42);
+        int[] ints = random.ints(4096).toArray();
+        long[] longs = random.longs(2048).toArray();
+        double[] doubles = random.doubles(1024).toArray();
+        float[] floats = new float[1536];
+        for (int i = 0; i < floats.length; ++i) {
+            floats[i] = random.nextFloat();
+        }
+
+        try (OpenZLCompressor compressor = new OpenZLCompressor(OpenZLGraph.NUMERIC)) {
+            byte[] frame = new byte[16 + (int) OpenZLCompressor.maxCompressedSize(ints.length * Integer.BYTES)];
+            int written = compressor.compressInts(ints, 100, 3000, frame, 16);
+            assertArrayEquals(compressor.compressInts(Arrays.copyOfRange(ints, 100, 3100)),
+                    Arrays.copyOfRange(frame, 16, 16 + written));
+            int[] restoredInts = new int[3010];
+            assertEquals(3000, compressor.decompressInts(frame, 16, written, restoredInts, 10));
+            assertArrayEquals(Arrays.copyOfRange(ints, 100, 3100), Arrays.copyOfRange(restoredInts, 10, 3010));
+
+            frame = new byte[(int) OpenZLCompressor.maxCompressedSize(longs.length * Long.BYTES)];
+            written = compressor.compressLongs(longs, 0, longs.length, frame, 0);
+            long[] restoredLongs = new long[longs.length];
+            assertEquals(longs.length, compressor.decompressLongs(frame, 0, written, restoredLongs, 0));
+            assertArrayEquals(longs, restoredLongs);
+
+            frame = new byte[(int) OpenZLCompressor.maxCompressedSize(floats.length * Float.BYTES)];
+            written = compressor.compressFloats(floats, 0, floats.length, frame, 0);
+            float[] restoredFloats = new float[floats.length];
+            assertEquals(floats.length, compressor.decompressFloats(frame, 0, written, restoredFloats, 0));
+            assertArrayEquals(floats, restoredFloats, 0.0f);
+
+            frame = new byte[(int) OpenZLCompressor.maxCompressedSize(doubles.length * Double.BYTES)];
+            written = compressor.compressDoubles(doubles, 0, doubles.length, frame, 0);
+            double[] restoredDoubles = new double[doubles.length];
+            assertEquals(doubles.length, compressor.decompressDoubles(frame, 0, written, restoredDoubles, 0));
+            assertArrayEquals(doubles, restoredDoubles, 0.0d);
+        }
+    }
+
+    @Test
+    void directVariantsUseNativeOrder() {
+        long[] values = new long[1000];
+        for (int i = 0; i < values.length; ++i) {
+            values[i] = i * 1_000_003L;
+        }
+        ByteBuffer src = ByteBuffer.allocateDirect(values.length * Long.BYTES).order(ByteOrder.nativeOrder());
+        src.asLongBuffer().put(values);
+
+        try (OpenZLCompressor compressor = new OpenZLCompressor(OpenZLGraph.NUMERIC)) {
+            ByteBuffer frame = ByteBuffer.allocateDirect((int) OpenZLCompressor.maxCompressedSize(src.remaining()));
+            int written = compressor.compressLongs(src, frame);
+            assertEquals(written, frame.position());
+            assertFalse(src.hasRemaining());
+            frame.flip();
+
+            assertArrayEquals(values, compressor.decompressLongs(toArray(frame)));
+
+            ByteBuffer restored = ByteBuffer.allocateDirect(values.length * Long.BYTES).order(ByteOrder.nativeOrder());
+            assertEquals(values.length, compressor.decompressLongs(frame, restored));
+            restored.flip();
+            long[] decoded = new long[values.length];
+            restored.asLongBuffer().get(decoded);
+            assertArrayEquals(values, decoded);
+        }
+    }
+
+    @Test
+    void undersizedOrMistypedDestinationsFail() {
+        int[] ints = new int[512];
+        Arrays.setAll(ints, i -> i * 7);
+        try (OpenZLCompressor compressor = new OpenZLCompressor(OpenZLGraph.NUMERIC)) {
+            byte[] frame = compressor.compressInts(ints);
+            assertThrows(OpenZLBufferTooSmallException.class,
+                    () -> compressor.decompressInts(frame, 0, frame.length, new int[511], 0));
+            assertThrows(IllegalStateException.class,
+                    () -> compressor.decompressLongs(frame, 0, frame.length, new long[512], 0));
+            assertThrows(IndexOutOfBoundsException.class,
+                    () -> compressor.compressInts(ints, 10, 512, new byte[4096], 0));
+            assertThrows(IllegalArgumentException.class,
+                    () -> compressor.compressInts(ByteBuffer.allocateDirect(6), ByteBuffer.allocateDirect(64)));
+        }
+    }
+
+    @Test
+    void copyingPathRejectsUndersizedDestinationOnce() {
+        int[] ints = new int[4096];
+        Arrays.setAll(ints, i -> i * 7);
+        try (OpenZLCompressor compressor = new OpenZLCompressor(OpenZLGraph.NUMERIC)) {
+            byte[] frame = compressor.compressInts(ints);
+            OpenZLCompressor.setPinningThreshold(0);
+            try {
+                OpenZLBufferTooSmallException ex = assertThrows(OpenZLBufferTooSmallException.class,
+                        () -> compressor.decompressInts(frame, 0, frame.length, new int[16], 0));
+                int slot = Math.min(ex.errorCode(), 127);
+                long before = OpenZLCompressor.errorCounts().getOrDefault(slot, 0L);
+                assertThrows(OpenZLBufferTooSmallException.class,
+                        () -> compressor.decompressInts(frame, 0, frame.length, new int[16], 0));
+                assertEquals(before + 1, OpenZLCompressor.errorCounts().get(slot));
+            } finally {
+                OpenZLCompressor.setPinningThreshold(1L << 20);
+            }
+        }
+    }
+
+    private static byte[] toArray(ByteBuffer buffer) {
+        byte[] bytes = new byte[buffer.remaining()];
+        buffer.duplicate().get(bytes);
+        return bytes;
+    }
+}
@@ -0,0 +1,173 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.nio.charset.StandardCharsets;
+import java.util.Arrays;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.Test;
+
+class TestPinningPolicy {
+
+    private static final long DEFAULT_THRESHOLD = 1L << 20;
+
+    @AfterEach
+    void restoreThreshold() {
+        OpenZLCompressor.setPinningThreshold(DEFAULT_THRESHOLD);
+    }
+
+    private static byte[] payload() {
+        return "pinning policy payload 0123456789 ".repeat(400).getBytes(StandardCharsets.UTF_8);
+    }
+
+    @Test
+    void copyingAndPinningProduceSameFrames() {
+        byte[] input = payload();
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            OpenZLCompressor.setPinningThreshold(Long.MAX_VALUE);
+            byte[] pinned = compressor.compress(input);
+            OpenZLCompressor.setPinningThreshold(0);
+            byte[] copied = compressor.compress(input);
+            assertArrayEquals(pinned, copied);
+            assertArrayEquals(input, compressor.decompress(copied));
+        }
+    }
+
+    @Test
+    void copyingPathHandlesOffsetsAndUndersizedDestinations() {
+        byte[] input = payload();
+        OpenZLCompressor.setPinningThreshold(0);
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            byte[] compressed = new byte[8 + (int) OpenZLCompressor.maxCompressedSize(input.length)];
+            int written = compressor.compress(input, 0, input.length, compressed, 8, compressed.length - 8);
+            assertTrue(written > 0);
+
+            byte[] restored = new byte[input.length + 5];
+            int read = compressor.decompress(compressed, 8, written, restored, 5, input.length);
+            assertEquals(input.length, read);
+            for (int i = 0; i < input.length; ++i) {
+                assertEquals(input[i], restored[i + 5]);
+            }
+
+            assertThrows(OpenZLException.class,
+                    () -> compressor.decompress(compressed, 8, written, new byte[16], 0, 16));
+        }
+    }
+
+    @Test
+    void pinnedCallsAreTimed() {
+        byte[] input = payload();
+        OpenZLCompressor.setPinningThreshold(Long.MAX_VALUE);
+        long before = OpenZLCompressor.criticalRegionStats().count();
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            compressor.decompress(compressor.compress(input));
+        }
+        OpenZLCriticalRegionStats stats = OpenZLCompressor.criticalRegionStats();
+        assertTrue(stats.count() >= before + 2);
+        assertTrue(stats.maxNanos() <= stats.totalNanos());
+    }
+
+    @Test
+    void batchAndParallelCallsFollowThreshold() {
+        byte[] input = payload();
+        int half = input.length / 2;
+        int[] offsets = { 0, half };
+        int[] lengths = { half, input.length - half };
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            byte[] batch = new byte[2 * (int) OpenZLCompressor.maxCompressedSize(input.length)];
+            int[] frames = new int[3];
+            OpenZLCompressor.setPinningThreshold(Long.MAX_VALUE);
+            int pinnedSize = compressor.compressBatch(input, offsets, lengths, batch, 0, frames);
+            byte[] pinnedBatch = Arrays.copyOf(batch, pinnedSize);
+            byte[] pinnedParallel = compressor.compressParallel(input);
+
+            OpenZLCompressor.setPinningThreshold(0);
+            long before = OpenZLCompressor.criticalRegionStats().count();
+            int copiedSize = compressor.compressBatch(input, offsets, lengths, batch, 0, frames);
+            assertArrayEquals(pinnedBatch, Arrays.copyOf(batch, copiedSize));
+            assertArrayEquals(pinnedParallel, compressor.compressParallel(input));
+            assertArrayEquals(input, compressor.decompressParallel(pinnedParallel));
+            try (OpenZLNativeBuffer compressed = compressor.compressToNative(input)) {
+                assertTrue(compressed.size() > 0);
+            }
+            assertEquals(before, OpenZLCompressor.criticalRegionStats().count());
+        }
+    }
+
+    @Test
+    void pinnedParallelAndNativeBufferCallsAreTimed() {
+        byte[] input = payload();
+        OpenZLCompressor.setPinningThreshold(Long.MAX_VALUE);
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            long before = OpenZLCompressor.criticalRegionStats().count();
+            byte[] container = compressor.compressParallel(input);
+            assertArrayEquals(input, compressor.decompressParallel(container));
+            try (OpenZLNativeBuffer compressed = compressor.compressToNative(input)) {
+                assertTrue(compressed.size() > 0);
+            }
+            assertTrue(OpenZLCompressor.criticalRegionStats().count() >= before + 3);
+        }
+    }
+
+    @Test
+    void numericArraysCopyAboveThreshold() {
+        int[] ints = new int[4096];
+        double[] doubles = new double[4096];
+        for (int i = 0; i < ints.length; ++i) {
+            ints[i] = i * 31 % 977;
+            doubles[i] = i * 0.25;
+        }
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            OpenZLCompressor.setPinningThreshold(Long.MAX_VALUE);
+            byte[] pinnedInts = compressor.compressInts(ints);
+            byte[] pinnedDoubles = compressor.compressDoubles(doubles);
+
+            OpenZLCompressor.setPinningThreshold(0);
+            long before = OpenZLCompressor.criticalRegionStats().count();
+            assertArrayEquals(pinnedInts, compressor.compressInts(ints));
+            assertArrayEquals(pinnedDoubles, compressor.compressDoubles(doubles));
+            assertArrayEquals(ints, compressor.decompressInts(pinnedInts));
+            assertArrayEquals(doubles, compressor.decompressDoubles(pinnedDoubles));
+
+            byte[] frame = new byte[(int) OpenZLCompressor.maxCompressedSize(ints.length * 4) + 3];
+            int written = compressor.compressInts(ints, 0, ints.length, frame, 3);
+            double[] restored = new double[doubles.length + 2];
+            int[] restoredInts = new int[ints.length + 2];
+            assertEquals(ints.length, compressor.decompressInts(frame, 3, written, restoredInts, 2));
+            assertArrayEquals(ints, Arrays.copyOfRange(restoredInts, 2, restoredInts.length));
+            assertEquals(doubles.length,
+                    compressor.decompressDoubles(pinnedDoubles, 0, pinnedDoubles.length, restored, 2));
+            assertArrayEquals(doubles, Arrays.copyOfRange(restored, 2, restored.length));
+            assertEquals(before, OpenZLCompressor.criticalRegionStats().count());
+        }
+    }
+
+    @Test
+    void packedStringsCopyAboveThreshold() {
+        byte[] packed = payload();
+        int[] lengths = new int[packed.length / 35];
+        Arrays.fill(lengths, 35);
+        lengths[lengths.length - 1] += packed.length - 35 * lengths.length;
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            OpenZLCompressor.setPinningThreshold(Long.MAX_VALUE);
+            byte[] pinned = compressor.compressStrings(packed, lengths);
+
+            OpenZLCompressor.setPinningThreshold(0);
+            long before = OpenZLCompressor.criticalRegionStats().count();
+            assertArrayEquals(pinned, compressor.compressStrings(packed, lengths));
+            OpenZLStrings restored = compressor.decompressStrings(pinned);
+            assertArrayEquals(packed, restored.content());
+            assertArrayEquals(lengths, restored.lengths());
+            assertEquals(before, OpenZLCompressor.criticalRegionStats().count());
+
+            int[] wrong = lengths.clone();
+            wrong[0] += 1;
+            assertThrows(IllegalArgumentException.class, () -> compressor.compressStrings(packed, wrong));
+        }
+    }
+
+    @Test
+    void rejectsNegativeThreshold() {
+        assertThrows(IllegalArgumentException.class, () -> OpenZLCompressor.setPinningThreshold(-1));
+    }
+}
@@ -0,0 +1,79 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import com.google.protobuf.DescriptorProtos;
+import com.google.protobuf.Descriptors;
+import com.google.protobuf.DynamicMessage;
+import org.junit.jupiter.api.Test;
+
+class TestProtobufAutoTraining {
+
+    // A schema of its own keeps the training state independent of the other protobuf tests.
+    private static Descriptors.Descriptor descriptor() throws Exception {
+        DescriptorProtos.DescriptorProto message = DescriptorProtos.DescriptorProto.newBuilder()
+                .setName("AutoTrainSample")
+                .addField(DescriptorProtos.FieldDescriptorProto.newBuilder()
+                        .setName("id")
+                        .setNumber(1)
+                        .setType(DescriptorProtos.FieldDescriptorProto.Type.TYPE_INT64)
+                        .setLabel(DescriptorProtos.FieldDescriptorProto.Label.LABEL_OPTIONAL))
+                .addField(DescriptorProtos.FieldDescriptorProto.newBuilder()
+                        .setName("values")
+                        .setNumber(2)
+                        .setType(DescriptorProtos.FieldDescriptorProto.Type.TYPE_INT32)
+                        .setLabel(DescriptorProtos.FieldDescriptorProto.Label.LABEL_REPEATED))
+                .build();
+        DescriptorProtos.FileDescriptorProto file = DescriptorProtos.FileDescriptorProto.newBuilder()
+                .setName("auto_train_sample.proto")
+                .setPackage("io.github.hybledav.autotrain")
+                .addMessageType(message)
+                .build();
+        return Descriptors.FileDescriptor.buildFrom(file, new Descriptors.FileDescriptor[0])
+                .findMessageTypeByName("AutoTrainSample");
+    }
+
+    private static byte[] sample(Descriptors.Descriptor type, int seed) {
+        DynamicMessage.Builder builder = DynamicMessage.newBuilder(type)
+                .setField(type.findFieldByName("id"), 1_000L + seed);
+        Descriptors.FieldDescriptor values = type.findFieldByName("values");
+        for (int i = 0; i < 600; ++i) {
+            builder.addRepeatedField(values, 100_000 + (i % 37) * seed);
+        }
+        return builder.build().toByteArray();
+    }
+
+    @Test
+    void thresholdCrossingConvertDoesNotWaitForTraining() throws Exception {
+        Descriptors.Descriptor type = descriptor();
+        OpenZLProtobuf.registerSchema(type);
+        OpenZLProtobuf.configureTraining(type, 3);
+        long completedBefore = OpenZLProtobuf.autoTrainingStatus().completed();
+
+        for (int seed = 1; seed <= 6; ++seed) {
+            byte[] proto = sample(type, seed);
+            byte[] zl = OpenZLProtobuf.convert(proto, OpenZLProtobuf.Protocol.PROTO, OpenZLProtobuf.Protocol.ZL, type);
+            assertRoundTrip(type, proto, zl);
+        }
+
+        long deadline = System.nanoTime() + 120_000_000_000L;
+        OpenZLProtobuf.AutoTrainingStatus status = OpenZLProtobuf.autoTrainingStatus();
+        while (status.completed() == completedBefore && System.nanoTime() < deadline) {
+            assertTrue(status.queueDepth() >= 0);
+            Thread.sleep(50);
+            status = OpenZLProtobuf.autoTrainingStatus();
+        }
+        assertTrue(status.completed() > completedBefore, "auto-training never finished");
+        assertTrue(status.lastDurationNanos() > 0);
+
+        // Converts after publication use the trained compressor and still round-trip.
+        byte[] proto = sample(type, 9);
+        byte[] zl = OpenZLProtobuf.convert(proto, OpenZLProtobuf.Protocol.PROTO, OpenZLProtobuf.Protocol.ZL, type);
+        assertRoundTrip(type, proto, zl);
+    }
+
+    private static void assertRoundTrip(Descriptors.Descriptor type, byte[] proto, byte[] zl) throws Exception {
+        byte[] decoded = OpenZLProtobuf.convert(zl, OpenZLProtobuf.Protocol.ZL, OpenZLProtobuf.Protocol.PROTO, type);
+        assertEquals(DynamicMessage.parseFrom(type, proto), DynamicMessage.parseFrom(type, decoded));
+    }
+}
@@ -0,0 +1,141 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Random;
+import org.junit.jupiter.api.Test;
+import org.junit.jupiter.api.io.TempDir;
+
+class TestRangeDecompression {
+
+    private static final int CHUNK = 64 * 1024;
+
+    @TempDir
+    Path dir;
+
+    private static byte[] sample(int size) {
+        byte[] data = new byte[size];
+        Random random = new Random(7);
+        for (int i = 0; i < size; ++i) {
+            data[i] = (byte) ((i / 13) ^ random.nextInt(3));
+        }
+        return data;
+    }
+
+    private static ByteBuffer container(OpenZLCompressor compressor, byte[] content) {
+        ByteBuffer src = ByteBuffer.allocateDirect(content.length);
+        src.put(content).flip();
+        ByteBuffer dst = ByteBuffer.allocateDirect((int) OpenZLCompressor.maxParallelCompressedSize(content.length, CHUNK));
+        compressor.compressParallel(src, dst, CHUNK, 2);
+        dst.flip();
+        return dst;
+    }
+
+    private static void assertRange(byte[] content, int offset, ByteBuffer decoded, int length) {
+        for (int i = 0; i < length; ++i) {
+            assertEquals(content[offset + i], decoded.get(i), "byte " + (offset + i));
+        }
+    }
+
+    @Test
+    void rangesWithinAndAcrossChunksMatchContent() {
+        byte[] content = sample(CHUNK * 5 + 1234);
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            ByteBuffer src = container(compressor, content);
+            int[][] ranges = {
+                    {0, 10},
+                    {CHUNK - 5, 10},
+                    {CHUNK, CHUNK},
+                    {CHUNK / 2, CHUNK * 3},
+                    {CHUNK * 5, 1234},
+                    {0, content.length},
+            };
+            for (int[] range : ranges) {
+                ByteBuffer dst = ByteBuffer.allocateDirect(range[1]);
+                assertEquals(range[1], compressor.decompressRange(src, range[0], range[1], dst, 2));
+                assertEquals(range[1], dst.position());
+                assertRange(content, range[0], dst, range[1]);
+            }
+            assertEquals(0, src.position());
+        }
+    }
+
+    @Test
+    void rangePastTheEndIsClipped() {
+        byte[] content = sample(CHUNK * 2 + 100);
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            ByteBuffer src = container(compressor, content);
+            ByteBuffer dst = ByteBuffer.allocateDirect(1000);
+            assertEquals(300, compressor.decompressRange(src, content.length - 300, 1000, dst));
+            assertRange(content, content.length - 300, dst, 300);
+
+            ByteBuffer empty = ByteBuffer.allocateDirect(16);
+            assertEquals(0, compressor.decompressRange(src, content.length, 16, empty));
+            assertThrows(IllegalArgumentException.class,
+                    () -> compressor.decompressRange(src, content.length + 1, 1, empty));
+        }
+    }
+
+    @Test
+    void chunkIndexIsCachedAndRevalidated() {
+        byte[] first = sample(CHUNK * 3);
+        // Same content size and chunk count, so only the chunk table tells the containers apart.
+        byte[] second = new byte[first.length];
+        for (int i = 0; i < second.length; ++i) {
+            second[i] = (byte) (first[i] + 1);
+        }
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            ByteBuffer src = container(compressor, first);
+            ByteBuffer dst = ByteBuffer.allocateDirect(64);
+            compressor.decompressRange(src, CHUNK, 64, dst);
+            assertTrue(OpenZLCompressor.cachedContainerIndexCount() > 0);
+
+            // Rewriting the same buffer with another container must not reuse the old index.
+            ByteBuffer replacement = container(compressor, second);
+            src.clear();
+            src.put(replacement).flip();
+            dst.clear();
+            compressor.decompressRange(src, CHUNK, 64, dst);
+            assertRange(second, CHUNK, dst, 64);
+        }
+    }
+
+    @Test
+    void rangesAreServedFromContainerFiles() throws IOException {
+        byte[] content = sample(CHUNK * 4 + 77);
+        Path in = Files.write(dir.resolve("content.bin"), content);
+        Path packed = dir.resolve("content.ozlp");
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            compressor.compressFile(in, packed, 0, CHUNK, 2);
+            ByteBuffer dst = ByteBuffer.allocateDirect(CHUNK * 2);
+            assertEquals(CHUNK * 2, compressor.decompressRange(packed, CHUNK / 2, CHUNK * 2, dst, 2));
+            assertRange(content, CHUNK / 2, dst, CHUNK * 2);
+
+            ByteBuffer tail = ByteBuffer.allocateDirect(100);
+            assertEquals(77, compressor.decompressRange(packed, CHUNK * 4L, 100, tail));
+            assertRange(content, CHUNK * 4, tail, 77);
+
+            assertThrows(IllegalArgumentException.class, () -> compressor.decompressRange(in, 0, 4, tail));
+            assertThrows(IOException.class,
+                    () -> compressor.decompressRange(dir.resolve("missing.ozlp"), 0, 4, tail));
+        }
+    }
+
+    @Test
+    void invalidArgumentsAreRejected() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            ByteBuffer src = container(compressor, sample(CHUNK));
+            ByteBuffer dst = ByteBuffer.allocateDirect(8);
+            assertThrows(IllegalArgumentException.class, () -> compressor.decompressRange(src, -1, 4, dst));
+            assertThrows(IllegalArgumentException.class, () -> compressor.decompressRange(src, 0, 64, dst));
+            assertThrows(IllegalArgumentException.class,
+                    () -> compressor.decompressRange(ByteBuffer.allocate(8), 0, 4, dst));
+            ByteBuffer notContainer = ByteBuffer.allocateDirect(64);
+            assertThrows(IllegalArgumentException.class, () -> compressor.decompressRange(notContainer, 0, 4, dst));
+        }
+    }
+}
@@ -0,0 +1,73 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.util.Arrays;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.Test;
+
+class TestScratchPolicy {
+
+    private static final long MIB = 1L << 20;
+
+    @AfterEach
+    void restoreDefaults() {
+        OpenZLCompressor.setScratchLimits(64 * MIB, 256 * MIB, MIB);
+    }
+
+    private static byte[] largePayload() {
+        byte[] input = new byte[24 << 20];
+        Arrays.fill(input, (byte) 'z');
+        return input;
+    }
+
+    @Test
+    void oversizedScratchIsReleasedOnReset() {
+        OpenZLCompressor.setScratchLimits(4 * MIB, 256 * MIB, MIB);
+        long baseline = OpenZLCompressor.retainedScratchBytes();
+        byte[] input = largePayload();
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            assertArrayEquals(input, compressor.decompress(compressor.compress(input)));
+            assertTrue(OpenZLCompressor.retainedScratchBytes() >= baseline + input.length);
+
+            compressor.reset();
+            assertTrue(OpenZLCompressor.retainedScratchBytes() < baseline + 4 * MIB);
+        }
+    }
+
+    @Test
+    void closedCompressorDoesNotPinLargeScratch() {
+        OpenZLCompressor.setScratchLimits(4 * MIB, 256 * MIB, MIB);
+        long baseline = OpenZLCompressor.retainedScratchBytes();
+        byte[] input = largePayload();
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            assertArrayEquals(input, compressor.decompress(compressor.compress(input)));
+        }
+        assertTrue(OpenZLCompressor.retainedScratchBytes() < baseline + 8 * MIB);
+    }
+
+    @Test
+    void idleCapacityDecaysWithoutReset() {
+        long baseline = OpenZLCompressor.retainedScratchBytes();
+        byte[] input = new byte[8 << 20];
+        Arrays.fill(input, (byte) 'q');
+        byte[] small = Arrays.copyOf(input, 4096);
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            assertNotNull(compressor.compress(input));
+            long peak = OpenZLCompressor.retainedScratchBytes();
+            assertTrue(peak >= baseline + input.length);
+
+            for (int i = 0; i < 1024; ++i) {
+                assertNotNull(compressor.compress(small));
+            }
+            assertTrue(OpenZLCompressor.retainedScratchBytes() < peak - input.length / 2);
+        }
+    }
+
+    @Test
+    void rejectsNegativeLimits() {
+        assertThrows(IllegalArgumentException.class, () -> OpenZLCompressor.setScratchLimits(-1, 0, 0));
+        assertThrows(IllegalArgumentException.class, () -> OpenZLCompressor.setScratchLimits(0, -1, 0));
+        assertThrows(IllegalArgumentException.class, () -> OpenZLCompressor.setScratchLimits(0, 0, -1));
+    }
+}
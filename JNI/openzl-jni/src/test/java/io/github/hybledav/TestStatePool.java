@@ -0,0 +1,80 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import org.junit.jupiter.api.AfterEach;
+import org.junit.jupiter.api.Test;
+
+class TestStatePool {
+
+    @AfterEach
+    void restoreCapacity() {
+        OpenZLCompressor.setStatePoolCapacity(64);
+    }
+
+    @Test
+    void closedCompressorsArePooledUpToCapacity() {
+        OpenZLCompressor.setStatePoolCapacity(16);
+        List<OpenZLCompressor> open = new ArrayList<>();
+        for (int i = 0; i < 40; ++i) {
+            open.add(new OpenZLCompressor(i % 2 == 0 ? OpenZLGraph.ZSTD : OpenZLGraph.GENERIC));
+        }
+        open.forEach(OpenZLCompressor::close);
+        assertTrue(OpenZLCompressor.pooledStateCount() <= 16);
+        assertTrue(OpenZLCompressor.pooledStateCount() > 0);
+
+        OpenZLCompressor.setStatePoolCapacity(4);
+        assertTrue(OpenZLCompressor.pooledStateCount() <= 4);
+    }
+
+    @Test
+    void reusedStatesUseTheRequestedGraph() {
+        byte[] input = "pooled graph payload ".repeat(64).getBytes(StandardCharsets.UTF_8);
+        try (OpenZLCompressor store = new OpenZLCompressor(OpenZLGraph.STORE)) {
+            store.compress(input);
+        }
+        try (OpenZLCompressor zstd = new OpenZLCompressor(OpenZLGraph.ZSTD)) {
+            byte[] compressed = zstd.compress(input);
+            assertTrue(compressed.length < input.length);
+            assertArrayEquals(input, zstd.decompress(compressed));
+        }
+    }
+
+    @Test
+    void concurrentAcquireAndRecycle() throws Exception {
+        byte[] input = "contended pool payload ".repeat(32).getBytes(StandardCharsets.UTF_8);
+        OpenZLGraph[] graphs = {OpenZLGraph.ZSTD, OpenZLGraph.GENERIC, OpenZLGraph.ENTROPY};
+        ExecutorService executor = Executors.newFixedThreadPool(16);
+        try {
+            List<Future<?>> futures = new ArrayList<>();
+            for (int t = 0; t < 16; ++t) {
+                OpenZLGraph graph = graphs[t % graphs.length];
+                futures.add(executor.submit(() -> {
+                    for (int i = 0; i < 200; ++i) {
+                        try (OpenZLCompressor compressor = new OpenZLCompressor(graph)) {
+                            assertArrayEquals(input, compressor.decompress(compressor.compress(input)));
+                        }
+                    }
+                }));
+            }
+            for (Future<?> future : futures) {
+                future.get();
+            }
+        } finally {
+            executor.shutdownNow();
+        }
+        assertTrue(OpenZLCompressor.pooledStateCount() <= 64);
+    }
+
+    @Test
+    void rejectsInvalidCapacity() {
+        assertThrows(IllegalArgumentException.class, () -> OpenZLCompressor.setStatePoolCapacity(-1));
+        assertThrows(IllegalArgumentException.class, () -> OpenZLCompressor.setStatePoolCapacity(1025));
+    }
+}
@@ -0,0 +1,80 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.io.ByteArrayOutputStream;
+import java.nio.charset.StandardCharsets;
+import org.junit.jupiter.api.Test;
+
+class TestStringCompression {
+
+    private static byte[][] urls(int count) {
+        byte[][] strings = new byte[count][];
+        for (int i = 0; i < count; ++i) {
+            String url = "https://example.com/api/v" + (i % 3) + "/items/" + (i * 7919 % 100_000)
+                    + (i % 5 == 0 ? "?expand=true" : "");
+            strings[i] = url.getBytes(StandardCharsets.UTF_8);
+        }
+        strings[count / 2] = new byte[0];
+        return strings;
+    }
+
+    @Test
+    void arrayOfStringsRoundTrips() {
+        byte[][] strings = urls(5_000);
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            byte[] compressed = compressor.compressStrings(strings);
+            assertEquals(OpenZLCompressionInfo.DataFlavor.STRING, compressor.inspect(compressed).flavor());
+
+            OpenZLStrings restored = compressor.decompressStrings(compressed);
+            assertEquals(strings.length, restored.count());
+            for (int i = 0; i < strings.length; ++i) {
+                assertArrayEquals(strings[i], restored.get(i));
+            }
+            assertEquals(0, restored.lengths()[strings.length / 2]);
+        }
+    }
+
+    @Test
+    void packedInputMatchesArrayInput() {
+        byte[][] strings = urls(1_000);
+        ByteArrayOutputStream packed = new ByteArrayOutputStream();
+        int[] lengths = new int[strings.length];
+        for (int i = 0; i < strings.length; ++i) {
+            packed.writeBytes(strings[i]);
+            lengths[i] = strings[i].length;
+        }
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            byte[] fromPacked = compressor.compressStrings(packed.toByteArray(), lengths);
+            assertArrayEquals(compressor.compressStrings(strings), fromPacked);
+
+            OpenZLStrings restored = compressor.decompressStrings(fromPacked);
+            assertArrayEquals(packed.toByteArray(), restored.content());
+            assertArrayEquals(lengths, restored.lengths());
+            assertEquals(lengths[0] + lengths[1], restored.offset(2));
+        }
+    }
+
+    @Test
+    void emptyArrayRoundTrips() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            OpenZLStrings restored = compressor.decompressStrings(compressor.compressStrings(new byte[0][]));
+            assertEquals(0, restored.count());
+            assertEquals(0, restored.toArray().length);
+        }
+    }
+
+    @Test
+    void rejectsInconsistentInput() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            assertThrows(IllegalArgumentException.class,
+                    () -> compressor.compressStrings(new byte[10], new int[] {4, 5}));
+            assertThrows(IllegalArgumentException.class,
+                    () -> compressor.compressStrings(new byte[10], new int[] {12, -2}));
+            assertThrows(NullPointerException.class,
+                    () -> compressor.compressStrings(new byte[][] {new byte[1], null}));
+            byte[] serial = compressor.compress("not strings".getBytes(StandardCharsets.UTF_8));
+            assertThrows(IllegalStateException.class, () -> compressor.decompressStrings(serial));
+        }
+    }
+}
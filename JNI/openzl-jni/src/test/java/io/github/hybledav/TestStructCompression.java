@@ -0,0 +1,93 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import org.junit.jupiter.api.Test;
+
+class TestStructCompression {
+
+    private static final int TICK_WIDTH = 24;
+
+    /** Trade ticks: u64 timestamp, f64 price, u32 quantity, u32 venue. */
+    private static ByteBuffer ticks(int count) {
+        ByteBuffer buffer = ByteBuffer.allocateDirect(count * TICK_WIDTH).order(ByteOrder.LITTLE_ENDIAN);
+        long timestamp = 1_700_000_000_000L;
+        for (int i = 0; i < count; ++i) {
+            timestamp += 1 + (i % 7);
+            buffer.putLong(timestamp);
+            buffer.putDouble(100.0d + (i % 113) * 0.01d);
+            buffer.putInt(100 * (1 + i % 5));
+            buffer.putInt(i % 3);
+        }
+        return buffer.flip();
+    }
+
+    private static byte[] bytes(ByteBuffer buffer) {
+        byte[] out = new byte[buffer.remaining()];
+        buffer.duplicate().get(out);
+        return out;
+    }
+
+    @Test
+    void recordsRoundTripAndReportTheirWidth() {
+        ByteBuffer src = ticks(10_000);
+        byte[] expected = bytes(src);
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            byte[] compressed = compressor.compressStructs(src, TICK_WIDTH);
+            assertFalse(src.hasRemaining());
+
+            OpenZLCompressionInfo info = compressor.inspect(compressed);
+            assertEquals(OpenZLCompressionInfo.DataFlavor.STRUCT, info.flavor());
+            assertEquals(TICK_WIDTH, info.elementWidth().orElseThrow());
+            assertEquals(10_000L, info.elementCount().orElseThrow());
+
+            assertArrayEquals(expected, compressor.decompressStructs(compressed));
+        }
+    }
+
+    @Test
+    void directVariantsRoundTrip() {
+        ByteBuffer src = ticks(2_048);
+        byte[] expected = bytes(src);
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            ByteBuffer frame = ByteBuffer.allocateDirect((int) OpenZLCompressor.maxCompressedSize(expected.length));
+            int written = compressor.compressStructs(src, TICK_WIDTH, frame);
+            assertEquals(written, frame.position());
+            frame.flip();
+
+            ByteBuffer restored = ByteBuffer.allocateDirect(expected.length);
+            assertEquals(expected.length, compressor.decompressStructs(frame, restored));
+            restored.flip();
+            assertArrayEquals(expected, bytes(restored));
+
+            frame.rewind();
+            assertThrows(OpenZLBufferTooSmallException.class,
+                    () -> compressor.decompressStructs(frame, ByteBuffer.allocateDirect(TICK_WIDTH)));
+        }
+    }
+
+    @Test
+    void numericFramesReportTheirWidthToo() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor(OpenZLGraph.NUMERIC)) {
+            byte[] compressed = compressor.compressLongs(new long[] {1, 2, 3, 4, 5, 6, 7, 8});
+            assertEquals(Long.BYTES, compressor.inspect(compressed).elementWidth().orElseThrow());
+            assertTrue(compressor.inspect(compressor.compress(new byte[64])).elementWidth().isEmpty());
+        }
+    }
+
+    @Test
+    void rejectsInvalidRecordLayouts() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            assertThrows(IllegalArgumentException.class,
+                    () -> compressor.compressStructs(ByteBuffer.allocateDirect(50), TICK_WIDTH));
+            assertThrows(IllegalArgumentException.class,
+                    () -> compressor.compressStructs(ByteBuffer.allocateDirect(48), 0));
+            assertThrows(IllegalArgumentException.class,
+                    () -> compressor.compressStructs(ByteBuffer.allocate(48), TICK_WIDTH));
+            byte[] serial = compressor.compress(new byte[96]);
+            assertThrows(IllegalStateException.class, () -> compressor.decompressStructs(serial));
+        }
+    }
+}
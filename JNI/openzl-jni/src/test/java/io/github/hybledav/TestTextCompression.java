@@ -0,0 +1,68 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.nio.charset.StandardCharsets;
+import java.util.Random;
+import org.junit.jupiter.api.Test;
+
+class TestTextCompression {
+
+    private static String mixedText(int length, long seed) {
+        Random random = new Random(seed);
+        String[] pieces = {"plain ascii ", "café ", "日本語 ", "emoji 😀 ", "Ωmega ", "\u0000nul "};
+        StringBuilder builder = new StringBuilder();
+        while (builder.length() < length) {
+            builder.append(pieces[random.nextInt(pieces.length)]);
+        }
+        return builder.toString();
+    }
+
+    @Test
+    void charSequenceMatchesUtf8Bytes() {
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            for (String text : new String[] {"", "ascii only payload ".repeat(100), mixedText(10_000, 7)}) {
+                byte[] expected = compressor.compress(text.getBytes(StandardCharsets.UTF_8));
+                assertArrayEquals(expected, compressor.compress(text));
+                assertArrayEquals(expected, compressor.compress(new StringBuilder(text)));
+                assertEquals(text, compressor.decompressToString(compressor.compress(text)));
+            }
+        }
+    }
+
+    @Test
+    void unpairedSurrogatesEncodeLikeTheJdk() {
+        String text = "lone \uD800 high and \uDC00 low, pair 😀 end";
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            byte[] compressed = compressor.compress(text);
+            assertArrayEquals(text.getBytes(StandardCharsets.UTF_8), compressor.decompress(compressed));
+        }
+    }
+
+    @Test
+    void malformedUtf8DecodesLikeTheJdk() {
+        byte[] bytes = {'o', 'k', (byte) 0xC3, '(', (byte) 0xE2, (byte) 0x82, 'x', (byte) 0xF0, (byte) 0x9F, (byte) 0x98,
+                (byte) 0x80, (byte) 0xFF, (byte) 0xED, (byte) 0xA0, (byte) 0x80, 'z'};
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            assertEquals(new String(bytes, StandardCharsets.UTF_8), compressor.decompressToString(compressor.compress(bytes)));
+        }
+    }
+
+    @Test
+    void stringArraysMatchByteArrays() {
+        String[] strings = new String[500];
+        byte[][] encoded = new byte[strings.length][];
+        for (int i = 0; i < strings.length; ++i) {
+            strings[i] = i % 50 == 0 ? "" : mixedText(i % 40, i);
+            encoded[i] = strings[i].getBytes(StandardCharsets.UTF_8);
+        }
+        try (OpenZLCompressor compressor = new OpenZLCompressor()) {
+            byte[] compressed = compressor.compressStrings(strings);
+            assertArrayEquals(compressor.compressStrings(encoded), compressed);
+            OpenZLStrings restored = compressor.decompressStrings(compressed);
+            for (int i = 0; i < strings.length; ++i) {
+                assertEquals(strings[i], restored.getString(i));
+            }
+        }
+    }
+}
@@ -0,0 +1,97 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import org.junit.jupiter.api.Test;
+
+class TestTrainedCompressor {
+
+    private static byte[][] csvSamples(int n) {
+        byte[][] inputs = new byte[n][];
+        for (int i = 0; i < n; ++i) {
+            inputs[i] = ("col1,col2,col3\nrow" + i + ",val" + i + ",x\n").getBytes(StandardCharsets.UTF_8);
+        }
+        return inputs;
+    }
+
+    private static byte[] trained(byte[][] inputs) {
+        TrainOptions opts = new TrainOptions();
+        opts.maxTimeSecs = 1;
+        byte[][] trained = OpenZLCompressor.train("csv", inputs, opts);
+        assertTrue(trained.length > 0);
+        return trained[0];
+    }
+
+    @Test
+    void loadedCompressorRoundTripsAndMatchesPerCallPath() {
+        byte[][] inputs = csvSamples(12);
+        byte[] serialized = trained(inputs);
+        try (OpenZLTrainedCompressor trained = OpenZLCompressor.loadCompressor("csv", serialized);
+                OpenZLCompressor plain = new OpenZLCompressor()) {
+            for (byte[] input : inputs) {
+                byte[] compressed = trained.compress(input);
+                assertArrayEquals(input, trained.decompress(compressed));
+                assertArrayEquals(input, plain.decompress(compressed));
+                byte[] perCall = OpenZLCompressor.compressWithSerializedNative("csv", serialized, input);
+                assertArrayEquals(input, plain.decompress(perCall));
+            }
+            assertEquals(1, trained.pooledContexts());
+
+            ByteBuffer src = ByteBuffer.allocateDirect(inputs[3].length);
+            src.put(inputs[3]).flip();
+            ByteBuffer dst = ByteBuffer.allocateDirect((int) OpenZLCompressor.maxCompressedSize(inputs[3].length));
+            int written = trained.compress(src, dst);
+            byte[] compressed = new byte[written];
+            dst.flip();
+            dst.get(compressed);
+            assertArrayEquals(inputs[3], plain.decompress(compressed));
+        }
+    }
+
+    @Test
+    void sharedBetweenThreads() throws Exception {
+        byte[][] inputs = csvSamples(16);
+        ExecutorService pool = Executors.newFixedThreadPool(4);
+        try (OpenZLTrainedCompressor trained = OpenZLCompressor.loadCompressor("csv", trained(inputs))) {
+            List<Future<?>> futures = new ArrayList<>();
+            for (int t = 0; t < 8; ++t) {
+                futures.add(pool.submit(() -> {
+                    for (int round = 0; round < 50; ++round) {
+                        for (byte[] input : inputs) {
+                            assertArrayEquals(input, trained.decompress(trained.compress(input)));
+                        }
+                    }
+                    return null;
+                }));
+            }
+            for (Future<?> future : futures) {
+                future.get();
+            }
+            assertTrue(trained.pooledContexts() >= 1 && trained.pooledContexts() <= 4);
+        } finally {
+            pool.shutdownNow();
+        }
+    }
+
+    @Test
+    void closedAndInvalidCompressorsAreRejected() {
+        byte[][] inputs = csvSamples(12);
+        OpenZLTrainedCompressor trained = OpenZLCompressor.loadCompressor("csv", trained(inputs));
+        trained.compress(inputs[0]);
+        trained.close();
+        trained.close();
+        assertEquals(0, trained.pooledContexts());
+        assertThrows(IllegalStateException.class, () -> trained.compress(inputs[0]));
+
+        assertThrows(IllegalArgumentException.class,
+                () -> OpenZLCompressor.loadCompressor("csv", new byte[] {1, 2, 3}));
+        assertThrows(NullPointerException.class, () -> OpenZLCompressor.loadCompressor("csv", null));
+    }
+}
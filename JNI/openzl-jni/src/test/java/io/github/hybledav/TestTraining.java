@@ -3,6 +3,7 @@ package io.github.hybledav;
 import org.junit.jupiter.api.Test;
 import static org.junit.jupiter.api.Assertions.*;
 
+import java.nio.ByteBuffer;
 import java.nio.charset.StandardCharsets;
 
 public class TestTraining {
@@ -180,4 +181,46 @@ public class TestTraining {
         assertTrue(trainedCompressed.length <= untrainedCompressed.length,
                 () -> String.format("trained %d <= untrained %d", trainedCompressed.length, untrainedCompressed.length));
     }
+
+    @Test
+    public void trainFromDirectBuffersReadsRemainingBytes() {
+        byte[][] inputs = makeCsvSamples(8, "direct");
+        ByteBuffer[] samples = new ByteBuffer[inputs.length];
+        for (int i = 0; i < inputs.length; ++i) {
+            // Leading padding checks that only position..limit is used.
+            samples[i] = ByteBuffer.allocateDirect(inputs[i].length + 3);
+            samples[i].position(3);
+            samples[i].put(inputs[i]);
+            samples[i].position(3);
+        }
+        TrainOptions opts = new TrainOptions();
+        opts.maxTimeSecs = 1;
+        byte[][] trained = OpenZLCompressor.train("csv", samples, opts);
+        assertTrue(trained.length > 0);
+        for (ByteBuffer sample : samples) {
+            assertEquals(3, sample.position());
+        }
+        try (OpenZLCompressor plain = new OpenZLCompressor()) {
+            byte[] compressed = OpenZLCompressor.compressWithSerializedNative("csv", trained[0], inputs[2]);
+            assertArrayEquals(inputs[2], plain.decompress(compressed));
+        }
+    }
+
+    @Test
+    public void trainRejectsInvalidSamples() {
+        assertThrows(IllegalArgumentException.class,
+                () -> OpenZLCompressor.train("csv", new ByteBuffer[] {ByteBuffer.allocate(4)}, null));
+        assertThrows(NullPointerException.class,
+                () -> OpenZLCompressor.train("csv", new ByteBuffer[] {null}, null));
+        assertThrows(IllegalArgumentException.class,
+                () -> OpenZLCompressor.train("no-such-profile", makeSamples(2, "x"), null));
+    }
+
+    @Test
+    public void trainToleratesNullSamples() {
+        byte[][] inputs = makeSamples(4, "gamma");
+        inputs[1] = null;
+        byte[][] trained = OpenZLCompressor.train("serial", inputs, new TrainOptions());
+        assertTrue(trained.length > 0);
+    }
 }
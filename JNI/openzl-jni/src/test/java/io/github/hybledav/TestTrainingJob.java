@@ -0,0 +1,92 @@
+package io.github.hybledav;
+
+import static org.junit.jupiter.api.Assertions.*;
+import static org.junit.jupiter.api.Assumptions.assumeFalse;
+
+import java.nio.charset.StandardCharsets;
+import java.util.concurrent.CancellationException;
+import java.util.concurrent.TimeUnit;
+import org.junit.jupiter.api.Test;
+
+class TestTrainingJob {
+
+    private static byte[][] csvSamples(int n) {
+        byte[][] inputs = new byte[n][];
+        for (int i = 0; i < n; ++i) {
+            inputs[i] = ("col1,col2,col3\nrow" + i + ",val" + i + ",x\n").getBytes(StandardCharsets.UTF_8);
+        }
+        return inputs;
+    }
+
+    @Test
+    void completesWithCandidatesAndProgress() throws Exception {
+        byte[][] inputs = csvSamples(12);
+        TrainOptions opts = new TrainOptions();
+        opts.maxTimeSecs = 1;
+        OpenZLTrainingJob job = OpenZLCompressor.trainAsync("csv", inputs, opts);
+        byte[][] trained = job.result().get(60, TimeUnit.SECONDS);
+
+        assertTrue(job.isDone());
+        assertTrue(trained.length > 0);
+        assertTrue(job.elapsed().toNanos() > 0);
+        assertTrue(job.bestRatio().isPresent());
+        assertTrue(job.bestRatio().getAsDouble() > 0);
+        assertTrue(job.candidatesEvaluated() > 0);
+
+        try (OpenZLCompressor plain = new OpenZLCompressor()) {
+            byte[] compressed = OpenZLCompressor.compressWithSerializedNative("csv", trained[0], inputs[4]);
+            assertArrayEquals(inputs[4], plain.decompress(compressed));
+        }
+    }
+
+    @Test
+    void cancelCompletesTheResultImmediately() throws Exception {
+        TrainOptions opts = new TrainOptions();
+        opts.maxTimeSecs = 1;
+        OpenZLTrainingJob job = OpenZLCompressor.trainAsync("csv", csvSamples(12), opts);
+        job.cancel();
+        assertTrue(job.isDone());
+        assertThrows(CancellationException.class, () -> job.result().get());
+        // Progress stays readable while the native run winds down.
+        assertNotNull(job.elapsed());
+    }
+
+    @Test
+    void cancelStopsTheNativeRun() throws Exception {
+        TrainOptions opts = new TrainOptions();
+        opts.maxTimeSecs = 120;
+        // One trainer thread, so that candidates are built on the job's own thread.
+        opts.threads = 1;
+        OpenZLTrainingJob job = OpenZLCompressor.trainAsync("csv", csvSamples(200), opts);
+        while (job.candidatesEvaluated() == 0 && !job.isDone()) {
+            Thread.sleep(5);
+        }
+        assumeFalse(job.isDone(), "training finished before it could be cancelled");
+        job.cancel();
+
+        // The job checks for cancellation at every candidate, well before the time budget.
+        job.stopped().get(60, TimeUnit.SECONDS);
+        assertEquals(OpenZLTrainingJob.CANCELLED, job.status());
+        assertTrue(job.elapsed().getSeconds() < opts.maxTimeSecs);
+    }
+
+    @Test
+    void jobsBeyondTheRunningLimitWaitTheirTurn() throws Exception {
+        TrainOptions opts = new TrainOptions();
+        opts.maxTimeSecs = 1;
+        OpenZLTrainingJob[] jobs = new OpenZLTrainingJob[5];
+        for (int i = 0; i < jobs.length; ++i) {
+            jobs[i] = OpenZLCompressor.trainAsync("csv", csvSamples(12), opts);
+        }
+        for (OpenZLTrainingJob job : jobs) {
+            assertTrue(job.result().get(120, TimeUnit.SECONDS).length > 0);
+        }
+    }
+
+    @Test
+    void invalidRequestsFailBeforeStarting() {
+        assertThrows(IllegalArgumentException.class,
+                () -> OpenZLCompressor.trainAsync("no-such-profile", csvSamples(2), null));
+        assertThrows(NullPointerException.class, () -> OpenZLCompressor.trainAsync("csv", null, null));
+    }
+}